@@ -0,0 +1,35 @@
+/**
+ * @file semihost.h
+ * @brief Minimal ARM semihosting (BKPT 0xAB) for firmware console output.
+ *
+ * Works under QEMU (-semihosting-config enable=on) or with a debug probe
+ * that services semihosting requests. Without either, the BKPT halts the
+ * core, so only the benchmark/test images use it.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define SEMIHOST_SYS_WRITE0   0x04
+#define SEMIHOST_SYS_EXIT     0x18
+#define SEMIHOST_APP_EXIT     0x20026     /**< ADP_Stopped_ApplicationExit */
+
+static inline int semihost_call(int op, const void *arg)
+{
+    register int r0 __asm__("r0") = op;
+    register const void *r1 __asm__("r1") = arg;
+    __asm__ volatile("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+/** Write a NUL-terminated string to the host console. */
+static inline void semihost_puts(const char *s)
+{
+    semihost_call(SEMIHOST_SYS_WRITE0, s);
+}
+
+/** Report application exit; QEMU terminates. */
+static inline void semihost_exit(void)
+{
+    semihost_call(SEMIHOST_SYS_EXIT, (const void *)SEMIHOST_APP_EXIT);
+}
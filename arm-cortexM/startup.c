@@ -1,13 +1,62 @@
+#include <stdint.h>
+
 extern int main();
 
+/* Coprocessor access control: CP10/CP11 full access enables the FPU */
+#define SCB_CPACR   (*(volatile unsigned int *)0xE000ED88)
+
+#if defined(__arm__)
+/* Section bounds from sections.ld: _s/_e run address, _l load address */
+extern uint32_t _estack;
+extern uint32_t _sdata, _edata, _ldata;
+extern uint32_t _sbss, _ebss;
+extern uint32_t _sfast_text, _efast_text, _lfast_text;
+extern uint32_t _sfast_data, _efast_data, _lfast_data;
+extern uint32_t _sfast_bss, _efast_bss;
+
+static void section_copy(uint32_t *dst, const uint32_t *end, const uint32_t *src)
+{
+    while (dst < end) *dst++ = *src++;
+}
+
+static void section_zero(uint32_t *dst, const uint32_t *end)
+{
+    while (dst < end) *dst++ = 0;
+}
+
+#define STACK_TOP   ((void (*)(void))&_estack)
+#else
+/* Host `make all` compiles this file too: no ARM memory map to load */
+#define STACK_TOP   ((void (*)(void))0)
+#endif
+
 void Reset_Handler(void)
 {
+#if defined(__ARM_FP)
+    /* Hard-float builds (Cortex-M4F/M7): any FP instruction before this
+       raises a UsageFault */
+    SCB_CPACR |= (0xFu << 20);
+    __asm__ volatile("dsb\n\tisb" ::: "memory");
+#endif
+
+#if defined(__arm__)
+    /* Load images out of flash, RAM-resident kernels first */
+    section_copy(&_sfast_text, &_efast_text, &_lfast_text);
+    section_copy(&_sfast_data, &_efast_data, &_lfast_data);
+    section_copy(&_sdata, &_edata, &_ldata);
+    section_zero(&_sfast_bss, &_efast_bss);
+    section_zero(&_sbss, &_ebss);
+
+    /* Instructions fetched after this point see the copied kernels */
+    __asm__ volatile("dsb\n\tisb" ::: "memory");
+#endif
+
     main();
     while (1);
 }
 
 __attribute__((section(".isr_vector")))
 void (*vector_table[])(void) = {
-    (void (*)(void))0x20010000,
+    STACK_TOP,
     Reset_Handler
-};
\ No newline at end of file
+};
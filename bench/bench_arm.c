@@ -0,0 +1,328 @@
+/**
+ * @file bench_arm.c
+ * @brief Bare-metal per-stage benchmark image for Cortex-M3/M4/M7.
+ *
+ * Firmware counterpart of bench_fe.c: one frame size (N = 256, hop 128,
+ * one channel), every pipeline stage plus the full fe_process_hop() in
+ * each precision, reported over semihosting. Stage kernels are the same
+ * sources the engine links, so an M4/M7 build (ARM_CPU=cortex-m4/m7)
+ * measures the DSP-extension paths and an M3 build the generic C.
+ *
+ * Time source, chosen at run time:
+ *   DWT_CYCCNT — core cycles, on hardware with a DWT cycle counter
+ *   SysTick    — where CYCCNT does not count (QEMU). The image calibrates
+ *                SysTick ticks against a spin loop of known instruction
+ *                count, so under `-icount shift=0` (one instruction per
+ *                virtual ns) the figures are retired instructions.
+ *
+ * Per stage: BENCH_WARMUP untimed calls, then BENCH_REPS timed calls;
+ * min and mean per call (= one hop) and mean per input sample.
+ *
+ * QEMU models no flash wait states, so the RAM_CODE / RAM_TABLES
+ * placement only shows up in cycle counts taken on hardware.
+ *
+ *   make qemu-bench ARM_CPU=cortex-m4
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "rtafe/fe_api.h"
+#include "module/window.h"
+#include "module/fft.h"
+#include "module/ifft.h"
+#include "biquad.h"
+#include "tables.h"
+#include "semihost.h"
+
+#ifndef RTAFE_ARM_CPU
+#define RTAFE_ARM_CPU "cortex-m"
+#endif
+
+#define BENCH_N        256
+#define BENCH_HOP      128
+#define BENCH_FS       16000
+#define BENCH_WARMUP   4
+#define BENCH_REPS     16
+#define BENCH_CAL_ITER (1u << 20)
+
+#define DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004)
+#define DWT_CONTROL  (*(volatile uint32_t *)0xE0001000)
+#define SCB_DEMCR    (*(volatile uint32_t *)0xE000EDFC)
+#define TRCENA       (1u << 24)
+
+#define SYST_CSR     (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR     (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR     (*(volatile uint32_t *)0xE000E018)
+#define SYST_MASK    0x00FFFFFFu
+
+static volatile int32_t bench_sink;
+
+/* ── Time source ────────────────────────────────────────────────────────── */
+
+static int use_dwt;
+static uint64_t cal_insns, cal_ticks;   /* SysTick: instructions per tick ratio */
+
+/** Spin @p n iterations of SUBS + BNE: exactly 2n instructions. */
+static void bench_spin(uint32_t n)
+{
+    __asm__ volatile("1: subs %0, %0, #1\n\t"
+                     "bne 1b" : "+r"(n) :: "cc");
+}
+
+/** Free-running up-counter; SysTick counts down from SYST_MASK. */
+static inline uint32_t counter_read(void)
+{
+    return use_dwt ? DWT_CYCCNT : (SYST_MASK - SYST_CVR);
+}
+
+static inline uint32_t counter_delta(uint32_t t0, uint32_t t1)
+{
+    return use_dwt ? t1 - t0 : (t1 - t0) & SYST_MASK;
+}
+
+/** Counter ticks → reported units (cycles, or instructions under QEMU). */
+static uint32_t counter_units(uint32_t ticks)
+{
+    if (use_dwt) return ticks;
+    return (uint32_t)(((uint64_t)ticks * cal_insns + cal_ticks / 2) / cal_ticks);
+}
+
+static void counter_init(void)
+{
+    SCB_DEMCR |= TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CONTROL |= 1;
+    bench_spin(1000);
+    use_dwt = DWT_CYCCNT != 0;
+
+    SYST_RVR = SYST_MASK;
+    SYST_CVR = 0;
+    SYST_CSR = 5;                       /* Processor clock, enabled, no IRQ */
+    if (!use_dwt) {
+        uint32_t t0 = counter_read();
+        bench_spin(BENCH_CAL_ITER);
+        cal_ticks = counter_delta(t0, counter_read());
+        cal_insns = 2ULL * BENCH_CAL_ITER;
+        if (cal_ticks == 0) cal_ticks = 1;
+    }
+}
+
+/* ── Console ────────────────────────────────────────────────────────────── */
+
+static char line[96];
+static size_t line_pos;
+
+static void put_str(const char *s)
+{
+    while (*s && line_pos + 1 < sizeof(line)) line[line_pos++] = *s++;
+}
+
+/** Right-aligned unsigned decimal in @p width columns, @p frac decimals. */
+static void put_u32(uint32_t v, int width, int frac)
+{
+    char buf[12];
+    int len = 0;
+    do {
+        buf[len++] = (char)('0' + v % 10);
+        v /= 10;
+        if (len == frac) buf[len++] = '.';
+    } while (v != 0 || len <= frac + (frac > 0));
+    for (int i = len; i < width; i++) put_str(" ");
+    while (len > 0 && line_pos + 1 < sizeof(line)) line[line_pos++] = buf[--len];
+}
+
+static void put_line(void)
+{
+    line[line_pos++] = '\n';
+    line[line_pos] = '\0';
+    semihost_puts(line);
+    line_pos = 0;
+}
+
+/* ── Stage kernels (one call = one hop) ─────────────────────────────────── */
+
+static q15_t pcm[BENCH_N];
+static q15_t frame[BENCH_N];
+static q31_t re[BENCH_N], im[BENCH_N];
+static q15_t spec[2 * BENCH_N];
+static DCRemoval dc;
+static PreEmphasis pre;
+static biquad_state bq;
+static const biquad_design *bq_design;
+static const fe_tables_t *tab;
+
+static void stage_dc(void)
+{
+    for (uint16_t n = 0; n < BENCH_HOP; n++) {
+        re[n] = dc_removal_process(&dc, ((q31_t)pcm[n]) << 16);
+    }
+    bench_sink += re[0];
+}
+
+static void stage_pre(void)
+{
+    for (uint16_t n = 0; n < BENCH_HOP; n++) {
+        frame[n] = pre_emphasis_process(&pre, pcm[n]);
+    }
+    bench_sink += frame[0];
+}
+
+static void stage_biquad(void)
+{
+    for (uint16_t n = 0; n < BENCH_HOP; n++) {
+        frame[n] = biquad_step_shared_fixed(bq_design, &bq, pcm[n]);
+    }
+    bench_sink += frame[1];
+}
+
+static void stage_window(void)
+{
+    window_apply_to(tab->hann, pcm, frame, BENCH_N);
+    bench_sink += frame[BENCH_N / 2];
+}
+
+static void stage_fft(void)
+{
+    for (uint16_t n = 0; n < BENCH_N; n++) {
+        re[n] = ((q31_t)pcm[n]) << 16;
+        im[n] = 0;
+    }
+    bench_sink += fft_radix2_q31(re, im, BENCH_N, tab->tw_cos, tab->tw_sin);
+}
+
+static void stage_fft_q15(void)
+{
+    for (uint16_t n = 0; n < BENCH_N; n++) {
+        spec[2 * n]     = pcm[n];
+        spec[2 * n + 1] = 0;
+    }
+    bench_sink += fft_radix2_q15(spec, BENCH_N, tab->tw_q15);
+}
+
+/* Round trip, so the inverse sees a real spectrum */
+static void stage_ifft_q15(void)
+{
+    stage_fft_q15();
+    bench_sink += ifft_radix2_q15(spec, BENCH_N, tab->tw_q15);
+}
+
+/* ── Full hop ───────────────────────────────────────────────────────────── */
+
+/* Engine arena in the fast data region (DTCM with linker_m7.ld) */
+static uint8_t state_buf[16 * 1024] RTAFE_FAST_BSS __attribute__((aligned(64)));
+static uint8_t scratch_buf[8 * 1024] RTAFE_FAST_BSS __attribute__((aligned(64)));
+static fe_state_t *hop_state;
+static q15_t hop_out[BENCH_HOP];
+
+static void stage_hop(void)
+{
+    fe_process_hop(hop_state, pcm, hop_out, NULL, 0);
+    bench_sink += hop_out[0];
+}
+
+static int hop_init(uint8_t precision)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate  = BENCH_FS;
+    cfg.frame_len    = BENCH_N;
+    cfg.hop_len      = BENCH_HOP;
+    cfg.num_channels = 1;
+    cfg.flags        = FE_FLAG_DC_REMOVAL | FE_FLAG_PRE_EMPHASIS | FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg.pre_emphasis_alpha = 0x7AE1;
+    cfg.precision    = precision;
+    cfg.window       = WINDOW_PAIR_HANN;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    if (fe_state_bytes(&cfg) > sizeof(state_buf) || scratch_sz > sizeof(scratch_buf)) return 0;
+    hop_state = (fe_state_t *)state_buf;
+    return fe_init(&cfg, hop_state, scratch_buf, scratch_sz) == FE_OK;
+}
+
+/* ── Harness ────────────────────────────────────────────────────────────── */
+
+static void bench_stage(const char *name, void (*fn)(void))
+{
+    uint32_t min = UINT32_MAX;
+    uint64_t sum = 0;
+
+    for (int i = 0; i < BENCH_WARMUP; i++) fn();
+    for (int r = 0; r < BENCH_REPS; r++) {
+        uint32_t t0 = counter_read();
+        fn();
+        uint32_t t = counter_units(counter_delta(t0, counter_read()));
+        if (t < min) min = t;
+        sum += t;
+    }
+    uint32_t mean = (uint32_t)(sum / BENCH_REPS);
+
+    put_str("  ");
+    put_str(name);
+    for (size_t i = strlen(name); i < 10; i++) put_str(" ");
+    put_u32(min, 12, 0);
+    put_u32(mean, 12, 0);
+    put_u32((uint32_t)((10ULL * sum / BENCH_REPS + BENCH_HOP / 2) / BENCH_HOP), 12, 1);
+    put_line();
+}
+
+int main(void)
+{
+    counter_init();
+
+    uint32_t lcg = 7;
+    for (size_t i = 0; i < BENCH_N; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        pcm[i] = (q15_t)(((int32_t)(lcg >> 16) - 32768) / 4);
+    }
+    tab = fe_tables_get(BENCH_N);
+    dc_removal_init(&dc, 0x7FD00000);
+    pre_emphasis_init(&pre, 0x7AE1);
+    bq_design = biquad_design_get(BIQUAD_HPF, 100.0f, 0.707f, (float)BENCH_FS);
+    memset(&bq, 0, sizeof(bq));
+
+    put_str("\n--- RTAFE firmware benchmark (" RTAFE_ARM_CPU ", N=");
+    put_u32(BENCH_N, 0, 0);
+    put_str(" hop=");
+    put_u32(BENCH_HOP, 0, 0);
+    put_str(") ---");
+    put_line();
+    put_str(use_dwt ? "  units: core cycles (DWT_CYCCNT)"
+                    : "  units: instructions (SysTick, calibrated; run QEMU with -icount shift=0)");
+    put_line();
+    put_str("  stage         min/call   mean/call mean/sample");
+    put_line();
+
+    if (tab == NULL) {
+        put_str("  no ROM tables for N=256 (build with TABLE_SIZES=256)");
+        put_line();
+        semihost_exit();
+        return 1;
+    }
+
+    bench_stage("dc", stage_dc);
+    bench_stage("preemph", stage_pre);
+    bench_stage("biquad", stage_biquad);
+    bench_stage("window", stage_window);
+    bench_stage("fft", stage_fft);
+    bench_stage("fft_q15", stage_fft_q15);
+    bench_stage("rt_q15", stage_ifft_q15);
+
+    static const struct { const char *name; uint8_t precision; } hops[] = {
+        { "hop",     FE_PRECISION_Q31 },
+        { "hop_q15", FE_PRECISION_Q15 },
+        { "hop_f32", FE_PRECISION_F32 },
+    };
+    for (size_t i = 0; i < sizeof(hops) / sizeof(hops[0]); i++) {
+        if (hop_init(hops[i].precision)) {
+            bench_stage(hops[i].name, stage_hop);
+        } else {
+            put_str("  ");
+            put_str(hops[i].name);
+            put_str(": fe_init failed");
+            put_line();
+        }
+    }
+
+    semihost_exit();
+    return 0;
+}
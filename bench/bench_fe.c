@@ -0,0 +1,486 @@
+/**
+ * @file bench_fe.c
+ * @brief Stage-level and full-hop benchmark harness for the hop engine.
+ *
+ * Times every pipeline stage (DC removal, pre-emphasis, window, FFT in
+ * Q1.31 and Q1.15, batched FFT across channels, spectral NS+VAD, Q1.31
+ * synthesis (iFFT + weighted overlap-add + hop out), input SRC) across
+ * frame sizes and channel counts, plus the full
+ * fe_process_hop() at every frame size and precision, and the low-latency
+ * mode against the float32 STFT path at equal frame size (same per-sample
+ * units, very different latency). The SNR side of the Q15 trade-off is
+ * measured by tests/test_fft_q15.c. The Q15 speed side comes from packed
+ * dual 16-bit MACs (SMUAD on ARM DSP cores, PMADDWD with SSE2): built with
+ * neither, fft_q15 and hop_q15 time the portable C fallback, which is
+ * slower than Q31, and the report says so.
+ *
+ * Per case: BENCH_WARMUP untimed calls, then `reps` timed repetitions of
+ * BENCH_INNER calls each. Reported per call (= one hop over all channels):
+ * median, p99, min, ns/sample (per channel sample) and real-time factor
+ * (call time / audio duration of one hop; < 1 means faster than real time).
+ *
+ *   make bench
+ *   ./bin/bench_fe [--csv out.csv] [--json out.json] [--reps N] [--fs Hz]
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "rtafe/fe_api.h"
+#include "module/window.h"
+#include "module/fft.h"
+#include "module/ifft.h"
+
+#define BENCH_WARMUP      50
+#define BENCH_INNER       16
+#define BENCH_MAX_RESULTS 256
+#define BENCH_MAX_CH      16
+
+/* Whether fft_q15 / hop_q15 time a packed 16-bit path or the C fallback */
+#if defined(__ARM_FEATURE_DSP) || defined(__SSE2__)
+#define BENCH_Q15_PACKED 1
+#else
+#define BENCH_Q15_PACKED 0
+#endif
+
+typedef struct {
+    const char *stage;
+    uint16_t frame_len;
+    uint8_t  channels;
+    double   median_ns;
+    double   p99_ns;
+    double   min_ns;
+    double   ns_per_sample;
+    double   rtf;
+} bench_result_t;
+
+typedef struct {
+    uint16_t n;
+    uint8_t  ch;
+    /* Per-channel stage state */
+    DCRemoval   dc[BENCH_MAX_CH];
+    PreEmphasis pre[BENCH_MAX_CH];
+    noise_suppress_state_t ns[BENCH_MAX_CH];
+    vad_state_t vad[BENCH_MAX_CH];
+    resample_state_t rs[BENCH_MAX_CH];
+    resample_bank_t bank;
+    /* Buffers */
+    q15_t *pcm;          /* [ch][3n] Q1.15 source */
+    q15_t *frame;        /* [ch][n] */
+    q31_t *re, *im;      /* [ch][n] */
+    q31_t *power;        /* [n_bins] */
+    q15_t *gain;         /* [n_bins] */
+    ns_bin_t *ns_bins;   /* [ch][n_bins] */
+    q31_t *ns_sub_min;   /* [ch][NS_SUBWIN_COUNT * n_bins] */
+    q15_t *rs_coeffs;
+    q15_t *rs_hist;      /* [ch][2 * taps] */
+    q15_t *window;       /* [n] */
+    q31_t *syn_win;      /* [n] Q1.31 synthesis window */
+    q31_t *ola;          /* [ch][n] overlap-add accumulators */
+    q31_t *tw_cos, *tw_sin;
+    uint32_t *tw_q15;    /* [n / 2] packed Q1.15 */
+} bench_ctx_t;
+
+static volatile int32_t bench_sink;
+static bench_result_t results[BENCH_MAX_RESULTS];
+static int n_results = 0;
+static int bench_reps = 201;
+static double bench_fs = 16000.0;
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* ── Stage kernels (one call = one hop over all channels) ──────────────── */
+
+static void stage_dc(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        const q15_t *x = &c->pcm[ch * 3 * c->n];
+        q31_t *y = &c->re[ch * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            y[n] = dc_removal_process(&c->dc[ch], ((q31_t)x[n]) << 16);
+        }
+    }
+    bench_sink += c->re[0];
+}
+
+static void stage_pre(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        const q15_t *x = &c->pcm[ch * 3 * c->n];
+        q15_t *y = &c->frame[ch * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            y[n] = pre_emphasis_process(&c->pre[ch], x[n]);
+        }
+    }
+    bench_sink += c->frame[0];
+}
+
+static void stage_window(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        window_apply(c->window, &c->frame[ch * c->n], c->n);
+    }
+    bench_sink += c->frame[c->n / 2];
+}
+
+static void stage_fft(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        q31_t *re = &c->re[ch * c->n];
+        q31_t *im = &c->im[ch * c->n];
+        const q15_t *x = &c->pcm[ch * 3 * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            re[n] = ((q31_t)x[n]) << 16;
+            im[n] = 0;
+        }
+        bench_sink += fft_radix2_q31(re, im, c->n, c->tw_cos, c->tw_sin);
+    }
+    bench_sink += c->re[1];
+}
+
+/* Same transforms in 16 bits: interleaved complex in the re buffer */
+static void stage_fft_q15(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        q15_t *x = (q15_t *)&c->re[ch * c->n];
+        const q15_t *src = &c->pcm[ch * 3 * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            x[2 * n]     = src[n];
+            x[2 * n + 1] = 0;
+        }
+        bench_sink += fft_radix2_q15(x, c->n, c->tw_q15);
+    }
+    bench_sink += c->re[1];
+}
+
+/* Same work as stage_fft, all channels as lanes of one batched transform */
+static void stage_fft_batch(bench_ctx_t *c)
+{
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        const q15_t *x = &c->pcm[ch * 3 * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            c->re[n * c->ch + ch] = ((q31_t)x[n]) << 16;
+            c->im[n * c->ch + ch] = 0;
+        }
+    }
+    bench_sink += fft_radix2_q31_batch(c->re, c->im, c->n, c->ch, c->tw_cos, c->tw_sin);
+    bench_sink += c->re[c->ch];
+}
+
+static void stage_ns(bench_ctx_t *c)
+{
+    size_t n_bins = c->n / 2 + 1;
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        noise_suppress_power(&c->re[ch * c->n], &c->im[ch * c->n], c->power, n_bins);
+        uint8_t speech = vad_process(&c->vad[ch], c->power, &c->ns[ch].bins[0].noise_est,
+                                     NS_BIN_STRIDE, n_bins);
+        noise_suppress_update(&c->ns[ch], c->power, n_bins, speech, 20);
+        noise_suppress_gain(&c->ns[ch], c->power, c->gain, n_bins, 512, 1);
+    }
+    bench_sink += c->gain[1];
+}
+
+/* Q1.31 synthesis as fe_hop_synth(): iFFT, 50 % weighted overlap-add, the
+   completed hop out to Q1.15 and the tail shifted down */
+static void stage_ifft_ola(bench_ctx_t *c)
+{
+    uint16_t hop = c->n / 2;
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        q31_t *re = &c->re[ch * c->n];
+        q31_t *im = &c->im[ch * c->n];
+        q31_t *ola = &c->ola[ch * c->n];
+        q15_t *y = &c->frame[ch * c->n];
+        const q15_t *x = &c->pcm[ch * 3 * c->n];
+        for (uint16_t n = 0; n < c->n; n++) {
+            re[n] = ((q31_t)x[n]) << 16;
+            im[n] = ((q31_t)x[c->n + n]) << 16;
+        }
+        bench_sink += ifft_radix2_q31(re, im, c->n, c->tw_cos, c->tw_sin);
+        overlap_add_q31(ola, re, c->syn_win, c->n);
+        for (uint16_t n = 0; n < hop; n++) y[n] = (q15_t)(ola[n] >> 16);
+        memmove(ola, ola + hop, (size_t)(c->n - hop) * sizeof(q31_t));
+        memset(ola + c->n - hop, 0, hop * sizeof(q31_t));
+    }
+    bench_sink += c->frame[1];
+}
+
+static void stage_src(bench_ctx_t *c)
+{
+    /* 48k → 16k: 3n input samples per channel produce n outputs */
+    for (uint8_t ch = 0; ch < c->ch; ch++) {
+        bench_sink += (int32_t)resample_process(&c->rs[ch], &c->pcm[ch * 3 * c->n], 3 * c->n, 1,
+                                                &c->frame[ch * c->n], 1);
+    }
+}
+
+/* ── Harness ────────────────────────────────────────────────────────────── */
+
+/* @p hop: new samples per channel per call (n for stage kernels) */
+static void bench_record(const char *stage, uint16_t n, uint16_t hop, uint8_t ch, double *samples)
+{
+    qsort(samples, bench_reps, sizeof(double), cmp_double);
+
+    bench_result_t r;
+    r.stage = stage;
+    r.frame_len = n;
+    r.channels = ch;
+    r.min_ns = samples[0];
+    r.median_ns = samples[bench_reps / 2];
+    r.p99_ns = samples[(bench_reps * 99) / 100];
+    r.ns_per_sample = r.median_ns / ((double)hop * ch);
+    r.rtf = r.median_ns / ((double)hop / bench_fs * 1e9);
+
+    printf("  %-10s N=%-5u ch=%-3u median=%10.0f ns  p99=%10.0f ns  %7.2f ns/sample  RTF=%.5f\n",
+           stage, n, ch, r.median_ns, r.p99_ns, r.ns_per_sample, r.rtf);
+
+    /* Printed either way; only the CSV / JSON reports are capped */
+    if (n_results >= BENCH_MAX_RESULTS) {
+        FE_ERROR("bench: more than %d results, %s N=%u ch=%u left out of the reports\n",
+                 BENCH_MAX_RESULTS, stage, n, ch);
+        return;
+    }
+    results[n_results++] = r;
+}
+
+static void bench_stage(const char *stage, void (*fn)(bench_ctx_t *), bench_ctx_t *c)
+{
+    double *samples = (double *)malloc(bench_reps * sizeof(double));
+
+    for (int i = 0; i < BENCH_WARMUP; i++) fn(c);
+
+    for (int r = 0; r < bench_reps; r++) {
+        uint64_t t0 = get_time_ns();
+        for (int i = 0; i < BENCH_INNER; i++) fn(c);
+        uint64_t t1 = get_time_ns();
+        samples[r] = (double)(t1 - t0) / BENCH_INNER;
+    }
+
+    bench_record(stage, c->n, c->n, c->ch, samples);
+    free(samples);
+}
+
+static void bench_ctx_init(bench_ctx_t *c, uint16_t n, uint8_t ch)
+{
+    size_t n_bins = n / 2 + 1;
+    memset(c, 0, sizeof(*c));
+    c->n = n;
+    c->ch = ch;
+
+    c->pcm       = (q15_t *)malloc(ch * 3 * n * sizeof(q15_t));
+    c->frame     = (q15_t *)malloc(ch * n * sizeof(q15_t));
+    c->re        = (q31_t *)malloc(ch * n * sizeof(q31_t));
+    c->im        = (q31_t *)malloc(ch * n * sizeof(q31_t));
+    c->power     = (q31_t *)malloc(n_bins * sizeof(q31_t));
+    c->gain      = (q15_t *)malloc(n_bins * sizeof(q15_t));
+    c->ns_bins   = (ns_bin_t *)malloc(ch * n_bins * sizeof(ns_bin_t));
+    c->ns_sub_min = (q31_t *)malloc(ch * NS_SUBWIN_COUNT * n_bins * sizeof(q31_t));
+    c->window    = (q15_t *)malloc(n * sizeof(q15_t));
+    c->syn_win   = (q31_t *)malloc(n * sizeof(q31_t));
+    c->ola       = (q31_t *)calloc((size_t)ch * n, sizeof(q31_t));
+    c->tw_cos    = (q31_t *)malloc(n / 2 * sizeof(q31_t));
+    c->tw_sin    = (q31_t *)malloc(n / 2 * sizeof(q31_t));
+    c->tw_q15    = (uint32_t *)malloc(n / 2 * sizeof(uint32_t));
+
+    uint32_t lcg = 1;
+    for (size_t i = 0; i < (size_t)ch * 3 * n; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        c->pcm[i] = (q15_t)((int32_t)(lcg >> 16) - 32768) / 4;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        c->window[i] = (q15_t)(32767.0 * 0.5 * (1.0 - cos(2.0 * M_PI * i / (n - 1))));
+        c->syn_win[i] = (q31_t)(2147483647.0 * 0.5 * (1.0 - cos(2.0 * M_PI * i / n)));
+    }
+    for (uint16_t i = 0; i < n / 2; i++) {
+        c->tw_cos[i] = (q31_t)(2147483647.0 * cos(2.0 * M_PI * i / n));
+        c->tw_sin[i] = (q31_t)(2147483647.0 * sin(2.0 * M_PI * i / n));
+        c->tw_q15[i] = (uint32_t)(uint16_t)(q15_t)(c->tw_cos[i] >> 16) |
+                       ((uint32_t)(uint16_t)(q15_t)(c->tw_sin[i] >> 16) << 16);
+    }
+
+    uint16_t taps;
+    resample_geometry(48000, 16000, NULL, NULL, &taps);
+    c->rs_coeffs = (q15_t *)malloc(taps * sizeof(q15_t));
+    c->rs_hist = (q15_t *)malloc(ch * 2 * taps * sizeof(q15_t));
+    resample_bank_init(&c->bank, 48000, 16000, c->rs_coeffs);
+
+    for (uint8_t i = 0; i < ch; i++) {
+        dc_removal_init(&c->dc[i], 0x7FD00000);
+        pre_emphasis_init(&c->pre[i], 0x7AE1);
+        noise_suppress_init(&c->ns[i], &c->ns_bins[i * n_bins],
+                            &c->ns_sub_min[i * NS_SUBWIN_COUNT * n_bins], n_bins);
+        vad_init(&c->vad[i], 0, VAD_DEFAULT_HANGOVER);
+        resample_init(&c->rs[i], &c->bank, &c->rs_hist[i * 2 * taps]);
+    }
+}
+
+static void bench_ctx_free(bench_ctx_t *c)
+{
+    free(c->pcm); free(c->frame); free(c->re); free(c->im);
+    free(c->power); free(c->gain); free(c->ns_bins); free(c->ns_sub_min);
+    free(c->window); free(c->syn_win); free(c->ola); free(c->tw_cos); free(c->tw_sin); free(c->tw_q15);
+    free(c->rs_coeffs); free(c->rs_hist);
+}
+
+static void bench_full_hop(const char *stage, uint16_t frame_len, uint16_t hop_len, uint8_t ch,
+                           uint8_t precision, uint8_t mode)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate  = (uint32_t)bench_fs;
+    cfg.frame_len    = frame_len;
+    cfg.hop_len      = hop_len;
+    cfg.num_channels = ch;
+    cfg.flags        = FE_FLAG_DC_REMOVAL | FE_FLAG_PRE_EMPHASIS | FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg.pre_emphasis_alpha = 0x7AE1;
+    cfg.precision    = precision;
+    cfg.mode         = mode;
+    cfg.window       = (mode == FE_MODE_LOW_LATENCY) ? WINDOW_PAIR_SQRT_HANN : WINDOW_PAIR_HANN;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    void *scratch = malloc(scratch_sz);
+    if (fe_init(&cfg, state, scratch, scratch_sz) != FE_OK) {
+        printf("  %-10s N=%u ch=%u: fe_init failed\n", stage, frame_len, ch);
+        free(state); free(scratch);
+        return;
+    }
+
+    size_t n = (size_t)cfg.hop_len * ch;
+    q15_t *in = (q15_t *)malloc(n * sizeof(q15_t));
+    q15_t *out = (q15_t *)malloc(n * sizeof(q15_t));
+    uint32_t lcg = 7;
+    for (size_t i = 0; i < n; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        in[i] = (q15_t)((int32_t)(lcg >> 16) - 32768) / 4;
+    }
+
+    double *samples = (double *)malloc(bench_reps * sizeof(double));
+    for (int i = 0; i < BENCH_WARMUP; i++) fe_process_hop(state, in, out, NULL, 0);
+    for (int r = 0; r < bench_reps; r++) {
+        uint64_t t0 = get_time_ns();
+        for (int i = 0; i < BENCH_INNER; i++) fe_process_hop(state, in, out, NULL, 0);
+        uint64_t t1 = get_time_ns();
+        samples[r] = (double)(t1 - t0) / BENCH_INNER;
+        bench_sink += out[r % n];
+    }
+    bench_record(stage, cfg.frame_len, cfg.hop_len, ch, samples);
+    if (mode == FE_MODE_LOW_LATENCY || !strcmp(stage, "stft_f32")) {
+        /* Algorithmic delay plus one hop of input and one of output buffering */
+        double lat = fe_latency(state) + 2.0 * cfg.hop_len;
+        printf("  %-10s latency %u + 2 x %u samples = %.2f ms\n", stage, fe_latency(state),
+               cfg.hop_len, lat * 1e3 / bench_fs);
+    }
+#ifdef RTAFE_PROFILE
+    fe_profile_dump(state, stdout);
+#endif
+
+    free(samples); free(in); free(out); free(state); free(scratch);
+}
+
+/* ── Report writers ─────────────────────────────────────────────────────── */
+
+static void write_csv(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) { FE_ERROR("Cannot open %s\n", path); return; }
+    fprintf(f, "stage,frame_len,channels,median_ns,p99_ns,min_ns,ns_per_sample,rtf\n");
+    for (int i = 0; i < n_results; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(f, "%s,%u,%u,%.1f,%.1f,%.1f,%.3f,%.6f\n", r->stage, r->frame_len, r->channels,
+                r->median_ns, r->p99_ns, r->min_ns, r->ns_per_sample, r->rtf);
+    }
+    fclose(f);
+}
+
+static void write_json(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) { FE_ERROR("Cannot open %s\n", path); return; }
+    fprintf(f, "{\n  \"fs\": %.0f,\n  \"reps\": %d,\n  \"q15_packed\": %s,\n  \"results\": [\n",
+            bench_fs, bench_reps, BENCH_Q15_PACKED ? "true" : "false");
+    for (int i = 0; i < n_results; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(f, "    {\"stage\": \"%s\", \"frame_len\": %u, \"channels\": %u, "
+                   "\"median_ns\": %.1f, \"p99_ns\": %.1f, \"min_ns\": %.1f, "
+                   "\"ns_per_sample\": %.3f, \"rtf\": %.6f}%s\n",
+                r->stage, r->frame_len, r->channels, r->median_ns, r->p99_ns, r->min_ns,
+                r->ns_per_sample, r->rtf, (i + 1 < n_results) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+    const char *csv_path = NULL, *json_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv") && i + 1 < argc) csv_path = argv[++i];
+        else if (!strcmp(argv[i], "--json") && i + 1 < argc) json_path = argv[++i];
+        else if (!strcmp(argv[i], "--reps") && i + 1 < argc) bench_reps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--fs") && i + 1 < argc) bench_fs = atof(argv[++i]);
+    }
+    if (bench_reps < 1) bench_reps = 1;
+
+    static const uint16_t frame_lens[] = {128, 256, 512, 1024};
+    static const uint8_t channels[] = {1, 2, 8, 16};
+
+    printf("\n--- RTAFE benchmark (fs=%.0f Hz, reps=%d x %d) ---\n", bench_fs, bench_reps, BENCH_INNER);
+    if (!BENCH_Q15_PACKED) {
+        printf("  note: neither ARM DSP nor SSE2 in this build; fft_q15 / hop_q15 run the\n"
+               "        portable C fallback, slower than Q31. Compare them against fft / hop\n"
+               "        on a target with packed 16-bit MACs.\n");
+    }
+
+    for (size_t fi = 0; fi < sizeof(frame_lens) / sizeof(frame_lens[0]); fi++) {
+        for (size_t ci = 0; ci < sizeof(channels) / sizeof(channels[0]); ci++) {
+            bench_ctx_t *c = (bench_ctx_t *)malloc(sizeof(bench_ctx_t));
+            bench_ctx_init(c, frame_lens[fi], channels[ci]);
+            bench_stage("dc", stage_dc, c);
+            bench_stage("preemph", stage_pre, c);
+            bench_stage("window", stage_window, c);
+            bench_stage("fft", stage_fft, c);
+            bench_stage("fft_q15", stage_fft_q15, c);
+            bench_stage("fft_batch", stage_fft_batch, c);
+            bench_stage("ns_vad", stage_ns, c);
+            bench_stage("ifft_ola", stage_ifft_ola, c);
+            bench_stage("src48_16", stage_src, c);
+            bench_ctx_free(c);
+            free(c);
+        }
+    }
+
+    /* Full hop: sizes outside TABLE_SIZES come from the runtime table cache */
+    for (size_t fi = 0; fi < sizeof(frame_lens) / sizeof(frame_lens[0]); fi++) {
+        for (size_t ci = 0; ci < sizeof(channels) / sizeof(channels[0]); ci++) {
+            uint16_t n = frame_lens[fi];
+            bench_full_hop("hop", n, n / 2, channels[ci], FE_PRECISION_Q31, FE_MODE_STFT);
+            bench_full_hop("hop_f32", n, n / 2, channels[ci], FE_PRECISION_F32, FE_MODE_STFT);
+            bench_full_hop("hop_q15", n, n / 2, channels[ci], FE_PRECISION_Q15, FE_MODE_STFT);
+        }
+    }
+
+    /* Low-latency blocks vs the STFT hop at the same frame size */
+    for (size_t ci = 0; ci < 2; ci++) {
+        bench_full_hop("stft_f32", 256, 128, channels[ci], FE_PRECISION_F32, FE_MODE_STFT);
+        bench_full_hop("ll16_f32", 256, 16, channels[ci], FE_PRECISION_F32, FE_MODE_LOW_LATENCY);
+        bench_full_hop("ll32_f32", 256, 32, channels[ci], FE_PRECISION_F32, FE_MODE_LOW_LATENCY);
+    }
+
+    if (csv_path) write_csv(csv_path);
+    if (json_path) write_json(json_path);
+    return 0;
+}
@@ -0,0 +1,300 @@
+/**
+ * @file fe_api.h
+ * @brief Public hop-based API of the real-time audio front-end engine.
+ *
+ * Usage:
+ *   1. Fill fe_config_t
+ *   2. Allocate fe_state_bytes(&cfg) / fe_scratch_bytes(&cfg) bytes
+ *   3. fe_init(&cfg, state, scratch, scratch_sz)
+ *   4. fe_process_hop() once per hop (interleaved Q1.15 PCM in/out)
+ *
+ * Each hop consumes hop_len new samples per channel, analyzes the last
+ * frame_len of them through the analysis window and resynthesizes hop_len
+ * output samples by weighted overlap-add, fe_latency() samples behind the
+ * input. The last frame_len samples live in a per-channel ring; the
+ * analysis window reads the frame straight out of it in (at most) two
+ * segments, so framing copies nothing.
+ *
+ * FE_MODE_LOW_LATENCY decouples output latency from the FFT size: each
+ * call is a short time-domain block (hop_len of e.g. 16-32 samples) that
+ * is filtered by a FE_LL_FIR_TAPS minimum-phase FIR, redesigned from the
+ * noise suppressor's gain vector every frame_len / 2 samples.
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+#include "rtafe/fe_profile.h"
+#include "module/dc_removal.h"
+#include "module/preemphasis.h"
+#include "module/noise_suppress.h"
+#include "module/vad.h"
+#include "module/resample.h"
+#include "module/window.h"
+
+#define FE_DC_DEFAULT_CUTOFF_HZ 20
+#define FE_CACHE_LINE           64    /**< Arena slice alignment */
+#define FE_LL_FIR_TAPS          32    /**< Low-latency NS filter length */
+#define FE_NS_MIN_TRACK_LEN     20    /**< NS minimum-statistics window, analysis hops (≈200 ms at 10 ms) */
+#define FE_NS_OVER_SUB_UNITY    512   /**< fe_params_t::ns_over_sub of 1.0x (Q6.9), the init value */
+#define FE_NS_FLOOR_DEFAULT     1     /**< fe_params_t::ns_floor init value, one Q1.31 power LSB */
+
+/** Arithmetic of the hop pipeline, fixed for the lifetime of an instance. */
+typedef enum {
+    FE_PRECISION_Q31 = 0,         /**< Fixed-point Q1.15/Q1.31 (default, integer-only cores) */
+    FE_PRECISION_F32 = 1,         /**< float32 (hosts, Cortex-M7/A-class FPUs) */
+    FE_PRECISION_Q15 = 2,         /**< As Q31, 16-bit block-floating-point FFT (half the FFT working set;
+                                       faster than Q31 with packed 16-bit MACs: ARM DSP, x86 SSE2) */
+} fe_precision_t;
+
+/** Synthesis structure, fixed for the lifetime of an instance. */
+typedef enum {
+    FE_MODE_STFT        = 0,     /**< Windowed FFT analysis + overlap-add synthesis (default) */
+    FE_MODE_LOW_LATENCY = 1,     /**< hop_len time-domain blocks, NS as a min-phase FIR (F32 only) */
+} fe_mode_t;
+
+typedef struct fe_config_t {
+    uint32_t sample_rate;         /**< Processing rate in Hz (e.g., 16000) */
+    uint32_t input_rate;          /**< Source rate in Hz, 0 = same as sample_rate */
+    uint16_t frame_len;           /**< Frame length (FFT size): TABLE_SIZES, or any power of 2 with the table cache */
+    uint16_t hop_len;             /**< Hop length in samples, divides frame_len */
+    uint8_t  num_channels;        /**< Number of interleaved input channels */
+    uint8_t  flags;               /**< FE_FLAG_* module enable bitfield */
+    q31_t    dc_rm_alpha;         /**< DC removal pole, Q1.31; 0 = design from dc_rm_cutoff_hz */
+    uint16_t dc_rm_cutoff_hz;     /**< DC removal corner (Hz) at sample_rate, 0 = FE_DC_DEFAULT_CUTOFF_HZ */
+    q15_t    pre_emphasis_alpha;  /**< Pre-emphasis coefficient, Q1.15 */
+    uint8_t  precision;           /**< fe_precision_t */
+    uint8_t  window;              /**< window_pair_t analysis/synthesis pair, checked for COLA at init */
+    uint8_t  mode;                /**< fe_mode_t */
+} fe_config_t;
+
+/**
+ * Hot per-channel state (fixed-point precisions). One record per channel
+ * sits at the head of that channel's arena block, immediately followed by
+ * its ns_bin_t[n_bins] array, so a channel's filter memories, VAD/NS
+ * bookkeeping and per-bin noise records occupy adjacent cache lines. The
+ * suppressor's sub-window minima rows, the analysis history and the
+ * overlap-add tail follow in the same block. Use fe_channel() to index.
+ */
+typedef struct {
+    DCRemoval              dc;
+    PreEmphasis            pre;
+    vad_state_t            vad;
+    noise_suppress_state_t ns;            /**< ns.bins → this block's bin array */
+    q15_t                 *hist;          /**< [frame_len] ring of conditioned samples, see hist_pos */
+    q31_t                 *ola;           /**< [ola_len] overlap-add accumulator */
+} fe_channel_t;
+
+/** FE_PRECISION_F32 counterpart of fe_channel_t (bins: ns_bin_f32_t). */
+typedef struct {
+    DCRemovalF32           dc;
+    PreEmphasisF32         pre;
+    vad_state_t            vad;
+    noise_suppress_f32_t   ns;
+    float                 *hist;
+    float                 *ola;           /**< NULL in FE_MODE_LOW_LATENCY */
+    float                 *fir;           /**< [FE_LL_FIR_TAPS] low-latency NS filter, else NULL */
+} fe_channel_f32_t;
+
+/**
+ * Parameters that can change while the engine runs (fe_params_set). A new
+ * set takes effect at the next hop boundary: DC and pre-emphasis
+ * coefficients, and the DC removal / pre-emphasis enables, ramp linearly
+ * across that hop; NS parameters and enables switch between analysis
+ * frames, which the overlap-add crossfades.
+ */
+typedef struct {
+    uint8_t  flags;               /**< Active FE_FLAG_* modules; NS / VAD only if configured at init */
+    q31_t    dc_rm_alpha;         /**< DC removal pole, Q1.31, 0..INT32_MAX */
+    q15_t    pre_emphasis_alpha;  /**< Pre-emphasis coefficient, Q1.15 */
+    q15_t    ns_over_sub;         /**< NS over-subtraction, Q6.9 (512 = 1.0x) */
+    q31_t    ns_floor;            /**< NS spectral floor, Q1.31 power LSBs: bins at or below it are muted */
+} fe_params_t;
+
+struct fe_tables;
+
+/** Per-hop working buffers, slices of one scratch block (fe_scratch_bytes). */
+typedef struct {
+    q15_t *frame_q15;                             /**< [frame_len] */
+    q31_t *fft_re;                                /**< [frame_len] */
+    q31_t *fft_im;                                /**< [frame_len], empty for FE_PRECISION_Q15 */
+    q15_t *fft_q15;                               /**< [2 * frame_len] interleaved re, im in the fft_re slice */
+    q31_t *power;                                 /**< [n_bins] */
+    q15_t *gain;                                  /**< [n_bins] Q6.9 */
+    /* FE_PRECISION_F32 views of the same slices */
+    float *frame_f32;
+    float *re_f32;
+    float *im_f32;
+    float *power_f32;
+    float *gain_f32;
+} fe_work_t;
+
+typedef struct fe_state_t {
+    uint32_t sample_rate;
+    uint16_t frame_len;
+    uint16_t hop_len;
+    uint8_t  num_channels;
+    uint8_t  flags;
+    uint8_t  vad_speech;                          /**< Any channel speech on last hop */
+    uint8_t  precision;                           /**< fe_precision_t */
+    uint8_t  window;                              /**< window_pair_t */
+    uint8_t  frame_log2;                          /**< log2(frame_len) */
+    uint8_t  mode;                                /**< fe_mode_t */
+    uint16_t ola_len;                             /**< Synthesis window support, multiple of hop_len */
+    uint16_t warmup;                              /**< Hops left until the history holds a full frame */
+    uint16_t hist_pos;                            /**< Ring slot for the next hop, multiple of hop_len */
+
+    fe_params_t             params;               /**< Active set (audio thread) */
+    fe_params_t             params_prev;          /**< Active set before the last change (ramp start) */
+    struct {                                      /**< Published set, seqlock (fe_params_set) */
+        fe_params_t         next;
+        uint32_t            seq;                  /**< Odd while a writer is updating `next` */
+        uint32_t            applied;              /**< seq of the active set (audio thread) */
+    } ctl;
+
+    const struct fe_tables *tab;                  /**< ROM tables for frame_len (fe_tables_get) */
+    uint8_t                *chan;                 /**< Per-channel blocks, see fe_channel() */
+    size_t                  chan_stride;          /**< Bytes between channel blocks */
+
+    uint32_t                input_rate;           /**< Source rate (== sample_rate if no SRC) */
+    resample_bank_t         resample_bank;        /**< Shared input SRC coefficients */
+    resample_state_t       *resample_block;       /**< [num_channels], NULL if no SRC */
+
+    size_t  state_sz;                             /**< Bytes of the state arena */
+    void   *scratch;
+    size_t  scratch_sz;
+
+    fe_work_t               work;                 /**< Scratch slices, carved at init */
+
+    struct {                                      /**< Designed pair (window_pair_design), Q1.31 path */
+        q15_t *analysis;                          /**< [frame_len] */
+        q31_t *synthesis;                         /**< [frame_len] pre-scaled for unity OLA gain */
+    } win;
+
+    struct {                                      /**< FE_PRECISION_F32 tables, NULL otherwise */
+        float *window;                            /**< [frame_len] analysis */
+        float *synthesis;                         /**< [frame_len] pre-scaled synthesis */
+        float *tw_cos;                            /**< [frame_len / 2] */
+        float *tw_sin;                            /**< [frame_len / 2] */
+    } tab_f32;
+
+#ifdef RTAFE_PROFILE
+    fe_prof_t               prof;                 /**< Per-stage cycle histograms */
+#endif
+} fe_state_t;
+
+/** Hot state of channel @p ch (record followed by its ns_bin_t array). */
+static inline fe_channel_t *fe_channel(const fe_state_t *state, uint8_t ch)
+{
+    return (fe_channel_t *)(state->chan + (size_t)ch * state->chan_stride);
+}
+
+/** FE_PRECISION_F32 view of channel @p ch. */
+static inline fe_channel_f32_t *fe_channel_f32(const fe_state_t *state, uint8_t ch)
+{
+    return (fe_channel_f32_t *)(state->chan + (size_t)ch * state->chan_stride);
+}
+
+/**
+ * Bytes required for the state arena: fe_state_t header followed by every
+ * module's per-channel state, each slice on its own cache line. Exact for
+ * @p cfg; the engine never allocates after fe_init().
+ */
+size_t fe_state_bytes(const fe_config_t *cfg);
+
+/** Bytes required for the per-hop scratch arena (cache-line aligned slices). */
+size_t fe_scratch_bytes(const fe_config_t *cfg);
+
+/**
+ * Initialize engine state in caller-provided memory.
+ * @param cfg         Configuration
+ * @param state       Block of at least fe_state_bytes(cfg) bytes
+ * @param scratch     Block of at least fe_scratch_bytes(cfg) bytes
+ * @param scratch_sz  Size of @p scratch in bytes
+ */
+fe_status_t fe_init(const fe_config_t *cfg, fe_state_t *state, void *scratch, size_t scratch_sz);
+
+/**
+ * Rebind the per-hop scratch block. Scratch carries nothing between hops,
+ * so instances that never run concurrently may share one block, e.g. a
+ * worker thread's own scratch (see fe_stream.h).
+ * @return FE_OK, or FE_ERR_NO_MEM if smaller than fe_scratch_bytes()
+ */
+fe_status_t fe_set_scratch(fe_state_t *state, void *scratch, size_t scratch_sz);
+
+/**
+ * Process one hop of interleaved Q1.15 PCM.
+ * @param state       Initialized engine state
+ * @param pcm_in      hop_len * num_channels interleaved input samples
+ * @param pcm_out     hop_len * num_channels interleaved output samples
+ * @param feature_out Optional feature output (may be NULL)
+ * @param feature_sz  Size of @p feature_out in bytes
+ */
+fe_status_t fe_process_hop(fe_state_t *state, const q15_t *pcm_in, q15_t *pcm_out, void *feature_out, size_t feature_sz);
+
+/**
+ * Publish a new parameter set from any thread while the audio thread
+ * processes. The audio thread never waits for it: it picks the set up at
+ * the start of its next hop (if that hop lands mid-update, the one after),
+ * and of several sets published between two hops applies only the last.
+ * @return FE_OK, FE_ERR_NULL_PTR, or FE_ERR_BAD_CONFIG if a flag needs
+ *         state fe_init() did not allocate or a value is negative
+ */
+fe_status_t fe_params_set(fe_state_t *state, const fe_params_t *params);
+
+/** Last published parameter set (the init values until fe_params_set()); any thread. */
+fe_status_t fe_params_get(const fe_state_t *state, fe_params_t *params);
+
+/**
+ * Input sample-rate conversion (input_rate → sample_rate), run ahead of
+ * fe_process_hop(). Caller accumulates the output into hops.
+ * @param state       Engine state
+ * @param pcm_in      n_in * num_channels interleaved samples at input_rate
+ * @param n_in        Input frames (samples per channel)
+ * @param pcm_out     Interleaved output at sample_rate, room for
+ *                    fe_resample_max_out(state, n_in) frames
+ * @return            Frames written to @p pcm_out (n_in copied if no SRC)
+ */
+size_t fe_resample_input(fe_state_t *state, const q15_t *pcm_in, size_t n_in, q15_t *pcm_out);
+
+/** Upper bound on frames fe_resample_input() produces for n_in input frames. */
+size_t fe_resample_max_out(const fe_state_t *state, size_t n_in);
+
+/**
+ * Algorithmic delay of the analysis/synthesis chain in samples: ola_len -
+ * hop_len, i.e. frame_len - hop_len for symmetric pairs and hop_len for
+ * WINDOW_PAIR_ASYM. 0 in FE_MODE_LOW_LATENCY, where each output sample
+ * depends only on inputs up to it (the minimum-phase FIR adds a few
+ * samples of signal-dependent group delay).
+ */
+uint16_t fe_latency(const fe_state_t *state);
+
+/**
+ * VAD decision of the last processed hop.
+ *
+ * The engine does not skip any of its own stages on non-speech hops: noise
+ * suppression has to run there, it is where the estimate adapts and the
+ * gain does its work. Speech-only downstream work (echo canceller
+ * adaptation, beamformer updates, feature extraction) is gated by the
+ * caller on this flag.
+ *
+ * @param state       Engine state (FE_FLAG_VAD set)
+ * @param ch          Channel index, or FE_VAD_ANY_CHANNEL for the hop-level flag
+ * @param prob_q15    Optional output: smoothed speech probability (Q1.15);
+ *                    for FE_VAD_ANY_CHANNEL the maximum over channels
+ * @return            1 if speech (including hangover), 0 otherwise
+ */
+#define FE_VAD_ANY_CHANNEL 0xFF
+uint8_t fe_vad_status(const fe_state_t *state, uint8_t ch, q15_t *prob_q15);
+
+/**
+ * Per-stage timing statistics (RTAFE_PROFILE builds).
+ * Safe to call from any thread while the audio thread is processing.
+ * @return FE_OK, or FE_ERR_BAD_CONFIG if profiling is compiled out
+ */
+fe_status_t fe_profile_get(const fe_state_t *state, fe_prof_stage_t stage, fe_prof_stats_t *out);
+
+/** Clear all histograms (call from the audio thread or while idle). */
+fe_status_t fe_profile_reset(fe_state_t *state);
+
+/** Print min/mean/p99/max per stage as a table. */
+void fe_profile_dump(const fe_state_t *state, FILE *out);
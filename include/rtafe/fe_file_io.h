@@ -0,0 +1,136 @@
+/**
+ * @file fe_file_io.h
+ * @brief Asynchronous double-buffered WAV file I/O for batch processing.
+ *
+ * One I/O thread per open file pair keeps up to depth input blocks in
+ * flight ahead of the processing cursor and writes output blocks behind
+ * it, so disk reads, PCM decode, DSP and disk writes all overlap:
+ *
+ *   disk ──read──▶ [raw] ──decode──▶ [Q1.15] ──▶ caller DSP ──▶ [Q1.15] ──encode──write──▶ disk
+ *                  └──── I/O thread ─────┘                        └──── I/O thread ────┘
+ *
+ * Backends:
+ *   FE_AIO_IO_URING — the I/O thread submits all free slots' reads and
+ *                     pending writes to an io_uring at once (Linux 5.1+,
+ *                     raw syscalls, no liburing), so several requests are
+ *                     outstanding in the kernel at a time
+ *   FE_AIO_THREAD   — the I/O thread issues pread()/pwrite() one block at
+ *                     a time; still overlaps I/O and decode with the DSP
+ *   FE_AIO_AUTO     — io_uring where the kernel allows it, else the thread
+ *
+ * Input: RIFF/WAVE PCM, 8/16/24/32 bits, decoded to interleaved Q1.15 (as
+ * _wav_to_buffer() reads, rounded to 16 bits). Output: 16-bit PCM WAV at
+ * the input's rate and channel count; sizes are patched in at close.
+ *
+ * Usage (one processing thread):
+ *   1. fe_wav_probe(in_path, &info)
+ *   2. Allocate fe_aio_bytes(&cfg, &info) bytes
+ *   3. fe_aio_open(mem, sz, &cfg, in_path, &info, out_path, &aio)
+ *   4. Loop: blk = fe_aio_read(aio, &n) until NULL; fill
+ *      fe_aio_write_slot(aio) and fe_aio_write_commit(aio, n)
+ *   5. fe_aio_close(aio, &stats)
+ *
+ * Whole-buffer callers (fe_init_buffer style) use fe_aio_read_all().
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+
+#define FE_AIO_MAX_DEPTH      16
+#define FE_AIO_DEFAULT_DEPTH  4         /**< Blocks in flight each way */
+#define FE_AIO_DEFAULT_BLOCK  8192      /**< Frames per block */
+
+typedef enum {
+    FE_AIO_AUTO     = 0,
+    FE_AIO_IO_URING = 1,
+    FE_AIO_THREAD   = 2,
+} fe_aio_backend_t;
+
+typedef struct {
+    uint32_t block_frames;    /**< Frames per block, 0 = FE_AIO_DEFAULT_BLOCK; a hop multiple for hop callers */
+    uint8_t  depth;           /**< Read-ahead / write-behind blocks, 0 = FE_AIO_DEFAULT_DEPTH */
+    uint8_t  backend;         /**< fe_aio_backend_t */
+} fe_aio_config_t;
+
+/** Input file format, from the fmt and data chunks. */
+typedef struct {
+    uint32_t sample_rate;
+    uint16_t num_channels;
+    uint16_t bits_per_sample;
+    uint64_t data_offset;     /**< Byte offset of the first sample */
+    uint64_t num_frames;      /**< Samples per channel */
+} fe_wav_info_t;
+
+/**
+ * Queue occupancy and stall counters. A stall is one wait on the other
+ * side: the caller waiting for input or for a free output slot means the
+ * I/O side is the bottleneck; the I/O thread waiting idle means the DSP is.
+ */
+typedef struct {
+    uint8_t  backend;         /**< Backend in use (never FE_AIO_AUTO) */
+    uint8_t  depth;
+    uint32_t read_ready;      /**< Decoded input blocks waiting for the caller */
+    uint32_t write_pending;   /**< Committed output blocks not yet on disk */
+    uint32_t max_in_flight;   /**< Peak transfers submitted and not yet retired */
+    uint64_t blocks_read;
+    uint64_t blocks_written;
+    uint64_t read_stalls;     /**< fe_aio_read() had to wait */
+    uint64_t write_stalls;    /**< fe_aio_write_slot() had to wait */
+    uint64_t io_idle;         /**< I/O thread slept with nothing to do */
+} fe_aio_stats_t;
+
+typedef struct fe_aio fe_aio_t;
+
+/** Parse the RIFF header of @p path. FE_ERR_IO if unreadable or not PCM WAV. */
+fe_status_t fe_wav_probe(const char *path, fe_wav_info_t *info);
+
+/** Bytes for the I/O arena: handle plus depth input and output block buffers. */
+size_t fe_aio_bytes(const fe_aio_config_t *cfg, const fe_wav_info_t *info);
+
+/**
+ * Open the pipeline and start reading ahead.
+ * @param mem       Block of at least fe_aio_bytes() bytes
+ * @param mem_sz    Size of @p mem in bytes
+ * @param cfg       Block size, depth and backend (NULL for defaults)
+ * @param in_path   Input WAV
+ * @param info      fe_wav_probe() result for @p in_path
+ * @param out_path  Output WAV (created/truncated), or NULL for read-only
+ * @param aio       Output: handle (points into @p mem)
+ */
+fe_status_t fe_aio_open(void *mem, size_t mem_sz, const fe_aio_config_t *cfg,
+                        const char *in_path, const fe_wav_info_t *info,
+                        const char *out_path, fe_aio_t **aio);
+
+/**
+ * Next decoded input block, in file order. Valid until the next call,
+ * which hands its slot back to the read-ahead.
+ * @param n_frames  Output: frames in the block (block_frames except the last)
+ * @return Interleaved Q1.15 samples, NULL at end of file or on a read error
+ */
+const q15_t *fe_aio_read(fe_aio_t *aio, size_t *n_frames);
+
+/** Free output block of block_frames * num_channels samples; waits for one if all are pending. */
+q15_t *fe_aio_write_slot(fe_aio_t *aio);
+
+/** Queue the slot from fe_aio_write_slot() with @p n_frames valid frames for writing. */
+fe_status_t fe_aio_write_commit(fe_aio_t *aio, size_t n_frames);
+
+/** Snapshot of the queue and stall counters; callable from any thread. */
+void fe_aio_stats(const fe_aio_t *aio, fe_aio_stats_t *stats);
+
+/**
+ * Drain pending writes, finalize the output header, stop the I/O thread
+ * and close both files. @p mem may be freed afterwards.
+ * @param stats  Optional output: final counters
+ * @return FE_OK, or FE_ERR_IO if any read or write failed
+ */
+fe_status_t fe_aio_close(fe_aio_t *aio, fe_aio_stats_t *stats);
+
+/**
+ * Read a whole file into @p pcm through the pipeline (read-ahead overlapped
+ * with decode); allocates its arena internally.
+ * @param pcm         Room for info->num_frames * num_channels samples
+ * @param stats       Optional output
+ */
+fe_status_t fe_aio_read_all(const char *path, const fe_aio_config_t *cfg,
+                            const fe_wav_info_t *info, q15_t *pcm, fe_aio_stats_t *stats);
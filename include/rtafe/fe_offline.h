@@ -0,0 +1,89 @@
+/**
+ * @file fe_offline.h
+ * @brief Offline time-parallel processing of whole recordings.
+ *
+ * Batch cleanup of long files: the recording is cut into time chunks on
+ * the hop grid and the chunks are processed independently on worker
+ * threads, each by a freshly initialized engine. A chunk's engine starts
+ * warmup_len + xfade_len samples before the chunk so the slow state (DC
+ * removal pole, noise minima and running estimate, VAD noise floor) has
+ * converged by the time it reaches its own samples; the warm-up output is
+ * discarded. The last xfade_len samples before each chunk boundary are
+ * produced by both neighbours and linearly crossfaded.
+ *
+ * Output is aligned with the input (the fe_latency() delay of the
+ * streaming engine is removed) and does not depend on the worker count.
+ * The first chunk, and any chunk whose warm-up would reach back past the
+ * start of the file, starts from sample 0 exactly as a serial
+ * fe_process_hop() run does. Later chunks start on the noise
+ * suppressor's sub-window grid; with the default warm-up their noise
+ * minima and estimates usually reconverge to the serial run's bit for bit
+ * before the chunk begins, and otherwise differ by a small gain error
+ * that decays over the following seconds.
+ *
+ * Usage:
+ *   1. Allocate fe_offline_bytes(&cfg, &opts, n_samples) bytes
+ *   2. fe_offline_process(mem, sz, &cfg, &opts, pcm_in, pcm_out, n_samples, &report)
+ *
+ * Input resampling (input_rate != sample_rate) is not supported; convert
+ * the file to sample_rate first.
+ */
+#pragma once
+
+#include "rtafe/fe_api.h"
+
+#define FE_OFFLINE_MAX_WORKERS       32
+#define FE_OFFLINE_WARMUP_HOPS       256  /**< Default warm-up, analysis hops (~2 s at 16 kHz / 128) */
+#define FE_OFFLINE_XFADE_HOPS        2    /**< Default crossfade at chunk boundaries */
+#define FE_OFFLINE_CHUNKS_PER_WORKER 4    /**< Default chunking, for load balance */
+#define FE_OFFLINE_MIN_CHUNK_WARMUPS 8    /**< Default chunks are >= 8x the warm-up + crossfade */
+
+/** Options; zero-initialized fields (or a NULL pointer) select the defaults. */
+typedef struct {
+    uint8_t  n_workers;       /**< Threads incl. the caller, 0 = online CPUs */
+    uint32_t chunk_len;       /**< Samples per channel per chunk, 0 = auto */
+    uint32_t warmup_len;      /**< Discarded prefix per chunk, 0 = fe_offline_default_warmup() */
+    uint32_t xfade_len;       /**< Crossfade at chunk boundaries, 0 = FE_OFFLINE_XFADE_HOPS hops */
+} fe_offline_opts_t;
+
+/** Effective parameters of a run. Lengths are per channel, rounded up to whole hops. */
+typedef struct {
+    uint32_t warmup_len;      /**< Samples */
+    uint32_t warmup_ms;       /**< Same at sample_rate */
+    uint32_t xfade_len;       /**< Samples */
+    uint32_t chunk_len;       /**< Samples */
+    uint32_t n_chunks;
+    uint8_t  n_workers;
+    uint64_t processed;       /**< Samples run through the engine, warm-up included */
+} fe_offline_report_t;
+
+/**
+ * Warm-up needed for @p cfg to converge: FE_OFFLINE_WARMUP_HOPS analysis hops, or
+ * five DC removal time constants if the corner is low enough for that to
+ * be longer. In samples per channel, whole hops.
+ */
+uint32_t fe_offline_default_warmup(const fe_config_t *cfg);
+
+/**
+ * Bytes for the offline arena: one engine state and scratch block per
+ * worker plus the crossfade side buffers of every chunk. @p opts must be
+ * the same as passed to fe_offline_process(). 0 on a bad configuration.
+ */
+size_t fe_offline_bytes(const fe_config_t *cfg, const fe_offline_opts_t *opts, size_t n_samples);
+
+/**
+ * Process a whole recording on n_workers threads (the caller's included).
+ * @param mem         Block of at least fe_offline_bytes() bytes
+ * @param mem_sz      Size of @p mem in bytes
+ * @param cfg         Engine configuration (input_rate 0 or sample_rate)
+ * @param opts        Chunking options, NULL for defaults
+ * @param pcm_in      n_samples * num_channels interleaved samples
+ * @param pcm_out     Same size as @p pcm_in, time-aligned with it; must not alias it
+ * @param n_samples   Samples per channel
+ * @param report      Optional output: effective warm-up, chunking and work done
+ * @return FE_OK, FE_ERR_BAD_CONFIG, FE_ERR_NULL_PTR or FE_ERR_NO_MEM
+ */
+fe_status_t fe_offline_process(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                               const fe_offline_opts_t *opts,
+                               const q15_t *pcm_in, q15_t *pcm_out, size_t n_samples,
+                               fe_offline_report_t *report);
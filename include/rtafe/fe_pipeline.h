@@ -0,0 +1,81 @@
+/**
+ * @file fe_pipeline.h
+ * @brief Stage-pipelined hop processing of a single high-rate stream.
+ *
+ * fe_process_hop() runs every stage of every channel on the calling
+ * thread. For a single stream whose hop does not fit in one core's budget
+ * (e.g. 48 kHz with many channels), a pipelined instance splits the hop at
+ * its existing stage boundaries over three threads:
+ *
+ *   front    (caller)    stages 1-4  DC removal, pre-emphasis, window, FFT
+ *   spectral (worker 1)  stage 5     power, VAD, noise update, gain
+ *   back     (worker 2)  stages 6-7  iFFT, overlap-add, output
+ *
+ * Work moves between stages one channel hop at a time through lock-free
+ * sequence counters (threads sleep on a condition variable only when a
+ * queue has run dry), so for C channels the three stages overlap on
+ * channels c, c - 1 and c - 2 of a hop and the back stage runs on into the
+ * caller's next hop. Each call returns the previous hop's output: one
+ * extra hop of latency buys up to 3x throughput, limited by the slowest
+ * stage. Output is bit-identical to a serial instance, one hop later.
+ *
+ * An instance is serial (fe_init) or pipelined (fe_pipeline_init) for its
+ * lifetime; the choice is made at init. FE_MODE_LOW_LATENCY is not
+ * supported. Host-only (pthreads).
+ *
+ * Usage (one audio thread):
+ *   1. Allocate fe_pipeline_bytes(&cfg) bytes
+ *   2. fe_pipeline_init(mem, sz, &cfg, &pipe)
+ *   3. fe_pipeline_process_hop() once per hop
+ *   4. fe_pipeline_destroy(pipe)
+ */
+#pragma once
+
+#include "rtafe/fe_api.h"
+
+#define FE_PIPELINE_STAGES  3       /**< Threads per instance, the caller's included */
+#define FE_PIPELINE_SPIN    4096    /**< Polls of an empty queue before sleeping */
+
+typedef struct fe_pipeline fe_pipeline_t;
+
+/**
+ * Bytes for the pipeline arena: handle, engine state, and a scratch block
+ * for each of the 2 * num_channels channel hops in flight. 0 on a bad
+ * configuration.
+ */
+size_t fe_pipeline_bytes(const fe_config_t *cfg);
+
+/**
+ * Initialize the engine in @p mem and start the two stage workers.
+ * @param mem     Block of at least fe_pipeline_bytes() bytes
+ * @param mem_sz  Size of @p mem in bytes
+ * @param cfg     Configuration (mode FE_MODE_STFT)
+ * @param pipe    Output: handle (points into @p mem)
+ */
+fe_status_t fe_pipeline_init(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                             fe_pipeline_t **pipe);
+
+/** Stop and join the workers. @p mem may be freed afterwards. */
+void fe_pipeline_destroy(fe_pipeline_t *pipe);
+
+/**
+ * Feed one hop and collect the previous one, as fe_process_hop() would
+ * have returned it on the last call (zeros on the first call). Returns
+ * once @p pcm_in has been consumed and @p pcm_out filled; the rest of the
+ * new hop completes in the background.
+ */
+fe_status_t fe_pipeline_process_hop(fe_pipeline_t *pipe, const q15_t *pcm_in, q15_t *pcm_out,
+                                    void *feature_out, size_t feature_sz);
+
+/** fe_latency() of the engine plus the pipeline's hop_len. */
+uint16_t fe_pipeline_latency(const fe_pipeline_t *pipe);
+
+/** fe_vad_status() of the hop last returned by fe_pipeline_process_hop(). */
+uint8_t fe_pipeline_vad_status(const fe_pipeline_t *pipe, uint8_t ch, q15_t *prob_q15);
+
+/**
+ * Engine instance, for configuration queries, fe_params_set() from any
+ * thread and fe_resample_input() on the audio thread. Its channel state belongs to the stage workers: do
+ * not pass it to fe_process_hop() or read per-channel VAD state from it.
+ */
+fe_state_t *fe_pipeline_state(fe_pipeline_t *pipe);
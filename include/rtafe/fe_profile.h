@@ -0,0 +1,99 @@
+/**
+ * @file fe_profile.h
+ * @brief Compile-time hot-path instrumentation: per-stage cycle histograms.
+ *
+ * Build with -DRTAFE_PROFILE to enable. When disabled the FE_PROF_* macros
+ * expand to nothing and fe_state_t carries no profiling fields, so the hop
+ * path is byte-for-byte the uninstrumented one.
+ *
+ * Time source (fe_cycles()):
+ *   ARM_TARGET  — DWT_CYCCNT (enabled by fe_init)
+ *   x86/x86_64  — rdtsc
+ *   otherwise   — CLOCK_MONOTONIC in ns
+ *
+ * Each stage keeps a log2 histogram with FE_PROF_SUB_BUCKETS linear
+ * sub-buckets per octave (p99 resolution ~±12%). There is one writer (the
+ * thread calling fe_process_hop); readers use the per-stage sequence
+ * counter to take a consistent snapshot without ever blocking the writer.
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+
+typedef enum {
+    FE_PROF_DC_PRE = 0,     /**< DC removal + pre-emphasis */
+    FE_PROF_WINDOW,         /**< Analysis window */
+    FE_PROF_FFT,            /**< Q1.15→Q1.31 promote + FFT */
+    FE_PROF_SPECTRAL,       /**< Power spectrum + VAD + noise update */
+    FE_PROF_GAIN,           /**< NS gain computation + application */
+    FE_PROF_OUTPUT,         /**< Synthesis / output write-back */
+    FE_PROF_HOP,            /**< Whole fe_process_hop() */
+    FE_PROF_NUM_STAGES
+} fe_prof_stage_t;
+
+#define FE_PROF_SUB_BITS    2
+#define FE_PROF_SUB_BUCKETS (1 << FE_PROF_SUB_BITS)
+#define FE_PROF_BUCKETS     (32 * FE_PROF_SUB_BUCKETS)
+
+typedef struct {
+    uint32_t min;           /**< Cycles (or ns on generic hosts) */
+    uint32_t max;
+    uint32_t mean;
+    uint32_t p99;           /**< Upper edge of the p99 bucket */
+    uint32_t count;         /**< Hops recorded */
+} fe_prof_stats_t;
+
+#ifdef RTAFE_PROFILE
+
+typedef struct {
+    volatile uint32_t seq;  /**< Odd while the writer is updating */
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t bucket[FE_PROF_BUCKETS];
+} fe_prof_hist_t;
+
+typedef struct {
+    fe_prof_hist_t stage[FE_PROF_NUM_STAGES];
+} fe_prof_t;
+
+#if defined(ARM_TARGET)
+#define FE_DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004)
+#define FE_DWT_CONTROL  (*(volatile uint32_t *)0xE0001000)
+#define FE_SCB_DEMCR    (*(volatile uint32_t *)0xE000EDFC)
+
+static inline uint32_t fe_cycles(void) { return FE_DWT_CYCCNT; }
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint32_t fe_cycles(void) { return (uint32_t)__rdtsc(); }
+#else
+#include <time.h>
+static inline uint32_t fe_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+void fe_prof_init(fe_prof_t *prof);
+void fe_prof_commit(fe_prof_t *prof, const uint32_t *stage_cycles, uint32_t hop_cycles);
+
+/* Hot-path markers used inside fe_process_hop() */
+#define FE_PROF_DECL()      uint32_t _prof_acc[FE_PROF_NUM_STAGES] = {0}; \
+                            uint32_t _prof_hop0 = fe_cycles(), _prof_t0 = _prof_hop0
+#define FE_PROF_MARK()      (_prof_t0 = fe_cycles())
+#define FE_PROF_ACC(stage)  do { uint32_t _prof_t = fe_cycles();              \
+                                 _prof_acc[stage] += _prof_t - _prof_t0;     \
+                                 _prof_t0 = _prof_t; } while (0)
+#define FE_PROF_COMMIT(p)   fe_prof_commit((p), _prof_acc, fe_cycles() - _prof_hop0)
+
+#else
+
+#define FE_PROF_DECL()      ((void)0)
+#define FE_PROF_MARK()      ((void)0)
+#define FE_PROF_ACC(stage)  ((void)0)
+#define FE_PROF_COMMIT(p)   ((void)0)
+
+#endif /* RTAFE_PROFILE */
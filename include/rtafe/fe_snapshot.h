@@ -0,0 +1,100 @@
+/**
+ * @file fe_snapshot.h
+ * @brief Engine state snapshot / restore: warm start and stream migration.
+ *
+ * A snapshot is a flat byte image of an instance's adaptive state: a
+ * fixed fe_snapshot_hdr_t followed by the channel blocks of the state
+ * arena copied verbatim, then the input resampler histories. Restoring it
+ * into another instance of the same configuration, in the same or another
+ * process, continues the stream where the source left off; output is
+ * bit-identical to the source carrying on. Pointers inside the channel
+ * records are stored as NULL and never read back: the target keeps its
+ * own, so the image does not depend on where either arena lives.
+ *
+ * Payload (offsets from the end of the header):
+ *   0                               num_channels channel blocks, chan_stride
+ *                                   bytes each: record, NS bins + minima
+ *                                   rows (the noise profile, up to
+ *                                   chan_hist), history ring, overlap-add
+ *                                   tail / low-latency FIR
+ *   num_channels * chan_stride      SRC only: q15_t[num_channels][2 * src_taps]
+ *                                   histories, then uint16_t[num_channels][2]
+ *                                   { pos, phase }
+ *
+ * The image is native byte order and struct layout: both ends must run
+ * builds of the same ABI. The header's magic, version and layout
+ * fingerprint (chan_stride, chan_hist) reject anything else.
+ *
+ * Restore picks its parts:
+ *   FE_SNAP_NOISE   noise estimates, minimum trackers and VAD state. Needs
+ *                   the same sample rate, frame_len, precision, channel
+ *                   count and NS/VAD allocation, but any hop, window or
+ *                   mode: a stored per-device noise profile warm-starts a
+ *                   new stream, which still primes its history as usual.
+ *   FE_SNAP_STREAM  DC / pre-emphasis memories, history ring, overlap-add
+ *                   tail or FIR, hop position, SRC state and the active
+ *                   fe_params_t. Needs an identical configuration.
+ *
+ * Neither call may run concurrently with fe_process_hop() on the same
+ * instance (a pipelined instance has a hop in flight between calls; take
+ * snapshots of serial instances). fe_snapshot_restore() also must not race
+ * fe_params_set(): it replaces the published set.
+ */
+#pragma once
+
+#include "rtafe/fe_api.h"
+
+#define FE_SNAPSHOT_MAGIC    0x53454652u   /**< "RFES" in little-endian memory */
+#define FE_SNAPSHOT_VERSION  1
+
+#define FE_SNAP_NOISE   0x01    /**< Noise profile: NS estimates + minima, VAD */
+#define FE_SNAP_STREAM  0x02    /**< Stream position: filters, history, OLA, SRC, params */
+#define FE_SNAP_ALL     (FE_SNAP_NOISE | FE_SNAP_STREAM)
+
+/** Snapshot header; the payload follows it directly. */
+typedef struct {
+    uint32_t    magic;          /**< FE_SNAPSHOT_MAGIC */
+    uint16_t    version;        /**< FE_SNAPSHOT_VERSION */
+    uint16_t    header_bytes;   /**< sizeof(fe_snapshot_hdr_t) */
+    uint32_t    total_bytes;    /**< Header + payload */
+    uint32_t    checksum;       /**< FNV-1a of header (this field 0) + payload */
+
+    /* Configuration and arena layout of the source */
+    uint32_t    sample_rate;
+    uint32_t    input_rate;
+    uint16_t    frame_len;
+    uint16_t    hop_len;
+    uint8_t     num_channels;
+    uint8_t     flags;          /**< fe_config_t flags (allocation, not the active set) */
+    uint8_t     precision;
+    uint8_t     window;
+    uint8_t     mode;
+    uint8_t     vad_speech;
+    uint16_t    src_taps;       /**< 0 without SRC */
+    uint32_t    chan_stride;    /**< Bytes per channel block */
+    uint32_t    chan_hist;      /**< End of the noise profile in a block */
+
+    /* Stream position */
+    uint16_t    hist_pos;
+    uint16_t    warmup;
+    fe_params_t params;         /**< Active parameter set */
+} fe_snapshot_hdr_t;
+
+/** Bytes of a snapshot of @p state (header + payload); 0 if @p state is NULL. */
+size_t fe_snapshot_bytes(const fe_state_t *state);
+
+/**
+ * Serialize @p state into @p buf.
+ * @param buf     At least fe_snapshot_bytes() bytes, any alignment
+ * @return FE_OK, FE_ERR_NULL_PTR or FE_ERR_NO_MEM
+ */
+fe_status_t fe_snapshot_save(const fe_state_t *state, void *buf, size_t buf_sz);
+
+/**
+ * Load @p parts (FE_SNAP_*) of a snapshot into an initialized @p state;
+ * parts not selected keep their current values.
+ * @return FE_OK, FE_ERR_NULL_PTR, FE_ERR_CORRUPT (magic, version, size or
+ *         checksum) or FE_ERR_BAD_CONFIG (configuration does not match
+ *         what @p parts needs). @p state is unchanged on error.
+ */
+fe_status_t fe_snapshot_restore(fe_state_t *state, const void *buf, size_t buf_sz, uint8_t parts);
@@ -0,0 +1,85 @@
+/**
+ * @file fe_stream.h
+ * @brief Multi-stream manager: many engine instances on a work-stealing pool.
+ *
+ * One pool owns n_streams engine instances of the same fe_config_t, all
+ * carved from a single caller-provided arena, plus n_workers threads. Each
+ * worker owns FE_STREAM_BATCH * num_channels scratch slots, one per
+ * channel hop of a round, so scratch memory scales with workers rather
+ * than streams.
+ *
+ * Usage (one control thread):
+ *   1. Allocate fe_stream_pool_bytes(&cfg, n_streams, n_workers) bytes
+ *   2. fe_stream_pool_init(mem, sz, &cfg, n_streams, n_workers, &pool)
+ *   3. Per tick: fe_stream_submit() for every stream with a hop ready,
+ *      then fe_stream_dispatch(); fe_stream_wait() to drain
+ *   4. fe_stream_pool_destroy(pool)
+ *
+ * SCHEDULING:
+ * - A stream with queued hops is claimed by exactly one work item at a
+ *   time; the worker holding it drains its queue in submission order, so
+ *   hops of one stream never run concurrently or out of order
+ * - fe_stream_dispatch() gathers claimed streams round-robin onto the
+ *   workers' deques; stream s prefers worker s % n_workers so its state
+ *   tends to stay in one core's cache
+ * - Workers pop up to FE_STREAM_BATCH streams per work item from the
+ *   bottom of their own deque; idle workers steal half a batch from the
+ *   top of a victim's deque
+ * - A work item runs in rounds of one hop per stream, stage-major across
+ *   its streams: conditioning and window for all of them, then every
+ *   channel hop's FFT (FE_PRECISION_Q31: lane batches through
+ *   fft_radix2_q31_batch) and VAD / NS, then all synthesis, so each
+ *   stage's code and tables stay hot across streams. Streams whose queue
+ *   runs empty leave the item. FE_MODE_LOW_LATENCY streams have no STFT
+ *   stages and run whole blocks back to back
+ */
+#pragma once
+
+#include "rtafe/fe_api.h"
+
+#define FE_STREAM_MAX_WORKERS 32
+#define FE_STREAM_QUEUE_DEPTH 8     /**< Hops buffered per stream (power of 2) */
+#define FE_STREAM_BATCH       8     /**< Streams per work item */
+
+typedef struct fe_stream_pool fe_stream_pool_t;
+
+/** Bytes for the pool arena: pool header, per-stream engines, worker scratch and deques. */
+size_t fe_stream_pool_bytes(const fe_config_t *cfg, uint32_t n_streams, uint8_t n_workers);
+
+/**
+ * Carve the pool from @p mem, initialize every stream's engine and start
+ * the workers.
+ * @param mem         Block of at least fe_stream_pool_bytes() bytes
+ * @param mem_sz      Size of @p mem in bytes
+ * @param cfg         Configuration shared by all streams
+ * @param n_streams   Number of streams
+ * @param n_workers   Worker threads, 1..FE_STREAM_MAX_WORKERS
+ * @param pool        Output: pool handle (points into @p mem)
+ */
+fe_status_t fe_stream_pool_init(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                                uint32_t n_streams, uint8_t n_workers,
+                                fe_stream_pool_t **pool);
+
+/** Drain outstanding hops and join the workers. @p mem may be freed afterwards. */
+void fe_stream_pool_destroy(fe_stream_pool_t *pool);
+
+/**
+ * Queue one hop for a stream. Buffers must stay valid until the hop has
+ * completed (fe_stream_completed() advances, or fe_stream_wait() returns).
+ * @return FE_OK, FE_ERR_BUSY if the stream already has
+ *         FE_STREAM_QUEUE_DEPTH hops queued, FE_ERR_BAD_CONFIG on a bad id
+ */
+fe_status_t fe_stream_submit(fe_stream_pool_t *pool, uint32_t stream,
+                             const q15_t *pcm_in, q15_t *pcm_out);
+
+/** Hand all streams with queued hops to the workers. */
+void fe_stream_dispatch(fe_stream_pool_t *pool);
+
+/** Dispatch and block until every queued hop has been processed. */
+void fe_stream_wait(fe_stream_pool_t *pool);
+
+/** Hops completed so far on @p stream. */
+uint32_t fe_stream_completed(const fe_stream_pool_t *pool, uint32_t stream);
+
+/** Engine instance of @p stream (e.g. for fe_vad_status); NULL on a bad id. */
+fe_state_t *fe_stream_state(fe_stream_pool_t *pool, uint32_t stream);
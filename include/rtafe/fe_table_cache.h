@@ -0,0 +1,42 @@
+/**
+ * @file fe_table_cache.h
+ * @brief Lazily built, process-wide window/twiddle/bit-reversal tables.
+ *
+ * Host builds (RTAFE_TABLE_CACHE) only need to link the generated ROM
+ * tables for the sizes they use most; any other power-of-2 frame length
+ * is built on first use and then shared read-only by every engine
+ * instance and thread for the life of the process.
+ *
+ * THREADING:
+ * - fe_table_cache_get() is safe from any thread. The first caller for a
+ *   size builds the tables under a spinlock and publishes them with a
+ *   release store; later callers take the lock-free acquire fast path
+ * - Building allocates, so real-time threads should not be the first to
+ *   ask for a size: call fe_table_cache_prewarm() at startup
+ *
+ * Cached tables carry the same windows, twiddles and bit-reversal map as
+ * the generated ones (bit-identical); the mel_* pointers are NULL.
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+
+#define FE_TABLE_CACHE_MIN_N 8
+#define FE_TABLE_CACHE_MAX_N 32768
+
+struct fe_tables;
+
+/**
+ * @brief Tables for frame length @p n, building them on first use.
+ *
+ * @return NULL if @p n is not a power of 2 in
+ *         [FE_TABLE_CACHE_MIN_N, FE_TABLE_CACHE_MAX_N] or allocation fails
+ */
+const struct fe_tables *fe_table_cache_get(uint16_t n);
+
+/**
+ * @brief Build the tables for @p count sizes up front.
+ *
+ * @return FE_OK, FE_ERR_BAD_CONFIG for an unsupported size, FE_ERR_NO_MEM
+ */
+fe_status_t fe_table_cache_prewarm(const uint16_t *sizes, size_t count);
@@ -0,0 +1,71 @@
+/**
+ * @file fe_types.h
+ * @brief Common fixed-point types, status codes and logging for the RTAFE engine.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* ── Fixed-point sample types ───────────────────────────────────────────── */
+typedef int16_t q15_t;   /**< Q1.15 */
+typedef int32_t q31_t;   /**< Q1.31 */
+typedef int64_t q63_t;   /**< Q1.63 / wide accumulator */
+
+#define Q1_15_SHIFT 15
+#define Q1_31_SHIFT 31
+
+/* ── Status codes ───────────────────────────────────────────────────────── */
+typedef enum {
+    FE_OK              =  0,
+    FE_ERR_NULL_PTR    = -1,   /**< Required pointer argument was NULL */
+    FE_ERR_BAD_CONFIG  = -2,   /**< Unsupported or inconsistent configuration */
+    FE_ERR_NO_MEM      = -3,   /**< Caller-provided memory block too small */
+    FE_ERR_BUSY        = -4,   /**< Queue full, retry after work completes */
+    FE_ERR_IO          = -5,   /**< File open/read/write failed or not a supported WAV */
+    FE_ERR_CORRUPT     = -6,   /**< Serialized data failed its format, version or checksum check */
+} fe_status_t;
+
+/* ── Module enable flags (fe_config_t.flags) ────────────────────────────── */
+#define FE_FLAG_DC_REMOVAL      0x01
+#define FE_FLAG_PRE_EMPHASIS    0x02
+#define FE_FLAG_NOISE_SUPPRESS  0x04
+#define FE_FLAG_AGC             0x08
+#define FE_FLAG_VAD             0x10
+
+/* ── Hot-path placement (bare-metal ARM, arm-cortexM/sections.ld) ───────── */
+/**
+ * RTAFE_FAST_CODE marks hop-path kernels and RTAFE_FAST_DATA the read-only
+ * tables they index, so neither pays flash wait states. On an ARM_TARGET
+ * build with RTAFE_RAM_CODE / RTAFE_RAM_TABLES (make RAM_CODE=1
+ * RAM_TABLES=1) they go to .fast_text / .fast_rodata, which the linker
+ * maps to SRAM (linker.ld) or ITCM/DTCM (linker_m7.ld) with a load image
+ * in flash that Reset_Handler copies. RTAFE_FAST_BSS puts a zero-filled
+ * buffer, e.g. a static engine arena, in the fast data region. Host
+ * builds expand all three to nothing.
+ */
+#if defined(ARM_TARGET) && defined(RTAFE_RAM_CODE)
+#define RTAFE_FAST_CODE __attribute__((section(".fast_text")))
+#else
+#define RTAFE_FAST_CODE
+#endif
+
+#if defined(ARM_TARGET) && defined(RTAFE_RAM_TABLES)
+#define RTAFE_FAST_DATA __attribute__((section(".fast_rodata")))
+#else
+#define RTAFE_FAST_DATA
+#endif
+
+#if defined(ARM_TARGET)
+#define RTAFE_FAST_BSS __attribute__((section(".fast_bss")))
+#else
+#define RTAFE_FAST_BSS
+#endif
+
+/* ── Logging (compiled out unless RTAFE_DEBUG, it sits on hot paths) ───── */
+#ifdef RTAFE_DEBUG
+#define RTAFE_LOG(fmt, ...) printf("[RTAFE] " fmt, ##__VA_ARGS__)
+#else
+#define RTAFE_LOG(fmt, ...) ((void)0)
+#endif
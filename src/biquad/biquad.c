@@ -0,0 +1,57 @@
+#include <stddef.h>
+#include "biquad.h"
+/* biquad.c */
+
+/**
+ * Process-wide design cache. Entries are only appended, never evicted,
+ * so a returned pointer stays valid for the life of the process and can
+ * be shared by any number of channels/streams. Lookups happen at init
+ * time; a spinlock keeps concurrent stream setup safe.
+ */
+static biquad_design design_cache[BIQUAD_DESIGN_CACHE_SIZE];
+static int design_count = 0;
+static volatile int design_lock = 0;
+
+static inline void cache_lock(void)
+{
+    while (__atomic_test_and_set(&design_lock, __ATOMIC_ACQUIRE)) { }
+}
+
+static inline void cache_unlock(void)
+{
+    __atomic_clear(&design_lock, __ATOMIC_RELEASE);
+}
+
+const biquad_design *biquad_design_get(biquad_type type, float freq, float Q, float fs)
+{
+    const biquad_design *found = NULL;
+
+    cache_lock();
+    for (int i = 0; i < design_count; i++) {
+        const biquad_design *d = &design_cache[i];
+        if (d->type == type && d->freq == freq && d->Q == Q && d->fs == fs) {
+            found = d;
+            break;
+        }
+    }
+
+    if (found == NULL && design_count < BIQUAD_DESIGN_CACHE_SIZE) {
+        biquad_design *d = &design_cache[design_count];
+        d->type = type;
+        d->freq = freq;
+        d->Q = Q;
+        d->fs = fs;
+        biquad_design_coeffs(&d->coeff, type, freq, Q, fs);
+        biquad_quantize(&d->coeff, &d->coeff_fixed);
+        design_count++;
+        found = d;
+    }
+    cache_unlock();
+
+    return found;
+}
+
+int biquad_design_cache_count(void)
+{
+    return __atomic_load_n(&design_count, __ATOMIC_ACQUIRE);
+}
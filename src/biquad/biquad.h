@@ -1,5 +1,11 @@
+#pragma once
+
 #include "utils.h"
 
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
 typedef struct biquad_coeffs
 {
     float b0;
@@ -27,7 +33,7 @@ typedef struct biquad {
     biquad_coeffs_fixed coeff_fixed;
 } biquad;
 
-static inline float biquad_df2t(biquad_coeffs *c, float x, float *d1, float *d2)
+static inline float biquad_df2t(const biquad_coeffs *c, float x, float *d1, float *d2)
 {
     float out = c->b0 * x + *d1;
 
@@ -40,19 +46,27 @@ static inline float biquad_df2t(biquad_coeffs *c, float x, float *d1, float *d2)
     return out;
 }
 
-static inline s16 biquad_df2t_fixed(biquad_coeffs_fixed *c, s16 x, s64 *d1, s64 *d2)
+static inline s16 biquad_df2t_fixed(const biquad_coeffs_fixed *c, s16 x, s64 *d1, s64 *d2)
 {
     s64 acc = (s64)c->b0 * x + *d1;
 
     s16 out = (s16)(acc + 0x2000) >> 14;
 
+#if defined(__ARM_FEATURE_DSP)
+    /* Both state updates as SMLSLD on (x, out) packed in one register:
+       lo * lo - hi * hi accumulated into 64 bits, same result as below */
+    int32_t xo = (int32_t)((u16)x | ((u32)(u16)out << 16));
+    *d1 = __smlsld((int32_t)((u16)c->b1 | ((u32)(u16)c->a1 << 16)), xo, *d2);
+    *d2 = __smlsld((int32_t)((u16)c->b2 | ((u32)(u16)c->a2 << 16)), xo, 0);
+#else
     *d1 = (s64)c->b1 * x - (s64)c->a1 * out + *d2;
     *d2 = (s64)c->b2 * x - (s64)c->a2 * out;
+#endif
 
     return out;
 }
 
-static inline void biquad_quantize(biquad_coeffs *c_float, biquad_coeffs_fixed *c_fixed)
+static inline void biquad_quantize(const biquad_coeffs *c_float, biquad_coeffs_fixed *c_fixed)
 {
     c_fixed->b0 = FLOAT_TO_Q2_14(c_float->b0);
     c_fixed->b1 = FLOAT_TO_Q2_14(c_float->b1);
@@ -61,9 +75,9 @@ static inline void biquad_quantize(biquad_coeffs *c_float, biquad_coeffs_fixed *
     c_fixed->a2 = FLOAT_TO_Q2_14(c_float->a2);
 }
 
-static inline void _biquad_lpf(biquad_coeffs *res, float freq, float Q) 
+static inline void _biquad_lpf(biquad_coeffs *res, float freq, float Q, float fs) 
 {
-    sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+    sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 
     float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
@@ -76,9 +90,9 @@ static inline void _biquad_lpf(biquad_coeffs *res, float freq, float Q)
 	res->a2 = (1 - alpha) * a0_inv;
 }
 
-static inline void _biquad_hpf(biquad_coeffs *res, float freq, float Q)
+static inline void _biquad_hpf(biquad_coeffs *res, float freq, float Q, float fs)
 {
-	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 	float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
 	float b1 = (1 + w0.cos) * a0_inv;
@@ -90,9 +104,9 @@ static inline void _biquad_hpf(biquad_coeffs *res, float freq, float Q)
 	res->a2 = (1 - alpha)	* a0_inv;
 }
 
-static inline void _biquad_notch_filter(biquad_coeffs *res, float freq, float Q)
+static inline void _biquad_notch_filter(biquad_coeffs *res, float freq, float Q, float fs)
 {
-	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 	float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
 
@@ -103,9 +117,9 @@ static inline void _biquad_notch_filter(biquad_coeffs *res, float freq, float Q)
 	res->a2 = (1 - alpha)	* a0_inv;
 }
 
-static inline void _biquad_bpf_peak(biquad_coeffs *res, float freq, float Q)
+static inline void _biquad_bpf_peak(biquad_coeffs *res, float freq, float Q, float fs)
 {
-	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 	float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
 
@@ -116,9 +130,9 @@ static inline void _biquad_bpf_peak(biquad_coeffs *res, float freq, float Q)
 	res->a2 = (1 - alpha)	* a0_inv;
 }
 
-static inline void _biquad_bpf(biquad_coeffs *res, float freq, float Q)
+static inline void _biquad_bpf(biquad_coeffs *res, float freq, float Q, float fs)
 {
-	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 	float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
 
@@ -129,9 +143,9 @@ static inline void _biquad_bpf(biquad_coeffs *res, float freq, float Q)
 	res->a2 = (1 - alpha)	* a0_inv;
 }
 
-static inline void _biquad_allpass_filter(biquad_coeffs *res, float freq, float Q)
+static inline void _biquad_allpass_filter(biquad_coeffs *res, float freq, float Q, float fs)
 {
-	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / SAMPLING_RATE);
+	sincos w0 = fast_sine_cos(2.0f * M_PI * freq / fs);
 	float alpha = w0.sin/(2*Q);
 	float a0_inv = 1/(1 + alpha);
 
@@ -142,19 +156,84 @@ static inline void _biquad_allpass_filter(biquad_coeffs *res, float freq, float
 	res->a2 = res->b0;
 }
 
+#ifdef FIXED_POINT
+static inline s16 biquad_step_fixed(biquad *bq, s16 x)
+{
+	return biquad_df2t_fixed(&bq->coeff_fixed, x, &bq->state.d1, &bq->state.d2);
+}
+#else
 static inline float biquad_step(biquad *bq, float x)
 {
 	return biquad_df2t(&bq->coeff, x, &bq->state.d1, &bq->state.d2);
 }
+#endif
 
-static inline s16 biquad_step_fixed(biquad *bq, s16 x)
+#define biquad_lpf(bq,f,Q) _biquad_lpf(&(bq)->coeff,f,Q,SAMPLING_RATE)
+#define biquad_hpf(bq,f,Q) _biquad_hpf(&(bq)->coeff,f,Q,SAMPLING_RATE)
+#define biquad_notch_filter(bq,f,Q) _biquad_notch_filter(&(bq)->coeff,f,Q,SAMPLING_RATE)
+#define biquad_bpf_peak(bq,f,Q) _biquad_bpf_peak(&(bq)->coeff,f,Q,SAMPLING_RATE)
+#define biquad_bpf(bq,f,Q) _biquad_bpf(&(bq)->coeff,f,Q,SAMPLING_RATE)
+#define biquad_allpass_filter(bq,f,Q) _biquad_allpass_filter(&(bq)->coeff,f,Q,SAMPLING_RATE)
+
+/* Runtime sample-rate variants */
+#define biquad_lpf_fs(bq,f,Q,fs) _biquad_lpf(&(bq)->coeff,f,Q,fs)
+#define biquad_hpf_fs(bq,f,Q,fs) _biquad_hpf(&(bq)->coeff,f,Q,fs)
+#define biquad_notch_filter_fs(bq,f,Q,fs) _biquad_notch_filter(&(bq)->coeff,f,Q,fs)
+#define biquad_bpf_peak_fs(bq,f,Q,fs) _biquad_bpf_peak(&(bq)->coeff,f,Q,fs)
+#define biquad_bpf_fs(bq,f,Q,fs) _biquad_bpf(&(bq)->coeff,f,Q,fs)
+#define biquad_allpass_filter_fs(bq,f,Q,fs) _biquad_allpass_filter(&(bq)->coeff,f,Q,fs)
+
+/* ── Shared coefficient designs ─────────────────────────────────────────── */
+
+typedef enum {
+    BIQUAD_LPF = 0,
+    BIQUAD_HPF,
+    BIQUAD_NOTCH,
+    BIQUAD_BPF_PEAK,
+    BIQUAD_BPF,
+    BIQUAD_ALLPASS,
+} biquad_type;
+
+#define BIQUAD_DESIGN_CACHE_SIZE 32
+
+/** One designed coefficient set, shared read-only by every filter using it. */
+typedef struct biquad_design {
+    biquad_type type;
+    float freq, Q, fs;
+    biquad_coeffs coeff;
+    biquad_coeffs_fixed coeff_fixed;   /**< Q2.14 */
+} biquad_design;
+
+static inline void biquad_design_coeffs(biquad_coeffs *res, biquad_type type, float freq, float Q, float fs)
 {
-	return biquad_df2t_fixed(&bq->coeff_fixed, x, &bq->state.d1, &bq->state.d2);
+	switch (type) {
+	case BIQUAD_LPF:      _biquad_lpf(res, freq, Q, fs); break;
+	case BIQUAD_HPF:      _biquad_hpf(res, freq, Q, fs); break;
+	case BIQUAD_NOTCH:    _biquad_notch_filter(res, freq, Q, fs); break;
+	case BIQUAD_BPF_PEAK: _biquad_bpf_peak(res, freq, Q, fs); break;
+	case BIQUAD_BPF:      _biquad_bpf(res, freq, Q, fs); break;
+	case BIQUAD_ALLPASS:  _biquad_allpass_filter(res, freq, Q, fs); break;
+	}
 }
 
-#define biquad_lpf(bq,f,Q) _biquad_lpf(&(bq)->coeff,f,Q)
-#define biquad_hpf(bq,f,Q) _biquad_hpf(&(bq)->coeff,f,Q)
-#define biquad_notch_filter(bq,f,Q) _biquad_notch_filter(&(bq)->coeff,f,Q)
-#define biquad_bpf_peak(bq,f,Q) _biquad_bpf_peak(&(bq)->coeff,f,Q)
-#define biquad_bpf(bq,f,Q) _biquad_bpf(&(bq)->coeff,f,Q)
-#define biquad_allpass_filter(bq,f,Q) _biquad_allpass_filter(&(bq)->coeff,f,Q)
\ No newline at end of file
+/**
+ * Look up (type, freq, Q, fs) in the process-wide design cache, designing
+ * and quantizing it on first use. Call at init time, not per sample.
+ * @return Shared design, or NULL if the cache is full
+ */
+const biquad_design *biquad_design_get(biquad_type type, float freq, float Q, float fs);
+
+/** Number of distinct designs currently cached. */
+int biquad_design_cache_count(void);
+
+#ifdef FIXED_POINT
+static inline s16 biquad_step_shared_fixed(const biquad_design *d, biquad_state *s, s16 x)
+{
+	return biquad_df2t_fixed(&d->coeff_fixed, x, &s->d1, &s->d2);
+}
+#else
+static inline float biquad_step_shared(const biquad_design *d, biquad_state *s, float x)
+{
+	return biquad_df2t(&d->coeff, x, &s->d1, &s->d2);
+}
+#endif
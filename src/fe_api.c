@@ -1,12 +1,467 @@
 #include <stdio.h>
-#include "fe_api.h"
-#include "pipeline/window.h"
-#include "pipeline/fft.h"
-#include "pipeline/noise_suppress.h"
-#include "math/tables.h"
+#include <string.h>
+#include "rtafe/fe_api.h"
+#include "rtafe/fe_table_cache.h"
+#include "fe_hop.h"
+#include "module/window.h"
+#include "module/fft.h"
+#include "module/ifft.h"
+#include "module/minphase.h"
+#include "module/noise_suppress.h"
+#include "module/vad.h"
+#include "fixedpoint.h"
+#include "tables.h"
 
 /* fe_api.c — Top-level pipeline orchestration */
 
+#define FE_ALIGN(x, a)       (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+
+static inline size_t fe_num_bins(const fe_config_t *cfg)
+{
+    return (size_t)cfg->frame_len / 2 + 1;
+}
+
+static inline uint8_t fe_has_src(const fe_config_t *cfg)
+{
+    return cfg->input_rate != 0 && cfg->input_rate != cfg->sample_rate;
+}
+
+static inline uint8_t fe_has_spectral(const fe_config_t *cfg)
+{
+    return (cfg->flags & (FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD)) != 0;
+}
+
+/* Generated ROM tables first, then (host builds) the runtime cache */
+static const fe_tables_t *fe_find_tables(uint16_t frame_len)
+{
+    const fe_tables_t *tab = fe_tables_get(frame_len);
+#ifdef RTAFE_TABLE_CACHE
+    if (tab == NULL) tab = fe_table_cache_get(frame_len);
+#endif
+    return tab;
+}
+
+static fe_status_t fe_check_config(const fe_config_t *cfg)
+{
+    if (cfg == NULL) return FE_ERR_NULL_PTR;
+    /* Window/twiddle tables: generated TABLE_SIZES or the runtime cache */
+    if (fe_find_tables(cfg->frame_len) == NULL) return FE_ERR_BAD_CONFIG;
+    if (cfg->num_channels == 0) return FE_ERR_BAD_CONFIG;
+    if (cfg->sample_rate == 0) return FE_ERR_BAD_CONFIG;
+    if (cfg->precision > FE_PRECISION_Q15) return FE_ERR_BAD_CONFIG;
+    /* Overlap geometry; window_pair_design() verifies COLA itself at init */
+    if (cfg->hop_len == 0 || cfg->frame_len % cfg->hop_len != 0) return FE_ERR_BAD_CONFIG;
+    if (cfg->window > WINDOW_PAIR_ASYM) return FE_ERR_BAD_CONFIG;
+    if (cfg->window != WINDOW_PAIR_RECT && 2 * cfg->hop_len > cfg->frame_len) return FE_ERR_BAD_CONFIG;
+    /* Low-latency mode: float FIR design, analysis every frame_len / 2 */
+    if (cfg->mode > FE_MODE_LOW_LATENCY) return FE_ERR_BAD_CONFIG;
+    if (cfg->mode == FE_MODE_LOW_LATENCY &&
+        (cfg->precision != FE_PRECISION_F32 || cfg->window == WINDOW_PAIR_RECT ||
+         cfg->frame_len < 2 * FE_LL_FIR_TAPS)) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if (fe_has_src(cfg) &&
+        resample_geometry(cfg->input_rate, cfg->sample_rate, NULL, NULL, NULL) != FE_OK) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    return FE_OK;
+}
+
+/* ── Arena layout ───────────────────────────────────────────────────────────
+ *
+ * Both blocks are described by one layout function each, used for sizing
+ * (fe_state_bytes / fe_scratch_bytes) and for carving (fe_init), so the
+ * byte counts are exact by construction. Every slice starts on its own
+ * cache line; offsets are relative to the first cache-line boundary after
+ * the fe_state_t header (state block) or the block start (scratch), and the
+ * sizes include FE_CACHE_LINE - 1 bytes of slack for that alignment.
+ * Slices a configuration does not use have size 0.
+ */
+
+typedef struct {
+    size_t chan, chan_stride;       /* [num_channels] fe_channel_t + ns_bin_t[n_bins] + minima ring + hist + ola + fir */
+    size_t chan_hist, chan_ola, chan_fir;   /* offsets inside one channel block */
+    size_t win;                     /* analysis q15[N] + synthesis q31[N], Q31 only */
+    size_t tab_f32;                 /* window[N] + synthesis[N] + tw_cos[N/2] + tw_sin[N/2], F32 only */
+    size_t src_coeffs, src_state, src_hist;
+    size_t total;
+} fe_state_layout_t;
+
+typedef struct {
+    size_t frame, fft_re, fft_im, power, gain;
+    size_t total;
+} fe_scratch_layout_t;
+
+/** Reserve a cache-line aligned slice; returns its offset. */
+static inline size_t fe_arena_take(size_t *cursor, size_t bytes)
+{
+    size_t off = *cursor;
+    *cursor = FE_ALIGN(off + bytes, FE_CACHE_LINE);
+    return off;
+}
+
+/* Synthesis support: the asymmetric pair only overlaps its last 2 * hop;
+   low-latency mode has no overlap-add */
+static inline size_t fe_ola_len(const fe_config_t *cfg)
+{
+    if (cfg->mode == FE_MODE_LOW_LATENCY) return 0;
+    return (cfg->window == WINDOW_PAIR_ASYM) ? 2 * (size_t)cfg->hop_len : cfg->frame_len;
+}
+
+/* Low-latency mode analyzes every frame_len / 2 samples, whatever the block size */
+static inline uint16_t fe_analysis_hop(const fe_config_t *cfg)
+{
+    return (cfg->mode == FE_MODE_LOW_LATENCY) ? cfg->frame_len / 2 : cfg->hop_len;
+}
+
+static void fe_state_layout(const fe_config_t *cfg, fe_state_layout_t *lay)
+{
+    size_t ch = cfg->num_channels;
+    size_t n_bins = fe_num_bins(cfg);
+    uint8_t f32 = (cfg->precision == FE_PRECISION_F32);
+    size_t rec_bytes = f32 ? sizeof(fe_channel_f32_t) : sizeof(fe_channel_t);
+    /* Bin records, then the NS_SUBWIN_COUNT rows of sub-window minima
+       (q31_t and float are the same width) */
+    size_t bin_bytes = !fe_has_spectral(cfg) ? 0
+                     : n_bins * ((f32 ? sizeof(ns_bin_f32_t) : sizeof(ns_bin_t)) +
+                                 NS_SUBWIN_COUNT * sizeof(q31_t));
+    size_t n = cfg->frame_len;
+    size_t hist_bytes = n * (f32 ? sizeof(float) : sizeof(q15_t));
+    size_t ola_bytes = fe_ola_len(cfg) * (f32 ? sizeof(float) : sizeof(q31_t));
+    size_t fir_bytes = (cfg->mode == FE_MODE_LOW_LATENCY) ? FE_LL_FIR_TAPS * sizeof(float) : 0;
+    size_t cur = 0;
+
+    memset(lay, 0, sizeof(*lay));
+    /* Channel-major: each channel's record and bin array are contiguous,
+       then its history and overlap-add tail on the following lines, and
+       every channel block starts on its own cache line */
+    lay->chan_hist   = FE_ALIGN(rec_bytes + bin_bytes, FE_CACHE_LINE);
+    lay->chan_ola    = FE_ALIGN(lay->chan_hist + hist_bytes, FE_CACHE_LINE);
+    lay->chan_fir    = FE_ALIGN(lay->chan_ola + ola_bytes, FE_CACHE_LINE);
+    lay->chan_stride = FE_ALIGN(lay->chan_fir + fir_bytes, FE_CACHE_LINE);
+    lay->chan        = fe_arena_take(&cur, ch * lay->chan_stride);
+    lay->win         = fe_arena_take(&cur, f32 ? 0 : n * (sizeof(q15_t) + sizeof(q31_t)));
+    lay->tab_f32     = fe_arena_take(&cur, f32 ? 3 * n * sizeof(float) : 0);
+
+    if (fe_has_src(cfg)) {
+        uint16_t L, M, taps;
+        resample_geometry(cfg->input_rate, cfg->sample_rate, &L, &M, &taps);
+        lay->src_coeffs = fe_arena_take(&cur, (size_t)L * taps * sizeof(q15_t));
+        lay->src_state  = fe_arena_take(&cur, ch * sizeof(resample_state_t));
+        lay->src_hist   = fe_arena_take(&cur, ch * 2 * (size_t)taps * sizeof(q15_t));
+    }
+
+    lay->total = sizeof(fe_state_t) + (FE_CACHE_LINE - 1) + cur;
+}
+
+/* Scratch depends only on frame_len, flags and precision, so it can be
+   re-derived from an initialized state when the block is rebound
+   (fe_set_scratch). Slices are sized for the wider of the two views. */
+static void fe_scratch_layout(uint16_t frame_len, uint8_t flags, uint8_t precision,
+                              fe_scratch_layout_t *lay)
+{
+    size_t n = frame_len;
+    uint8_t spectral = (flags & (FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD)) != 0;
+    size_t n_bins = spectral ? n / 2 + 1 : 0;
+    size_t n_gain = (flags & FE_FLAG_NOISE_SUPPRESS) ? n / 2 + 1 : 0;
+    size_t sample_sz = (precision == FE_PRECISION_F32) ? sizeof(float) : sizeof(q15_t);
+    /* Q15: interleaved 16-bit complex spectrum in the fft_re slice alone */
+    size_t im_sz = (precision == FE_PRECISION_Q15) ? 0 : sizeof(q31_t);
+    size_t cur = 0;
+
+    memset(lay, 0, sizeof(*lay));
+    lay->frame  = fe_arena_take(&cur, n * sample_sz);
+    lay->fft_re = fe_arena_take(&cur, n * sizeof(q31_t));
+    lay->fft_im = fe_arena_take(&cur, n * im_sz);
+    lay->power  = fe_arena_take(&cur, n_bins * sizeof(q31_t));
+    lay->gain   = fe_arena_take(&cur, n_gain * sample_sz);
+
+    lay->total = (FE_CACHE_LINE - 1) + cur;
+}
+
+static inline uint8_t *fe_align_ptr(void *p)
+{
+    return (uint8_t *)FE_ALIGN((uintptr_t)p, FE_CACHE_LINE);
+}
+
+static void fe_carve_work(void *scratch, const fe_scratch_layout_t *lay, fe_work_t *work)
+{
+    uint8_t *xbase = fe_align_ptr(scratch);
+    work->frame_q15 = (q15_t *)(xbase + lay->frame);
+    work->fft_re    = (q31_t *)(xbase + lay->fft_re);
+    work->fft_im    = (q31_t *)(xbase + lay->fft_im);
+    work->fft_q15   = (q15_t *)(xbase + lay->fft_re);
+    work->power     = (q31_t *)(xbase + lay->power);
+    work->gain      = (q15_t *)(xbase + lay->gain);
+    work->frame_f32 = (float *)(xbase + lay->frame);
+    work->re_f32    = (float *)(xbase + lay->fft_re);
+    work->im_f32    = (float *)(xbase + lay->fft_im);
+    work->power_f32 = (float *)(xbase + lay->power);
+    work->gain_f32  = (float *)(xbase + lay->gain);
+}
+
+static void fe_bind_scratch(fe_state_t *state, void *scratch, size_t scratch_sz,
+                            const fe_scratch_layout_t *lay)
+{
+    state->scratch    = scratch;
+    state->scratch_sz = scratch_sz;
+    fe_carve_work(scratch, lay, &state->work);
+}
+
+size_t fe_state_bytes(const fe_config_t *cfg)
+{
+    if (fe_check_config(cfg) != FE_OK) return 0;
+    fe_state_layout_t lay;
+    fe_state_layout(cfg, &lay);
+    return lay.total;
+}
+
+size_t fe_scratch_bytes(const fe_config_t *cfg)
+{
+    if (fe_check_config(cfg) != FE_OK) return 0;
+    fe_scratch_layout_t lay;
+    fe_scratch_layout(cfg->frame_len, cfg->flags, cfg->precision, &lay);
+    return lay.total;
+}
+
+fe_status_t fe_set_scratch(fe_state_t *state, void *scratch, size_t scratch_sz)
+{
+    if (state == NULL || scratch == NULL) return FE_ERR_NULL_PTR;
+
+    fe_scratch_layout_t lay;
+    fe_scratch_layout(state->frame_len, state->flags, state->precision, &lay);
+    if (scratch_sz < lay.total) return FE_ERR_NO_MEM;
+
+    fe_bind_scratch(state, scratch, scratch_sz, &lay);
+    return FE_OK;
+}
+
+fe_status_t fe_work_bind(const fe_state_t *state, void *scratch, size_t scratch_sz, fe_work_t *work)
+{
+    if (state == NULL || scratch == NULL || work == NULL) return FE_ERR_NULL_PTR;
+
+    fe_scratch_layout_t lay;
+    fe_scratch_layout(state->frame_len, state->flags, state->precision, &lay);
+    if (scratch_sz < lay.total) return FE_ERR_NO_MEM;
+
+    fe_carve_work(scratch, &lay, work);
+    return FE_OK;
+}
+
+fe_status_t fe_init(const fe_config_t *cfg, fe_state_t *state, void *scratch, size_t scratch_sz)
+{
+    fe_status_t st = fe_check_config(cfg);
+    if (st != FE_OK) return st;
+    if (state == NULL || scratch == NULL) return FE_ERR_NULL_PTR;
+
+    fe_state_layout_t slay;
+    fe_scratch_layout_t xlay;
+    fe_state_layout(cfg, &slay);
+    fe_scratch_layout(cfg->frame_len, cfg->flags, cfg->precision, &xlay);
+    if (scratch_sz < xlay.total) return FE_ERR_NO_MEM;
+
+    size_t ch = cfg->num_channels;
+    size_t n_bins = fe_num_bins(cfg);
+
+    memset(state, 0, slay.total);
+    state->sample_rate  = cfg->sample_rate;
+    state->frame_len    = cfg->frame_len;
+    state->tab          = fe_find_tables(cfg->frame_len);
+    state->hop_len      = cfg->hop_len;
+    state->num_channels = cfg->num_channels;
+    state->flags        = cfg->flags;
+    state->precision    = cfg->precision;
+    state->window       = cfg->window;
+    state->mode         = cfg->mode;
+    state->ola_len      = (uint16_t)fe_ola_len(cfg);
+    state->warmup       = (uint16_t)(cfg->frame_len / cfg->hop_len - 1);
+    state->state_sz     = slay.total;
+    while ((1u << state->frame_log2) < cfg->frame_len) state->frame_log2++;
+#ifdef RTAFE_PROFILE
+    fe_prof_init(&state->prof);
+#endif
+
+    /* Carve the state arena: first cache line after the header */
+    uint8_t *base = fe_align_ptr((uint8_t *)state + sizeof(fe_state_t));
+    uint8_t spectral = fe_has_spectral(cfg);
+
+    state->chan        = base + slay.chan;
+    state->chan_stride = slay.chan_stride;
+
+    /* Carve the scratch arena */
+    fe_bind_scratch(state, scratch, scratch_sz, &xlay);
+
+    state->input_rate = fe_has_src(cfg) ? cfg->input_rate : cfg->sample_rate;
+    if (fe_has_src(cfg)) {
+        st = resample_bank_init(&state->resample_bank, cfg->input_rate, cfg->sample_rate,
+                                (q15_t *)(base + slay.src_coeffs));
+        if (st != FE_OK) return st;
+
+        uint16_t taps = state->resample_bank.taps;
+        q15_t *hist = (q15_t *)(base + slay.src_hist);
+        state->resample_block = (resample_state_t *)(base + slay.src_state);
+        for (size_t c = 0; c < ch; c++) {
+            resample_init(&state->resample_block[c], &state->resample_bank,
+                          hist + c * 2 * (size_t)taps);
+        }
+    }
+
+    /* DC pole designed for the runtime rate unless given explicitly */
+    q31_t dc_alpha = cfg->dc_rm_alpha;
+    if (dc_alpha == 0) {
+        uint16_t fc = cfg->dc_rm_cutoff_hz ? cfg->dc_rm_cutoff_hz : FE_DC_DEFAULT_CUTOFF_HZ;
+        dc_alpha = dc_removal_alpha_q31((float)fc, (float)cfg->sample_rate);
+    }
+
+    /* Runtime parameters start as configured; DC removal and pre-emphasis
+       have no enable at init (they always run) */
+    state->params.flags              = cfg->flags | FE_FLAG_DC_REMOVAL | FE_FLAG_PRE_EMPHASIS;
+    state->params.dc_rm_alpha        = dc_alpha;
+    state->params.pre_emphasis_alpha = cfg->pre_emphasis_alpha;
+    state->params.ns_over_sub        = FE_NS_OVER_SUB_UNITY;
+    state->params.ns_floor           = FE_NS_FLOOR_DEFAULT;
+    state->params_prev = state->params;
+    state->ctl.next    = state->params;
+
+    size_t n = cfg->frame_len;
+    size_t ola_len;
+
+    if (cfg->precision == FE_PRECISION_F32) {
+        /* Windows designed in place; twiddles are exact conversions of the
+           Q1.31 ROM tables */
+        float *tab = (float *)(base + slay.tab_f32);
+        state->tab_f32.window    = tab;
+        state->tab_f32.synthesis = tab + n;
+        state->tab_f32.tw_cos    = tab + 2 * n;
+        state->tab_f32.tw_sin    = tab + 2 * n + n / 2;
+        st = window_pair_design(cfg->window, n, fe_analysis_hop(cfg), state->tab_f32.window,
+                                state->tab_f32.synthesis, &ola_len);
+        if (st != FE_OK) return st;
+        for (size_t i = 0; i < n / 2; i++) {
+            state->tab_f32.tw_cos[i] = (float)state->tab->tw_cos[i] * 0x1p-31f;
+            state->tab_f32.tw_sin[i] = (float)state->tab->tw_sin[i] * 0x1p-31f;
+        }
+
+        for (size_t c = 0; c < ch; c++) {
+            fe_channel_f32_t *chan = fe_channel_f32(state, (uint8_t)c);
+            chan->hist = (float *)((uint8_t *)chan + slay.chan_hist);
+            chan->ola  = NULL;
+            chan->fir  = NULL;
+            if (cfg->mode == FE_MODE_LOW_LATENCY) {
+                /* Pass-through until the first primed analysis */
+                chan->fir = (float *)((uint8_t *)chan + slay.chan_fir);
+                chan->fir[0] = 1.0f;
+            } else {
+                chan->ola = (float *)((uint8_t *)chan + slay.chan_ola);
+            }
+            dc_removal_init_f32(&chan->dc, (float)dc_alpha * 0x1p-31f);
+            pre_emphasis_init_f32(&chan->pre, (float)cfg->pre_emphasis_alpha * 0x1p-15f);
+            if (spectral) {
+                ns_bin_f32_t *bins = (ns_bin_f32_t *)(chan + 1);
+                st = noise_suppress_init_f32(&chan->ns, bins, (float *)(bins + n_bins), n_bins);
+                if (st != FE_OK) return st;
+                vad_init(&chan->vad, VAD_DEFAULT_THRESH, VAD_DEFAULT_HANGOVER);
+            }
+        }
+        return FE_OK;
+    }
+
+    /* Design the pair in float (analysis in scratch, synthesis in its own
+       slot), store Q1.15 analysis and Q1.31 synthesis, the latter
+       converted in place */
+    state->win.analysis  = (q15_t *)(base + slay.win);
+    state->win.synthesis = (q31_t *)(base + slay.win + n * sizeof(q15_t));
+    float *ana = state->work.re_f32;
+    float *syn = (float *)state->win.synthesis;
+    st = window_pair_design(cfg->window, n, cfg->hop_len, ana, syn, &ola_len);
+    if (st != FE_OK) return st;
+    for (size_t i = 0; i < n; i++) {
+        float a = ana[i] * 32768.0f + 0.5f;
+        double y = (double)syn[i] * 2147483648.0 + 0.5;
+        state->win.analysis[i]  = (q15_t)(a >= 32767.0f ? 32767.0f : a);
+        state->win.synthesis[i] = (q31_t)(y >= 2147483647.0 ? 2147483647.0 : y);
+    }
+
+    for (size_t c = 0; c < ch; c++) {
+        fe_channel_t *chan = fe_channel(state, (uint8_t)c);
+        chan->hist = (q15_t *)((uint8_t *)chan + slay.chan_hist);
+        chan->ola  = (q31_t *)((uint8_t *)chan + slay.chan_ola);
+        dc_removal_init(&chan->dc, dc_alpha);
+        pre_emphasis_init(&chan->pre, cfg->pre_emphasis_alpha);
+        if (spectral) {
+            ns_bin_t *bins = (ns_bin_t *)(chan + 1);
+            st = noise_suppress_init(&chan->ns, bins, (q31_t *)(bins + n_bins), n_bins);
+            if (st != FE_OK) return st;
+            vad_init(&chan->vad, VAD_DEFAULT_THRESH, VAD_DEFAULT_HANGOVER);
+        }
+    }
+
+    return FE_OK;
+}
+
+size_t fe_resample_max_out(const fe_state_t *state, size_t n_in)
+{
+    if (state == NULL) return 0;
+    if (state->resample_block == NULL) return n_in;
+    return resample_max_out(&state->resample_bank, n_in);
+}
+
+size_t fe_resample_input(fe_state_t *state, const q15_t *pcm_in, size_t n_in, q15_t *pcm_out)
+{
+    if (state == NULL || pcm_in == NULL || pcm_out == NULL) return 0;
+
+    const uint8_t num_channels = state->num_channels;
+    if (state->resample_block == NULL) {
+        memcpy(pcm_out, pcm_in, n_in * num_channels * sizeof(q15_t));
+        return n_in;
+    }
+
+    /* Channels share the bank and advance in lock-step, so every channel
+       yields the same count */
+    size_t n_out = 0;
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        n_out = resample_process(&state->resample_block[ch],
+                                 pcm_in + ch, n_in, num_channels,
+                                 pcm_out + ch, num_channels);
+    }
+    return n_out;
+}
+
+uint16_t fe_latency(const fe_state_t *state)
+{
+    if (state == NULL || state->mode == FE_MODE_LOW_LATENCY) return 0;
+    return (uint16_t)(state->ola_len - state->hop_len);
+}
+
+static inline const vad_state_t *fe_chan_vad(const fe_state_t *state, uint8_t ch)
+{
+    return (state->precision == FE_PRECISION_F32) ? &fe_channel_f32(state, ch)->vad
+                                                  : &fe_channel(state, ch)->vad;
+}
+
+uint8_t fe_vad_status(const fe_state_t *state, uint8_t ch, q15_t *prob_q15)
+{
+    if (prob_q15) *prob_q15 = 0;
+    if (state == NULL) return 0;
+
+    if (ch == FE_VAD_ANY_CHANNEL) {
+        if (prob_q15) {
+            q15_t max_prob = 0;
+            for (uint8_t c = 0; c < state->num_channels; c++) {
+                q15_t p = fe_chan_vad(state, c)->prob_q15;
+                if (p > max_prob) max_prob = p;
+            }
+            *prob_q15 = max_prob;
+        }
+        return state->vad_speech;
+    }
+
+    if (ch >= state->num_channels) return 0;
+    const vad_state_t *vad = fe_chan_vad(state, ch);
+    if (prob_q15) *prob_q15 = vad->prob_q15;
+    return vad->is_speech;
+}
+
 /* Helper to compute magnitude spectrum from complex FFT output */
 static inline q31_t magnitude_q31(q31_t re, q31_t im)
 {
@@ -19,124 +474,745 @@ static inline q31_t magnitude_q31(q31_t re, q31_t im)
     return max_val + (min_val >> 1);
 }
 
-fe_status_t fe_process_hop(fe_state_t *state, const q15_t *pcm_in, q15_t *pcm_out, void *feature_out, size_t feature_sz)
+/* ── Runtime parameters ─────────────────────────────────────────────────────
+ *
+ * One published set in `ctl.next` behind a sequence count (a seqlock): a
+ * writer claims it by moving seq from even to odd, stores the fields and
+ * releases it at the next even value. The audio thread never waits: at
+ * each hop boundary it compares seq with the one it last applied, copies
+ * the fields and keeps the copy only if seq did not move meanwhile; a copy
+ * torn by a concurrent writer is dropped and retried a hop later. The
+ * active set (`params`) and the one it replaced (`params_prev`, the ramp
+ * start) belong to the audio thread. Fields are copied with relaxed atomic
+ * accesses so the race on a torn copy is benign.
+ */
+
+static void fe_params_store(fe_params_t *dst, const fe_params_t *src)
 {
-    uint16_t frame_len = state->frame_len;
+    __atomic_store_n(&dst->flags, src->flags, __ATOMIC_RELAXED);
+    __atomic_store_n(&dst->dc_rm_alpha, src->dc_rm_alpha, __ATOMIC_RELAXED);
+    __atomic_store_n(&dst->pre_emphasis_alpha, src->pre_emphasis_alpha, __ATOMIC_RELAXED);
+    __atomic_store_n(&dst->ns_over_sub, src->ns_over_sub, __ATOMIC_RELAXED);
+    __atomic_store_n(&dst->ns_floor, src->ns_floor, __ATOMIC_RELAXED);
+}
+
+static void fe_params_load(const fe_params_t *src, fe_params_t *dst)
+{
+    memset(dst, 0, sizeof(*dst));
+    dst->flags              = __atomic_load_n(&src->flags, __ATOMIC_RELAXED);
+    dst->dc_rm_alpha        = __atomic_load_n(&src->dc_rm_alpha, __ATOMIC_RELAXED);
+    dst->pre_emphasis_alpha = __atomic_load_n(&src->pre_emphasis_alpha, __ATOMIC_RELAXED);
+    dst->ns_over_sub        = __atomic_load_n(&src->ns_over_sub, __ATOMIC_RELAXED);
+    dst->ns_floor           = __atomic_load_n(&src->ns_floor, __ATOMIC_RELAXED);
+}
+
+/* One attempt at a consistent copy of the published set */
+static uint8_t fe_params_read(const fe_state_t *state, uint32_t *seq, fe_params_t *params)
+{
+    uint32_t s = __atomic_load_n(&state->ctl.seq, __ATOMIC_ACQUIRE);
+    if (s & 1) return 0;
+    fe_params_load(&state->ctl.next, params);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    *seq = s;
+    return __atomic_load_n(&state->ctl.seq, __ATOMIC_RELAXED) == s;
+}
+
+fe_status_t fe_params_set(fe_state_t *state, const fe_params_t *params)
+{
+    if (state == NULL || params == NULL) return FE_ERR_NULL_PTR;
+    /* NS needs its gain scratch and either spectral stage the bins */
+    if ((params->flags & FE_FLAG_NOISE_SUPPRESS) && !(state->flags & FE_FLAG_NOISE_SUPPRESS)) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if ((params->flags & FE_FLAG_VAD) &&
+        !(state->flags & (FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD))) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if (params->dc_rm_alpha < 0 || params->ns_over_sub < 0 || params->ns_floor < 0) {
+        return FE_ERR_BAD_CONFIG;
+    }
+
+    /* Claim: even → odd */
+    uint32_t seq = __atomic_load_n(&state->ctl.seq, __ATOMIC_RELAXED);
+    for (;;) {
+        if (seq & 1) {
+            seq = __atomic_load_n(&state->ctl.seq, __ATOMIC_RELAXED);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&state->ctl.seq, &seq, seq + 1, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            /* An acquire does not order later stores after the odd seq: a
+               reader must never see new fields next to the old even value */
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            break;
+        }
+    }
+    fe_params_store(&state->ctl.next, params);
+    __atomic_store_n(&state->ctl.seq, seq + 2, __ATOMIC_RELEASE);
+    return FE_OK;
+}
+
+fe_status_t fe_params_get(const fe_state_t *state, fe_params_t *params)
+{
+    if (state == NULL || params == NULL) return FE_ERR_NULL_PTR;
+    uint32_t seq;
+    while (!fe_params_read(state, &seq, params)) {
+    }
+    return FE_OK;
+}
+
+/* Audio thread, hop boundary: take up a newly published set */
+static uint8_t fe_params_poll(fe_state_t *state)
+{
+    if (__atomic_load_n(&state->ctl.seq, __ATOMIC_RELAXED) == state->ctl.applied) return 0;
+
+    uint32_t seq;
+    fe_params_t next;
+    if (!fe_params_read(state, &seq, &next)) return 0;   /* mid-update: next hop */
+    state->ctl.applied = seq;
+    state->params_prev = state->params;
+    state->params      = next;
+    return 1;
+}
+
+/* Pre-emphasis off is alpha = 0: y[n] = x[n] */
+static inline q15_t fe_pre_alpha(const fe_params_t *p)
+{
+    return (p->flags & FE_FLAG_PRE_EMPHASIS) ? p->pre_emphasis_alpha : 0;
+}
+
+/* DC removal wet share, Q1.15 with 32768 = 1 */
+static inline int32_t fe_dc_wet(const fe_params_t *p)
+{
+    return (p->flags & FE_FLAG_DC_REMOVAL) ? 32768 : 0;
+}
+
+/* ── Hop stages (fe_hop.h) ──────────────────────────────────────────────────
+ *
+ * One function per stage of the STFT hop, for one channel. Each precision
+ * has its own body below; the public entry points dispatch on it.
+ * fe_process_hop() runs them back to back per channel on the instance's
+ * scratch; the stage pipeline (fe_pipeline.c) runs them on different
+ * threads with one fe_work_t per in-flight channel hop.
+ */
+
+void fe_hop_begin(fe_state_t *state, fe_hop_t *hop)
+{
+    hop->ramp = fe_params_poll(state);
+    hop->ns_over_sub = state->params.ns_over_sub;
+    hop->ns_floor    = state->params.ns_floor;
+
+    /* Hops never straddle the ring end (hop_len divides frame_len); after
+       this hop the oldest sample, i.e. the frame start, is at `head` */
+    hop->pos  = state->hist_pos;
+    hop->head = (uint16_t)((hop->pos + state->hop_len) & (state->frame_len - 1));
+
+    /* Until the history holds a whole frame the analysis sees mostly the
+       zero-filled start-up history; keep it out of the noise floor */
+    uint8_t primed = (state->warmup == 0);
+    uint8_t flags = state->params.flags;
+    hop->spectral = primed && (flags & (FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD));
+    hop->suppress = primed && (flags & FE_FLAG_NOISE_SUPPRESS);
+}
+
+void fe_hop_end(fe_state_t *state, const fe_hop_t *hop)
+{
+    state->hist_pos = hop->head;
+    if (state->warmup > 0) state->warmup--;
+}
+
+/* ── FE_PRECISION_F32 stages ────────────────────────────────────────────────
+ * Same stages and profiling points as the Q1.31 path, in float32. PCM stays
+ * Q1.15 at the API boundary. The FFT input is pre-scaled by 1/N so spectra
+ * match the block-scaled fixed-point units.
+ */
+
+/* Hop after a parameter change, or with DC removal bypassed: coefficients
+   and the DC wet share move linearly from the previous set's values to
+   the new ones over the hop. A bypassed DC filter keeps running so that
+   re-enabling it does not start from a cold state. */
+static void fe_hop_condition_ramp_f32(fe_state_t *state, const fe_hop_t *hop, uint8_t ch,
+                                      const q15_t *pcm_in)
+{
+    fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+    const fe_params_t *from = hop->ramp ? &state->params_prev : &state->params;
+    const fe_params_t *to = &state->params;
+    uint16_t hop_len = state->hop_len;
     uint8_t num_channels = state->num_channels;
+    float *hist = chan->hist + hop->pos;
+    const float inv_hop = 1.0f / (float)hop_len;
+
+    float dc0  = (float)from->dc_rm_alpha * 0x1p-31f, dc1 = (float)to->dc_rm_alpha * 0x1p-31f;
+    float pre0 = (float)fe_pre_alpha(from) * 0x1p-15f, pre1 = (float)fe_pre_alpha(to) * 0x1p-15f;
+    float wet0 = (float)fe_dc_wet(from) * 0x1p-15f, wet1 = (float)fe_dc_wet(to) * 0x1p-15f;
+
+    for (uint16_t n = 0; n < hop_len; n++) {
+        float t = (float)(n + 1) * inv_hop;
+        chan->dc.alpha  = dc0 + (dc1 - dc0) * t;
+        chan->pre.alpha = pre0 + (pre1 - pre0) * t;
+        float wet = wet0 + (wet1 - wet0) * t;
+
+        float x = (float)pcm_in[(size_t)n * num_channels + ch] * 0x1p-15f;
+        x = dc_removal_process_f32(&chan->dc, x) * wet + x * (1.0f - wet);
+        hist[n] = pre_emphasis_process_f32(&chan->pre, x);
+    }
+    chan->dc.alpha  = dc1;
+    chan->pre.alpha = pre1;
+}
+
+static void fe_hop_condition_f32(fe_state_t *state, const fe_hop_t *hop, uint8_t ch,
+                                 const q15_t *pcm_in)
+{
+    if (hop->ramp || !(state->params.flags & FE_FLAG_DC_REMOVAL)) {
+        fe_hop_condition_ramp_f32(state, hop, ch, pcm_in);
+        return;
+    }
+
+    fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+    uint16_t hop_len = state->hop_len;
+    uint8_t num_channels = state->num_channels;
+    float *hist = chan->hist + hop->pos;
+
+    for (uint16_t n = 0; n < hop_len; n++) {
+        float x = (float)pcm_in[(size_t)n * num_channels + ch] * 0x1p-15f;
+        x = dc_removal_process_f32(&chan->dc, x);
+        hist[n] = pre_emphasis_process_f32(&chan->pre, x);
+    }
+}
+
+static void fe_hop_window_f32(const fe_state_t *state, const fe_hop_t *hop, uint8_t ch,
+                              const fe_work_t *work)
+{
+    const float *hist = fe_channel_f32(state, ch)->hist;
+    const float *win = state->tab_f32.window;
+    uint16_t head = hop->head;
+    uint16_t seg = state->frame_len - head;
 
-    /*
-     * Scratch layout (all carved from state->scratch):
-     *   frame_q15 [frame_len]           — Q1.15 frame buffer
-     *   fft_re    [frame_len]           — Q1.31 real part for FFT
-     *   fft_im    [frame_len]           — Q1.31 imaginary part for FFT
-     *   noise_est [n_bins * channels]   — Q1.31 noise estimates (reused fft_im after noise supp)
-     */
-    uint8_t *scratch_ptr = (uint8_t *)state->scratch;
-    q15_t *frame_q15 = (q15_t *)scratch_ptr;
-    scratch_ptr += frame_len * sizeof(q15_t);
-    
-    q31_t *fft_re = (q31_t *)scratch_ptr;
-    scratch_ptr += frame_len * sizeof(q31_t);
-    
-    q31_t *fft_im = (q31_t *)scratch_ptr;
-    scratch_ptr += frame_len * sizeof(q31_t);
-    
-    q31_t *noise_est_scratch = NULL;
-    if (state->flags & FE_FLAG_NOISE_SUPPRESS) {
-        noise_est_scratch = (q31_t *)scratch_ptr;
-    }
-    
+    window_apply_to_f32(win, hist + head, work->frame_f32, seg);
+    window_apply_to_f32(win + seg, hist, work->frame_f32 + seg, head);
+}
+
+static void fe_hop_fft_f32(const fe_state_t *state, const fe_work_t *work)
+{
+    uint16_t frame_len = state->frame_len;
+    const float inv_n = 1.0f / (float)frame_len;
+    float *fft_re = work->re_f32;
+    float *fft_im = work->im_f32;
+
+    for (uint16_t n = 0; n < frame_len; n++) {
+        fft_re[n] = work->frame_f32[n] * inv_n;
+        fft_im[n] = 0.0f;
+    }
+    fft_radix2_f32(fft_re, fft_im, frame_len, state->tab_f32.tw_cos, state->tab_f32.tw_sin);
+}
+
+static uint8_t fe_hop_spectral_f32(fe_state_t *state, uint8_t ch, const fe_work_t *work)
+{
+    fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+    size_t n_bins = state->frame_len / 2 + 1;
+    float *power = work->power_f32;
+
+    noise_suppress_power_f32(work->re_f32, work->im_f32, power, n_bins);
+
+    uint8_t is_speech = vad_process_f32(&chan->vad, power, &chan->ns.bins[0].noise_est,
+                                        NS_BIN_F32_STRIDE, n_bins);
+    noise_suppress_update_f32(&chan->ns, power, n_bins, is_speech, FE_NS_MIN_TRACK_LEN);
+    return is_speech;
+}
+
+/* fe_params_t NS values in float: over-subtraction Q6.9, floor Q1.31 power */
+static inline void fe_ns_params_f32(const fe_hop_t *hop, float *over_sub, float *floor)
+{
+    *over_sub = (float)hop->ns_over_sub * 0x1p-9f;
+    *floor    = (float)hop->ns_floor * 0x1p-31f;
+}
+
+static void fe_hop_gain_f32(fe_state_t *state, const fe_hop_t *hop, uint8_t ch,
+                            const fe_work_t *work)
+{
+    fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+    uint16_t frame_len = state->frame_len;
     size_t n_bins = frame_len / 2 + 1;
+    float *fft_re = work->re_f32;
+    float *fft_im = work->im_f32;
+    float *gain = work->gain_f32;
+    float over_sub, floor;
 
-    for (uint8_t ch = 0; ch < num_channels; ch++) {
-        DCRemoval           *dc  = &state->dc_block[ch];
-        PreEmphasis         *pre = &state->pre_emphasis_block[ch];
-        NoiseSuppress       *ns  = NULL;
-        if (state->flags & FE_FLAG_NOISE_SUPPRESS) {
-            RTAFE_LOG("Noise suppression enabled for channel %d\n", ch);
-            ns = &state->noise_suppress_block[ch];
+    fe_ns_params_f32(hop, &over_sub, &floor);
+    noise_suppress_gain_f32(&chan->ns, work->power_f32, gain, n_bins, over_sub, floor);
+
+    for (size_t k = 0; k < n_bins; k++) {
+        fft_re[k] *= gain[k];
+        fft_im[k] *= gain[k];
+        if (k > 0 && k < n_bins - 1) {
+            fft_re[frame_len - k] *= gain[k];
+            fft_im[frame_len - k] *= gain[k];
         }
+    }
+}
+
+static void fe_hop_synth_f32(fe_state_t *state, uint8_t ch, const fe_work_t *work, q15_t *pcm_out)
+{
+    fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+    uint16_t frame_len = state->frame_len;
+    uint16_t hop_len = state->hop_len;
+    uint16_t ola_len = state->ola_len;
+    uint16_t syn_off = frame_len - ola_len;
+    uint8_t num_channels = state->num_channels;
+    float *fft_re = work->re_f32;
+
+    /* ── Stage 6: iFFT (undoes the 1/N) + weighted overlap-add ─────── */
+    float *ola = chan->ola;
+    ifft_radix2_f32(fft_re, work->im_f32, frame_len, state->tab_f32.tw_cos, state->tab_f32.tw_sin);
+    overlap_add_f32(ola, fft_re + syn_off, state->tab_f32.synthesis + syn_off, ola_len);
+
+    /* Stage 7 (AGC) is not implemented: the overlap-add sum is the output */
+
+    /* Completed hop out, rounded and saturated */
+    for (uint16_t n = 0; n < hop_len; n++) {
+        float y = ola[n] * 32768.0f;
+        y += (y >= 0.0f) ? 0.5f : -0.5f;
+        if (y > 32767.0f) y = 32767.0f;
+        else if (y < -32768.0f) y = -32768.0f;
+        pcm_out[(size_t)n * num_channels + ch] = (q15_t)y;
+    }
+    memmove(ola, ola + hop_len, (size_t)(ola_len - hop_len) * sizeof(float));
+    memset(ola + ola_len - hop_len, 0, hop_len * sizeof(float));
+}
+
+/* ── Fixed-point stages (FE_PRECISION_Q31 / FE_PRECISION_Q15) ───────────────
+ *
+ * Scratch slices (carved at init, see fe_scratch_layout):
+ *   frame_q15 [frame_len]           — Q1.15 frame buffer
+ *   fft_re    [frame_len]           — Q1.31 real part for FFT
+ *   fft_im    [frame_len]           — Q1.31 imaginary part for FFT
+ *   fft_q15   [2 * frame_len]       — Q15 precision: interleaved Q1.15
+ *                                       spectrum over fft_re, no fft_im
+ *   power     [n_bins]              — Q1.31 power spectrum (VAD + NS)
+ *   gain      [n_bins]              — Q6.9 suppression gain
+ *
+ * FE_PRECISION_Q15 runs a 16-bit FFT with block exponents instead of the
+ * fixed 1/N, rescaled into the Q1.31 path's units where it meets the
+ * power spectrum and the overlap-add.
+ */
+
+/* ── Stage 1 & 2: DC removal + pre-emphasis on the new hop ─────────────── */
+/* As fe_hop_condition_ramp_f32: each ramp is from + step * (n + 1), the
+   step carrying 16 fraction bits; the last sample lands on the new value
+   up to that rounding, which the stores after the loop make exact */
+static void fe_hop_condition_ramp(fe_state_t *state, const fe_hop_t *hop, uint8_t ch,
+                                  const q15_t *pcm_in)
+{
+    fe_channel_t *chan = fe_channel(state, ch);
+    DCRemoval    *dc   = &chan->dc;
+    PreEmphasis  *pre  = &chan->pre;
+    q15_t        *hist = chan->hist + hop->pos;
+    const fe_params_t *from = hop->ramp ? &state->params_prev : &state->params;
+    const fe_params_t *to = &state->params;
+    uint16_t hop_len = state->hop_len;
+    uint8_t num_channels = state->num_channels;
+
+    q31_t dc0 = from->dc_rm_alpha, dc1 = to->dc_rm_alpha;
+    q15_t pre0 = fe_pre_alpha(from), pre1 = fe_pre_alpha(to);
+    int32_t wet0 = fe_dc_wet(from), wet1 = fe_dc_wet(to);
+    q63_t dc_step  = (((q63_t)dc1 - dc0) << 16) / hop_len;
+    q63_t pre_step = (((q63_t)pre1 - pre0) << 16) / hop_len;
+    q63_t wet_step = (((q63_t)wet1 - wet0) << 16) / hop_len;
+
+    for (uint16_t n = 0; n < hop_len; n++) {
+        q63_t t = n + 1;
+        dc->alpha      = dc0 + (q31_t)((dc_step * t) >> 16);
+        pre->alpha_q15 = (q15_t)(pre0 + (int32_t)((pre_step * t) >> 16));
+        int32_t wet    = wet0 + (int32_t)((wet_step * t) >> 16);
+
+        q31_t x = ((q31_t)pcm_in[(size_t)n * num_channels + ch]) << 16;
+        q31_t y = dc_removal_process(dc, x);
+        y = x + (q31_t)((((q63_t)y - x) * wet) >> 15);
+        q15_t sample_q15 = (q15_t)(((q63_t)y + (1 << 15)) >> 16);
+        hist[n] = pre_emphasis_process(pre, sample_q15);
+    }
+    dc->alpha      = dc1;
+    pre->alpha_q15 = pre1;
+}
+
+void fe_hop_condition(fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const q15_t *pcm_in)
+{
+    if (state->precision == FE_PRECISION_F32) {
+        fe_hop_condition_f32(state, hop, ch, pcm_in);
+        return;
+    }
+    if (hop->ramp || !(state->params.flags & FE_FLAG_DC_REMOVAL)) {
+        fe_hop_condition_ramp(state, hop, ch, pcm_in);
+        return;
+    }
+
+    fe_channel_t *chan = fe_channel(state, ch);
+    DCRemoval    *dc   = &chan->dc;
+    PreEmphasis  *pre  = &chan->pre;
+    q15_t        *hist = chan->hist + hop->pos;
+    uint16_t hop_len = state->hop_len;
+    uint8_t num_channels = state->num_channels;
+
+    for (uint16_t n = 0; n < hop_len; n++) {
+        size_t idx = (size_t)n * num_channels + ch;
+        q15_t sample = pcm_in[idx];
+
+        /* 1. DC Removal (Q15 → Q31 → process → Q15) */
+        q31_t sample_q31 = ((q31_t)sample) << 16;
+        sample_q31 = dc_removal_process(dc, sample_q31);
+        q15_t sample_q15 = (q15_t)(((q63_t)sample_q31 + (1 << 15)) >> 16);
+
+        /* 2. Pre-emphasis */
+        sample_q15 = pre_emphasis_process(pre, sample_q15);
+
+        /* Into the history ring, overwriting the oldest hop */
+        hist[n] = sample_q15;
+    }
+}
+
+/* ── Stage 3: Analysis window straight out of the ring ─────────────────── */
+void fe_hop_window(const fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const fe_work_t *work)
+{
+    if (state->precision == FE_PRECISION_F32) {
+        fe_hop_window_f32(state, hop, ch, work);
+        return;
+    }
+
+    /* Frame = hist[head..N) ++ hist[0..head), oldest first */
+    const q15_t *hist = fe_channel(state, ch)->hist;
+    const q15_t *win = state->win.analysis;
+    uint16_t head = hop->head;
+    uint16_t seg = state->frame_len - head;
+
+    window_apply_to(win, hist + head, work->frame_q15, seg);
+    window_apply_to(win + seg, hist, work->frame_q15 + seg, head);
+}
+
+/* ── Stage 4: Promote Q1.15 → Q1.31 and run FFT ────────────────────────── */
+int fe_hop_fft(const fe_state_t *state, const fe_work_t *work)
+{
+    if (state->precision == FE_PRECISION_F32) {
+        fe_hop_fft_f32(state, work);
+        return 0;
+    }
+
+    uint16_t frame_len = state->frame_len;
+    const q15_t *frame_q15 = work->frame_q15;
+    const fe_tables_t *tab = state->tab;
 
-        /* ── Stage 1 & 2: DC removal + pre-emphasis (per sample) ───────── */
+    if (state->precision == FE_PRECISION_Q15) {
+        /* Spectrum = X * 2^-fft_exp, Q1.15 */
+        q15_t *spec = work->fft_q15;
         for (uint16_t n = 0; n < frame_len; n++) {
-            uint16_t idx = (uint16_t)(n * num_channels + ch);
-            q15_t sample = pcm_in[idx];
+            spec[2 * n]     = frame_q15[n];
+            spec[2 * n + 1] = 0;
+        }
+        return fft_radix2_q15(spec, frame_len, tab->tw_q15);
+    }
+
+    q31_t *fft_re = work->fft_re;
+    q31_t *fft_im = work->fft_im;
+    for (uint16_t n = 0; n < frame_len; n++) {
+        fft_re[n] = ((q31_t)frame_q15[n]) << 16;   /* Q1.15 → Q1.31 */
+        fft_im[n] = 0;                               /* real input     */
+    }
+
+    /* One shift per stage, always: the spectrum is X / N, which the power
+       and synthesis scaling (frame_log2) already assume */
+    fft_radix2_q31(fft_re, fft_im, frame_len, tab->tw_cos, tab->tw_sin);
+    return 0;
+}
 
-            /* 1. DC Removal (Q15 → Q31 → process → Q15) */
-            q31_t sample_q31 = ((q31_t)sample) << 16;
-            sample_q31 = dc_removal_process(dc, sample_q31);
-            q15_t sample_q15 = (q15_t)((sample_q31 + (1 << 15)) >> 16);
+void fe_hop_fft_batch(const fe_state_t *state, const fe_work_t *work, size_t n,
+                      q31_t *re, q31_t *im, int *fft_exp)
+{
+    if (state->precision != FE_PRECISION_Q31 || FFT_BATCH_MIN_LANES == 0 || n < FFT_BATCH_MIN_LANES) {
+        for (size_t t = 0; t < n; t++) fft_exp[t] = fe_hop_fft(state, &work[t]);
+        return;
+    }
+
+    /* Promote every frame straight into its lane: sample i of hop t at i * n + t */
+    uint16_t frame_len = state->frame_len;
+    for (size_t t = 0; t < n; t++) {
+        const q15_t *frame_q15 = work[t].frame_q15;
+        for (uint16_t i = 0; i < frame_len; i++) re[(size_t)i * n + t] = ((q31_t)frame_q15[i]) << 16;
+        fft_exp[t] = 0;
+    }
+    memset(im, 0, (size_t)frame_len * n * sizeof(q31_t));
 
-            /* 2. Pre-emphasis */
-            sample_q15 = pre_emphasis_process(pre, sample_q15);
+    fft_radix2_q31_batch(re, im, frame_len, n, state->tab->tw_cos, state->tab->tw_sin);
 
-            /* Store into contiguous frame buffer */
-            frame_q15[n] = sample_q15;
+    for (size_t t = 0; t < n; t++) {
+        q31_t *fft_re = work[t].fft_re;
+        q31_t *fft_im = work[t].fft_im;
+        for (uint16_t i = 0; i < frame_len; i++) {
+            fft_re[i] = re[(size_t)i * n + t];
+            fft_im[i] = im[(size_t)i * n + t];
         }
+    }
+}
 
-        /* ── Stage 3: Windowing (whole frame at once) ──────────────────── */
-        window_apply(window_hann_256, frame_q15, frame_len);
+/* ── Stage 5: Spectral processing (VAD + Noise Suppression) ────────────── */
+uint8_t fe_hop_spectral(fe_state_t *state, uint8_t ch, const fe_work_t *work, int fft_exp)
+{
+    if (state->precision == FE_PRECISION_F32) return fe_hop_spectral_f32(state, ch, work);
 
-        /* ── Stage 4: Promote Q1.15 → Q1.31 and run FFT ───────────────── */
-        for (uint16_t n = 0; n < frame_len; n++) {
-            fft_re[n] = ((q31_t)frame_q15[n]) << 16;   /* Q1.15 → Q1.31 */
-            fft_im[n] = 0;                               /* real input     */
-        }
-
-        int fft_shifts = fft_radix2_q31(fft_re, fft_im, frame_len,
-                                         twiddle_cos_256, twiddle_sin_256);
-        (void)fft_shifts; /* TODO: pass to downstream stages for scaling */
-
-        /* ── Stage 5: Spectral processing (Noise Suppression) ────────── */
-        if (state->flags & FE_FLAG_NOISE_SUPPRESS) {
-            /* Allocate gain buffer (reuse fft_im after FFT processing) */
-            q15_t *gain_out = (q15_t *)fft_im; /* n_bins elements, Q6.9 */
-
-            /* Call adaptive noise suppression with minimum tracking */
-            noise_suppress_process(
-                ns,
-                fft_re, fft_im,
-                &state->noise_est[ch * n_bins], /* noise estimate per channel */
-                gain_out,
-                n_bins,
-                (state->flags & FE_FLAG_NOISE_SUPPRESS) ? /* use config defaults */
-                ((q15_t)512) : 0,      /* over_subtract (1.0x = 512 in Q6.9) */
-                ((q15_t)1),            /* floor (minimal threshold) */
-                20                     /* min_track_len: 20 frames ≈ 200ms */
-            );
-
-            /* Apply spectral gain to each bin: X[k] *= Gain[k] */
-            for (size_t k = 0; k < n_bins; k++) {
-                q15_t gain = gain_out[k];  /* Q6.9 */
-
-                /* Multiply complex bin by gain: keep magnitude, preserve phase */
-                /* X_out[k] = X_in[k] * (gain / 512) where 512 ≡ unity in Q6.9 */
-                fft_re[k] = (q31_t)((fft_re[k] * gain) >> 9);
-                fft_im[k] = (q31_t)((fft_im[k] * gain) >> 9);
+    fe_channel_t *chan = fe_channel(state, ch);
+    size_t n_bins = state->frame_len / 2 + 1;
+    q31_t *power = work->power;
+
+    /* Power spectrum once per hop, shared by VAD and suppressor;
+       a Q15 bin is X / N in Q1.31 after << (16 + fft_exp - log2 N) */
+    if (state->precision == FE_PRECISION_Q15) {
+        noise_suppress_power_q15(work->fft_q15, 2 * (16 + fft_exp - state->frame_log2) - 31,
+                                 power, n_bins);
+    } else {
+        noise_suppress_power(work->fft_re, work->fft_im, power, n_bins);
+    }
+
+    /* VAD on last hop's noise estimate, then speech-aware update */
+    uint8_t is_speech = vad_process(&chan->vad, power, &chan->ns.bins[0].noise_est,
+                                    NS_BIN_STRIDE, n_bins);
+    noise_suppress_update(&chan->ns, power, n_bins, is_speech, FE_NS_MIN_TRACK_LEN);
+    return is_speech;
+}
+
+void fe_hop_gain(fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const fe_work_t *work)
+{
+    if (state->precision == FE_PRECISION_F32) {
+        fe_hop_gain_f32(state, hop, ch, work);
+        return;
+    }
+
+    fe_channel_t *chan = fe_channel(state, ch);
+    uint16_t frame_len = state->frame_len;
+    size_t n_bins = frame_len / 2 + 1;
+    q15_t *gain_out = work->gain;
+
+    noise_suppress_gain(&chan->ns, work->power, gain_out, n_bins,
+                        hop->ns_over_sub,      /* over_subtract, Q6.9 */
+                        hop->ns_floor);        /* floor, Q1.31 power */
+
+    /* Apply spectral gain to each bin: X[k] *= Gain[k]
+       Mirror bins N-k get the same gain (real input → Hermitian). */
+    if (state->precision == FE_PRECISION_Q15) {
+        /* Q6.9 gain on Q1.15 bins, saturated */
+        q15_t *spec = work->fft_q15;
+        for (size_t k = 0; k < n_bins; k++) {
+            int32_t gain = gain_out[k];
+            spec[2 * k]     = fx_sat_q15((spec[2 * k] * gain) >> 9);
+            spec[2 * k + 1] = fx_sat_q15((spec[2 * k + 1] * gain) >> 9);
+            if (k > 0 && k < n_bins - 1) {
+                size_t m = 2 * (frame_len - k);
+                spec[m]     = fx_sat_q15((spec[m] * gain) >> 9);
+                spec[m + 1] = fx_sat_q15((spec[m + 1] * gain) >> 9);
             }
-            /* Happy new year - wish this year I can achieve more goals, gain more experience and get promotion with better salary!*/
         }
+    } else {
+        q31_t *fft_re = work->fft_re;
+        q31_t *fft_im = work->fft_im;
+        for (size_t k = 0; k < n_bins; k++) {
+            q15_t gain = gain_out[k];  /* Q6.9 */
 
-        /* ── Stage 6: iFFT + overlap-add (TODO) ──────────────────────── */
-        /* - ifft_radix2_q31(fft_re, fft_im, ...)
-         * - Demote Q1.31 → Q1.15
-         * - Overlap-add into output buffer
-         */
+            /* Multiply complex bin by gain: keep magnitude, preserve phase */
+            /* X_out[k] = X_in[k] * (gain / 512) where 512 ≡ unity in Q6.9 */
+            fft_re[k] = (q31_t)(((q63_t)fft_re[k] * gain) >> 9);
+            fft_im[k] = (q31_t)(((q63_t)fft_im[k] * gain) >> 9);
+            if (k > 0 && k < n_bins - 1) {
+                fft_re[frame_len - k] = (q31_t)(((q63_t)fft_re[frame_len - k] * gain) >> 9);
+                fft_im[frame_len - k] = (q31_t)(((q63_t)fft_im[frame_len - k] * gain) >> 9);
+            }
+        }
+    }
+}
 
-        /* ── Stage 7: AGC (TODO) ──────────────────────────────────────── */
+/* ── Stage 6: iFFT + weighted overlap-add ──────────────────────────────── */
+void fe_hop_synth(fe_state_t *state, uint8_t ch, const fe_work_t *work, int fft_exp, q15_t *pcm_out)
+{
+    if (state->precision == FE_PRECISION_F32) {
+        fe_hop_synth_f32(state, ch, work, pcm_out);
+        return;
+    }
 
-        /* Temporary: copy windowed frame to output for testing */
-        for (uint16_t n = 0; n < frame_len; n++) {
-            uint16_t idx = (uint16_t)(n * num_channels + ch);
-            pcm_out[idx] = frame_q15[n];
+    uint16_t frame_len = state->frame_len;
+    uint16_t hop_len = state->hop_len;
+    uint16_t ola_len = state->ola_len;
+    uint16_t syn_off = frame_len - ola_len;
+    uint8_t num_channels = state->num_channels;
+    const fe_tables_t *tab = state->tab;
+    /* iFFT output is x / N in Q1.31: back to Q1.15 */
+    const int out_shift = 16 - state->frame_log2;
+
+    /* Synthesis window carries the OLA gain; only its support
+       [syn_off, frame_len) is accumulated */
+    q31_t *ola = fe_channel(state, ch)->ola;
+    if (state->precision == FE_PRECISION_Q15) {
+        /* Output = x * 2^(log2 N - both exponents); into the x / N
+           Q1.31 units of the accumulator */
+        q15_t *spec = work->fft_q15;
+        int ifft_exp = ifft_radix2_q15(spec, frame_len, tab->tw_q15);
+        overlap_add_q15(ola, spec + 2 * syn_off, state->win.synthesis + syn_off, ola_len,
+                        fft_exp + ifft_exp + 16 - 2 * state->frame_log2);
+    } else {
+        ifft_radix2_q31(work->fft_re, work->fft_im, frame_len, tab->tw_cos, tab->tw_sin);
+        overlap_add_q31(ola, work->fft_re + syn_off, state->win.synthesis + syn_off, ola_len);
+    }
+
+    /* Stage 7 (AGC) is not implemented: the overlap-add sum is the output */
+
+    /* Completed hop out (Q1.31 → Q1.15, rounded, saturated), tail shifts down */
+    for (uint16_t n = 0; n < hop_len; n++) {
+        q63_t y = ((q63_t)ola[n] + (1 << (out_shift - 1))) >> out_shift;
+        if (y > INT16_MAX) y = INT16_MAX;
+        else if (y < INT16_MIN) y = INT16_MIN;
+        pcm_out[(size_t)n * num_channels + ch] = (q15_t)y;
+    }
+    memmove(ola, ola + hop_len, (size_t)(ola_len - hop_len) * sizeof(q31_t));
+    memset(ola + ola_len - hop_len, 0, hop_len * sizeof(q31_t));
+}
+
+/**
+ * FE_MODE_LOW_LATENCY block (float32): DC removal and pre-emphasis on the
+ * hop_len new samples, which land in the same history ring as in the STFT
+ * path. Whenever the ring has advanced by frame_len / 2 the last frame is
+ * analyzed exactly as above (window, FFT, VAD, NS update) and the gain
+ * vector becomes a minimum-phase FIR; the block's output is the ring run
+ * through the current FIR, so no sample waits for a frame to fill.
+ */
+static fe_status_t fe_process_block_ll_f32(fe_state_t *state, const q15_t *pcm_in, q15_t *pcm_out)
+{
+    uint16_t frame_len = state->frame_len;
+    uint16_t hop_len = state->hop_len;
+    uint16_t mask = frame_len - 1;
+    fe_hop_t hop;
+    fe_hop_begin(state, &hop);
+    uint16_t pos = hop.pos;
+    uint16_t head = hop.head;
+    uint16_t seg = frame_len - head;
+    uint8_t num_channels = state->num_channels;
+    size_t n_bins = frame_len / 2 + 1;
+
+    float *frame  = state->work.frame_f32;
+    float *fft_re = state->work.re_f32;
+    float *fft_im = state->work.im_f32;
+    float *power  = state->work.power_f32;
+    float *gain   = state->work.gain_f32;
+
+    /* Analysis on frame_len / 2 boundaries of the ring, once it is full */
+    const uint8_t analyze = hop.spectral && (head & (frame_len / 2 - 1)) == 0;
+    const uint8_t suppress = analyze && hop.suppress;
+    const float inv_n = 1.0f / (float)frame_len;
+    float over_sub, floor;
+    fe_ns_params_f32(&hop, &over_sub, &floor);
+
+    FE_PROF_DECL();
+
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        fe_channel_f32_t *chan = fe_channel_f32(state, ch);
+        float *hist = chan->hist;
+        float *fir = chan->fir;
+
+        FE_PROF_MARK();
+
+        /* ── Stage 1 & 2: DC removal + pre-emphasis on the new block ───── */
+        fe_hop_condition(state, &hop, ch, pcm_in);
+        FE_PROF_ACC(FE_PROF_DC_PRE);
+
+        if (analyze) {
+            /* ── Stages 3-5: analysis of the last frame, as the STFT path ─ */
+            const float *win = state->tab_f32.window;
+            window_apply_to_f32(win, hist + head, frame, seg);
+            window_apply_to_f32(win + seg, hist, frame + seg, head);
+            FE_PROF_ACC(FE_PROF_WINDOW);
+
+            for (uint16_t n = 0; n < frame_len; n++) {
+                fft_re[n] = frame[n] * inv_n;
+                fft_im[n] = 0.0f;
+            }
+            fft_radix2_f32(fft_re, fft_im, frame_len, state->tab_f32.tw_cos, state->tab_f32.tw_sin);
+            FE_PROF_ACC(FE_PROF_FFT);
+
+            noise_suppress_power_f32(fft_re, fft_im, power, n_bins);
+            uint8_t is_speech = vad_process_f32(&chan->vad, power, &chan->ns.bins[0].noise_est,
+                                                NS_BIN_F32_STRIDE, n_bins);
+            state->vad_speech = (ch == 0) ? is_speech : (state->vad_speech | is_speech);
+            noise_suppress_update_f32(&chan->ns, power, n_bins, is_speech, FE_NS_MIN_TRACK_LEN);
+            FE_PROF_ACC(FE_PROF_SPECTRAL);
+
+            if (suppress) {
+                /* ── Gain vector → minimum-phase FIR (fft_re/im reused) ── */
+                noise_suppress_gain_f32(&chan->ns, power, gain, n_bins, over_sub, floor);
+                minphase_fir_f32(gain, frame_len, fft_re, fft_im, state->tab_f32.tw_cos,
+                                 state->tab_f32.tw_sin, fir, FE_LL_FIR_TAPS);
+                FE_PROF_ACC(FE_PROF_GAIN);
+            }
+        }
+
+        /* ── Output: FIR over the ring, newest sample first ────────────── */
+        for (uint16_t n = 0; n < hop_len; n++) {
+            uint16_t p = (uint16_t)(pos + n);
+            float acc = 0.0f;
+            for (uint16_t k = 0; k < FE_LL_FIR_TAPS; k++) {
+                acc += fir[k] * hist[(p - k) & mask];
+            }
+            float y = acc * 32768.0f;
+            y += (y >= 0.0f) ? 0.5f : -0.5f;
+            if (y > 32767.0f) y = 32767.0f;
+            else if (y < -32768.0f) y = -32768.0f;
+            pcm_out[(size_t)n * num_channels + ch] = (q15_t)y;
         }
+        FE_PROF_ACC(FE_PROF_OUTPUT);
     }
 
-    /* ── Stage 8: Feature extraction (optional) ───────────────────────── */
-    /* if (feature_out) fe_extract_features(state, feature_out, feature_sz); */
+    fe_hop_end(state, &hop);
+    FE_PROF_COMMIT(&state->prof);
+    return FE_OK;
+}
+
+fe_status_t fe_process_hop(fe_state_t *state, const q15_t *pcm_in, q15_t *pcm_out, void *feature_out, size_t feature_sz)
+{
+    if (state == NULL || pcm_in == NULL || pcm_out == NULL) return FE_ERR_NULL_PTR;
+    if (state->mode == FE_MODE_LOW_LATENCY) return fe_process_block_ll_f32(state, pcm_in, pcm_out);
+
+    const fe_work_t *work = &state->work;
+    uint8_t num_channels = state->num_channels;
+    fe_hop_t hop;
+    fe_hop_begin(state, &hop);
+    state->vad_speech = 0;
+
+    FE_PROF_DECL();
+
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        FE_PROF_MARK();
+
+        fe_hop_condition(state, &hop, ch, pcm_in);
+        FE_PROF_ACC(FE_PROF_DC_PRE);
+
+        fe_hop_window(state, &hop, ch, work);
+        FE_PROF_ACC(FE_PROF_WINDOW);
+
+        int fft_exp = fe_hop_fft(state, work);
+        FE_PROF_ACC(FE_PROF_FFT);
+
+        if (hop.spectral) {
+            state->vad_speech |= fe_hop_spectral(state, ch, work, fft_exp);
+            FE_PROF_ACC(FE_PROF_SPECTRAL);
+        }
+
+        if (hop.suppress) {
+            fe_hop_gain(state, &hop, ch, work);
+            FE_PROF_ACC(FE_PROF_GAIN);
+        }
+
+        fe_hop_synth(state, ch, work, fft_exp, pcm_out);
+        FE_PROF_ACC(FE_PROF_OUTPUT);
+    }
+
+    fe_hop_end(state, &hop);
+    FE_PROF_COMMIT(&state->prof);
 
     (void)feature_out;
     (void)feature_sz;
 
     return FE_OK;
-}
\ No newline at end of file
+}
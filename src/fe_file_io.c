@@ -0,0 +1,806 @@
+#include "rtafe/fe_file_io.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+/* fe_file_io.c */
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define FE_AIO_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#define FE_ALIGN(x, a)    (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+#define FE_AIO_LINE       64
+#define FE_AIO_TAG_WRITE  0x100             /**< Completion tag: slot index | direction */
+#define FE_WAV_HEADER     44
+
+/** One block buffer. Output slots encode PCM in place, so raw == pcm. */
+typedef struct {
+    uint8_t     *raw;
+    q15_t       *pcm;
+    uint64_t     off;                       /**< File offset of the block */
+    uint32_t     len;                       /**< Bytes to transfer */
+    uint32_t     done;                      /**< Bytes transferred so far */
+    uint32_t     frames;
+    uint8_t      busy;                      /**< Submitted, completion not handled */
+    uint8_t      complete;
+    struct iovec iov;
+} fe_aio_slot_t;
+
+typedef struct {
+    uint16_t tag;
+    int32_t  res;                           /**< Bytes, or -errno */
+} fe_aio_done_t;
+
+#ifdef FE_AIO_HAVE_URING
+typedef struct {
+    int                  fd;
+    uint32_t            *sq_tail, *sq_mask, *sq_array;
+    uint32_t            *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void                *sq_map, *cq_map;
+    size_t               sq_map_sz, cq_map_sz, sqes_sz;
+    uint32_t             to_submit;
+} fe_uring_t;
+#endif
+
+struct fe_aio {
+    fe_wav_info_t   info;
+    uint32_t        block_frames;
+    uint32_t        frame_bytes;            /**< Input bytes per frame */
+    uint64_t        n_blocks;               /**< Input blocks */
+    uint8_t         depth;
+    uint8_t         backend;
+    int             in_fd;
+    int             out_fd;                 /**< -1 when read-only */
+    fe_aio_slot_t   rd[FE_AIO_MAX_DEPTH];
+    fe_aio_slot_t   wr[FE_AIO_MAX_DEPTH];
+
+    /* I/O thread only */
+    uint64_t        r_sub;                  /**< Input blocks submitted */
+    uint64_t        w_sub;                  /**< Output blocks submitted */
+    uint32_t        in_flight;
+    uint32_t        n_done;
+    fe_aio_done_t   done[2 * FE_AIO_MAX_DEPTH];
+#ifdef FE_AIO_HAVE_URING
+    fe_uring_t      ring;
+#endif
+
+    /* Shared: single writer each, published with release stores */
+    uint64_t        r_ready;                /**< Input blocks decoded (I/O thread) */
+    uint64_t        r_cons;                 /**< Input blocks handed back (caller) */
+    uint64_t        w_head;                 /**< Output blocks committed (caller) */
+    uint64_t        w_done;                 /**< Output blocks on disk, slot free (I/O thread) */
+    uint64_t        out_frames;
+    uint8_t         r_held;                 /**< Caller holds block r_cons */
+    uint8_t         closing;
+    int             status;
+
+    uint64_t        read_stalls, write_stalls, io_idle;
+    uint32_t        max_in_flight;
+
+    pthread_mutex_t lock;                   /**< Sleep/wake only */
+    pthread_cond_t  io_cv;
+    pthread_cond_t  user_cv;
+    pthread_t       thread;
+};
+
+/* ── WAV format ─────────────────────────────────────────────────────────── */
+
+static inline uint32_t rd_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t rd_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void wr_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void wr_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+}
+
+static inline uint8_t fe_wav_bits_ok(uint16_t bits)
+{
+    return bits == 8 || bits == 16 || bits == 24 || bits == 32;
+}
+
+fe_status_t fe_wav_probe(const char *path, fe_wav_info_t *info)
+{
+    if (path == NULL || info == NULL) return FE_ERR_NULL_PTR;
+    memset(info, 0, sizeof(*info));
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return FE_ERR_IO;
+
+    fe_status_t st = FE_ERR_IO;
+    uint8_t hdr[12], ck[8], fmt[16];
+    uint8_t have_fmt = 0;
+    uint64_t pos = 12;
+
+    if (fread(hdr, 1, 12, f) != 12 || memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0) {
+        fclose(f);
+        return FE_ERR_IO;
+    }
+
+    /* Walk the chunks; odd-sized chunks carry a pad byte */
+    while (fread(ck, 1, 8, f) == 8) {
+        uint32_t size = rd_le32(ck + 4);
+        pos += 8;
+
+        if (memcmp(ck, "fmt ", 4) == 0) {
+            if (size < 16 || fread(fmt, 1, 16, f) != 16) break;
+            uint16_t format = rd_le16(fmt);
+            info->num_channels    = rd_le16(fmt + 2);
+            info->sample_rate     = rd_le32(fmt + 4);
+            info->bits_per_sample = rd_le16(fmt + 14);
+            /* WAVE_FORMAT_EXTENSIBLE: PCM sub-format assumed */
+            if (format != 1 && format != 0xFFFE) break;
+            if (info->num_channels == 0 || !fe_wav_bits_ok(info->bits_per_sample)) break;
+            have_fmt = 1;
+        } else if (memcmp(ck, "data", 4) == 0) {
+            if (!have_fmt || fseek(f, 0, SEEK_END) != 0) break;
+            long end = ftell(f);
+            uint64_t avail = (end > 0 && (uint64_t)end > pos) ? (uint64_t)end - pos : 0;
+            /* Streaming writers leave 0 or 0xFFFFFFFF: take the rest of the file */
+            uint64_t bytes = (size == 0 || size == 0xFFFFFFFFu || size > avail) ? avail : size;
+            info->data_offset = pos;
+            info->num_frames  = bytes / ((uint64_t)info->num_channels * (info->bits_per_sample / 8));
+            st = FE_OK;
+            break;
+        }
+
+        pos += (uint64_t)size + (size & 1);
+        if (fseek(f, (long)pos, SEEK_SET) != 0) break;
+    }
+
+    fclose(f);
+    return st;
+}
+
+static void fe_wav_header(uint8_t *h, uint32_t sample_rate, uint16_t ch, uint64_t frames)
+{
+    uint64_t data = frames * ch * 2;
+    if (data > 0xFFFFFFFFu - 36) data = 0xFFFFFFFFu - 36;
+
+    memcpy(h, "RIFF", 4);
+    wr_le32(h + 4, (uint32_t)(36 + data));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    wr_le32(h + 16, 16);
+    wr_le16(h + 20, 1);
+    wr_le16(h + 22, ch);
+    wr_le32(h + 24, sample_rate);
+    wr_le32(h + 28, sample_rate * ch * 2);
+    wr_le16(h + 32, (uint16_t)(ch * 2));
+    wr_le16(h + 34, 16);
+    memcpy(h + 36, "data", 4);
+    wr_le32(h + 40, (uint32_t)data);
+}
+
+static inline q15_t fe_sat16(int32_t v)
+{
+    return (q15_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+/** Little-endian PCM → Q1.15; wider formats rounded to 16 bits. */
+static void fe_wav_decode(const uint8_t *raw, uint16_t bits, size_t n, q15_t *pcm)
+{
+    switch (bits) {
+    case 8:
+        for (size_t i = 0; i < n; i++) pcm[i] = (q15_t)(((int32_t)raw[i] - 128) * 256);
+        break;
+    case 16:
+        for (size_t i = 0; i < n; i++) pcm[i] = (q15_t)rd_le16(raw + 2 * i);
+        break;
+    case 24:
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t *p = raw + 3 * i;
+            int32_t v = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+            pcm[i] = fe_sat16((v + (1 << 7)) >> 8);
+        }
+        break;
+    default:
+        for (size_t i = 0; i < n; i++) {
+            int64_t v = (int32_t)rd_le32(raw + 4 * i);
+            pcm[i] = fe_sat16((int32_t)((v + (1 << 15)) >> 16));
+        }
+        break;
+    }
+}
+
+/** Q1.15 → 16-bit little-endian PCM, in place. */
+static void fe_wav_encode(q15_t *pcm, size_t n)
+{
+    uint8_t *raw = (uint8_t *)pcm;
+    for (size_t i = 0; i < n; i++) wr_le16(raw + 2 * i, (uint16_t)pcm[i]);
+}
+
+/* ── io_uring backend (raw syscalls) ────────────────────────────────────── */
+
+#ifdef FE_AIO_HAVE_URING
+static int fe_uring_init(fe_uring_t *r, uint32_t entries)
+{
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(r, 0, sizeof(*r));
+    r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (r->fd < 0) return -1;
+
+    r->sq_map_sz = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    r->cq_map_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (r->cq_map_sz > r->sq_map_sz) r->sq_map_sz = r->cq_map_sz;
+        r->cq_map_sz = r->sq_map_sz;
+    }
+
+    r->sq_map = mmap(NULL, r->sq_map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_map == MAP_FAILED) goto fail;
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        r->cq_map = r->sq_map;
+    } else {
+        r->cq_map = mmap(NULL, r->cq_map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         r->fd, IORING_OFF_CQ_RING);
+        if (r->cq_map == MAP_FAILED) goto fail_sq;
+    }
+    r->sqes_sz = p.sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = mmap(NULL, r->sqes_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   r->fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED) goto fail_cq;
+
+    uint8_t *sq = (uint8_t *)r->sq_map, *cq = (uint8_t *)r->cq_map;
+    r->sq_tail  = (uint32_t *)(sq + p.sq_off.tail);
+    r->sq_mask  = (uint32_t *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (uint32_t *)(sq + p.sq_off.array);
+    r->cq_head  = (uint32_t *)(cq + p.cq_off.head);
+    r->cq_tail  = (uint32_t *)(cq + p.cq_off.tail);
+    r->cq_mask  = (uint32_t *)(cq + p.cq_off.ring_mask);
+    r->cqes     = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return 0;
+
+fail_cq:
+    if (r->cq_map != r->sq_map) munmap(r->cq_map, r->cq_map_sz);
+fail_sq:
+    munmap(r->sq_map, r->sq_map_sz);
+fail:
+    close(r->fd);
+    return -1;
+}
+
+static void fe_uring_free(fe_uring_t *r)
+{
+    munmap(r->sqes, r->sqes_sz);
+    if (r->cq_map != r->sq_map) munmap(r->cq_map, r->cq_map_sz);
+    munmap(r->sq_map, r->sq_map_sz);
+    close(r->fd);
+}
+
+/* Queue one READV/WRITEV (Linux 5.1); io_uring_enter() in fe_uring_reap submits */
+static void fe_uring_push(fe_uring_t *r, int fd, uint16_t tag, const struct iovec *iov,
+                          uint64_t off, uint8_t write)
+{
+    uint32_t tail = *r->sq_tail;            /* this thread is the only producer */
+    uint32_t idx  = tail & *r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[idx];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd        = fd;
+    sqe->addr      = (uint64_t)(uintptr_t)iov;
+    sqe->len       = 1;
+    sqe->off       = off;
+    sqe->user_data = tag;
+    r->sq_array[idx] = idx;
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    r->to_submit++;
+}
+#endif
+
+/* ── I/O thread ─────────────────────────────────────────────────────────── */
+
+static inline void fe_aio_wake(fe_aio_t *a, pthread_cond_t *cv)
+{
+    pthread_mutex_lock(&a->lock);
+    pthread_cond_broadcast(cv);
+    pthread_mutex_unlock(&a->lock);
+}
+
+static inline fe_aio_slot_t *fe_aio_tag_slot(fe_aio_t *a, uint16_t tag)
+{
+    return (tag & FE_AIO_TAG_WRITE) ? &a->wr[tag & 0xFF] : &a->rd[tag & 0xFF];
+}
+
+static void fe_aio_fail(fe_aio_t *a)
+{
+    int expected = FE_OK;
+    __atomic_compare_exchange_n(&a->status, &expected, FE_ERR_IO, 0,
+                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline void fe_aio_push_done(fe_aio_t *a, uint16_t tag, int32_t res)
+{
+    a->done[a->n_done].tag = tag;
+    a->done[a->n_done].res = res;
+    a->n_done++;
+}
+
+/* Issue (the rest of) a slot's transfer. The thread backend completes it
+   on the spot; either way the completion lands in a->done. */
+static void fe_aio_submit(fe_aio_t *a, uint16_t tag)
+{
+    fe_aio_slot_t *s = fe_aio_tag_slot(a, tag);
+    uint8_t write = (tag & FE_AIO_TAG_WRITE) != 0;
+    int fd = write ? a->out_fd : a->in_fd;
+
+    s->busy = 1;
+    if (++a->in_flight > a->max_in_flight) {
+        __atomic_store_n(&a->max_in_flight, a->in_flight, __ATOMIC_RELAXED);
+    }
+    if (__atomic_load_n(&a->status, __ATOMIC_RELAXED) != FE_OK) {
+        fe_aio_push_done(a, tag, -ECANCELED);
+        return;
+    }
+
+    s->iov.iov_base = s->raw + s->done;
+    s->iov.iov_len  = s->len - s->done;
+#ifdef FE_AIO_HAVE_URING
+    if (a->backend == FE_AIO_IO_URING) {
+        fe_uring_push(&a->ring, fd, tag, &s->iov, s->off + s->done, write);
+        return;
+    }
+#endif
+    ssize_t r = write ? pwrite(fd, s->iov.iov_base, s->iov.iov_len, (off_t)(s->off + s->done))
+                      : pread(fd, s->iov.iov_base, s->iov.iov_len, (off_t)(s->off + s->done));
+    fe_aio_push_done(a, tag, r < 0 ? -errno : (int32_t)r);
+}
+
+/* Wait for at least one io_uring completion and move them to a->done */
+#ifdef FE_AIO_HAVE_URING
+static void fe_uring_reap(fe_aio_t *a)
+{
+    fe_uring_t *r = &a->ring;
+    for (;;) {
+        int ret = (int)syscall(__NR_io_uring_enter, r->fd, r->to_submit, 1,
+                               IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret >= 0) {
+            r->to_submit -= (uint32_t)ret;
+            break;
+        }
+        if (errno == EINTR) continue;
+
+        /* Ring unusable: fail every outstanding transfer */
+        fe_aio_fail(a);
+        for (int i = 0; i < a->depth; i++) {
+            if (a->rd[i].busy) fe_aio_push_done(a, (uint16_t)i, -EIO);
+            if (a->wr[i].busy) fe_aio_push_done(a, (uint16_t)(i | FE_AIO_TAG_WRITE), -EIO);
+        }
+        return;
+    }
+
+    uint32_t head = *r->cq_head;
+    uint32_t tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];
+        fe_aio_push_done(a, (uint16_t)cqe->user_data, cqe->res);
+        head++;
+    }
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+}
+#endif
+
+/* Handle one completion: resubmit a short transfer, otherwise retire the
+   slot and publish every leading completed block in file order */
+static void fe_aio_complete(fe_aio_t *a, uint16_t tag, int32_t res)
+{
+    fe_aio_slot_t *s = fe_aio_tag_slot(a, tag);
+    uint8_t write = (tag & FE_AIO_TAG_WRITE) != 0;
+
+    a->in_flight--;
+    s->busy = 0;
+    if (res < 0) {
+        if (res != -ECANCELED) fe_aio_fail(a);
+    } else {
+        s->done += (uint32_t)res;
+        if (res > 0 && s->done < s->len) {
+            fe_aio_submit(a, tag);
+            return;
+        }
+        if (res == 0 && s->done < s->len) {
+            if (write) fe_aio_fail(a);
+            else s->frames = s->done / a->frame_bytes;   /* file shorter than its header */
+        }
+    }
+    s->complete = 1;
+
+    uint8_t ok = __atomic_load_n(&a->status, __ATOMIC_RELAXED) == FE_OK;
+    if (write) {
+        uint64_t w = a->w_done;
+        while (w < a->w_sub && a->wr[w % a->depth].complete) {
+            fe_aio_slot_t *ws = &a->wr[w % a->depth];
+            ws->complete = 0;
+            if (ok) __atomic_add_fetch(&a->out_frames, ws->frames, __ATOMIC_RELAXED);
+            w++;
+        }
+        __atomic_store_n(&a->w_done, w, __ATOMIC_RELEASE);
+    } else if (ok) {
+        uint64_t r = a->r_ready;
+        while (r < a->r_sub && a->rd[r % a->depth].complete) {
+            fe_aio_slot_t *rs = &a->rd[r % a->depth];
+            fe_wav_decode(rs->raw, a->info.bits_per_sample,
+                          (size_t)rs->frames * a->info.num_channels, rs->pcm);
+            rs->complete = 0;
+            r++;
+        }
+        __atomic_store_n(&a->r_ready, r, __ATOMIC_RELEASE);
+    }
+    fe_aio_wake(a, &a->user_cv);
+}
+
+static void fe_aio_queue_write(fe_aio_t *a)
+{
+    uint8_t i = (uint8_t)(a->w_sub % a->depth);
+    fe_aio_slot_t *s = &a->wr[i];
+    size_t n = (size_t)s->frames * a->info.num_channels;
+
+    fe_wav_encode(s->pcm, n);
+    s->off  = FE_WAV_HEADER + a->w_sub * (uint64_t)a->block_frames * a->info.num_channels * 2;
+    s->len  = (uint32_t)(n * 2);
+    s->done = 0;
+    a->w_sub++;
+    fe_aio_submit(a, (uint16_t)(i | FE_AIO_TAG_WRITE));
+}
+
+static void fe_aio_queue_read(fe_aio_t *a)
+{
+    uint8_t i = (uint8_t)(a->r_sub % a->depth);
+    fe_aio_slot_t *s = &a->rd[i];
+    uint64_t first = a->r_sub * a->block_frames;
+    uint64_t left  = a->info.num_frames - first;
+
+    s->frames = (uint32_t)(left < a->block_frames ? left : a->block_frames);
+    s->off    = a->info.data_offset + first * a->frame_bytes;
+    s->len    = s->frames * a->frame_bytes;
+    s->done   = 0;
+    a->r_sub++;
+    fe_aio_submit(a, (uint16_t)i);
+}
+
+static inline uint8_t fe_aio_can_read(const fe_aio_t *a, uint8_t closing)
+{
+    return !closing && a->r_sub < a->n_blocks &&
+           a->r_sub - __atomic_load_n(&a->r_cons, __ATOMIC_ACQUIRE) < a->depth &&
+           __atomic_load_n(&a->status, __ATOMIC_RELAXED) == FE_OK;
+}
+
+static void *fe_aio_main(void *arg)
+{
+    fe_aio_t *a = (fe_aio_t *)arg;
+
+    for (;;) {
+        uint8_t closing = __atomic_load_n(&a->closing, __ATOMIC_ACQUIRE);
+
+        /* Output first: it frees the slots a blocked caller waits on */
+        while (a->w_sub < __atomic_load_n(&a->w_head, __ATOMIC_ACQUIRE)) fe_aio_queue_write(a);
+        while (fe_aio_can_read(a, closing)) fe_aio_queue_read(a);
+
+        if (a->in_flight > 0) {
+#ifdef FE_AIO_HAVE_URING
+            if (a->n_done == 0 && a->backend == FE_AIO_IO_URING) fe_uring_reap(a);
+#endif
+            while (a->n_done > 0) {
+                fe_aio_done_t d = a->done[--a->n_done];
+                fe_aio_complete(a, d.tag, d.res);
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&a->lock);
+        uint64_t w_head = __atomic_load_n(&a->w_head, __ATOMIC_ACQUIRE);
+        closing = __atomic_load_n(&a->closing, __ATOMIC_ACQUIRE);
+        if (closing && a->w_sub == w_head) {
+            pthread_mutex_unlock(&a->lock);
+            break;
+        }
+        if (a->w_sub == w_head && !fe_aio_can_read(a, closing)) {
+            __atomic_add_fetch(&a->io_idle, 1, __ATOMIC_RELAXED);
+            pthread_cond_wait(&a->io_cv, &a->lock);
+        }
+        pthread_mutex_unlock(&a->lock);
+    }
+
+    fe_aio_wake(a, &a->user_cv);
+    return NULL;
+}
+
+/* ── Arena layout ───────────────────────────────────────────────────────── */
+
+typedef struct {
+    size_t rd_raw, rd_pcm, wr_pcm;          /**< Per-slot strides */
+    size_t rd, wr;                          /**< Offsets of the slot arrays */
+    size_t total;
+} fe_aio_layout_t;
+
+static void fe_aio_resolve(const fe_aio_config_t *cfg, fe_aio_config_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (cfg != NULL) *out = *cfg;
+    if (out->block_frames == 0) out->block_frames = FE_AIO_DEFAULT_BLOCK;
+    if (out->depth == 0) out->depth = FE_AIO_DEFAULT_DEPTH;
+}
+
+static fe_status_t fe_aio_check(const fe_aio_config_t *cfg, const fe_wav_info_t *info)
+{
+    if (info == NULL) return FE_ERR_NULL_PTR;
+    if (info->num_channels == 0 || !fe_wav_bits_ok(info->bits_per_sample)) return FE_ERR_BAD_CONFIG;
+    if (cfg->depth > FE_AIO_MAX_DEPTH || cfg->backend > FE_AIO_THREAD) return FE_ERR_BAD_CONFIG;
+    /* Transfers are tracked in 32-bit byte counts */
+    if ((uint64_t)cfg->block_frames * info->num_channels * 4 > INT32_MAX) return FE_ERR_BAD_CONFIG;
+    return FE_OK;
+}
+
+static void fe_aio_layout(const fe_aio_config_t *cfg, const fe_wav_info_t *info, fe_aio_layout_t *lay)
+{
+    size_t samples = (size_t)cfg->block_frames * info->num_channels;
+    size_t cur = FE_ALIGN(sizeof(fe_aio_t), FE_AIO_LINE);
+
+    lay->rd_raw = FE_ALIGN(samples * (info->bits_per_sample / 8), FE_AIO_LINE);
+    lay->rd_pcm = FE_ALIGN(samples * sizeof(q15_t), FE_AIO_LINE);
+    lay->wr_pcm = lay->rd_pcm;
+    lay->rd     = cur;
+    cur += (size_t)cfg->depth * (lay->rd_raw + lay->rd_pcm);
+    lay->wr     = cur;
+    cur += (size_t)cfg->depth * lay->wr_pcm;
+
+    /* Slack to align the caller's block */
+    lay->total = cur + (FE_AIO_LINE - 1);
+}
+
+size_t fe_aio_bytes(const fe_aio_config_t *cfg, const fe_wav_info_t *info)
+{
+    fe_aio_config_t c;
+    fe_aio_resolve(cfg, &c);
+    if (fe_aio_check(&c, info) != FE_OK) return 0;
+
+    fe_aio_layout_t lay;
+    fe_aio_layout(&c, info, &lay);
+    return lay.total;
+}
+
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+fe_status_t fe_aio_open(void *mem, size_t mem_sz, const fe_aio_config_t *cfg,
+                        const char *in_path, const fe_wav_info_t *info,
+                        const char *out_path, fe_aio_t **aio_out)
+{
+    fe_aio_config_t c;
+    fe_aio_resolve(cfg, &c);
+    fe_status_t st = fe_aio_check(&c, info);
+    if (st != FE_OK) return st;
+    if (mem == NULL || in_path == NULL || aio_out == NULL) return FE_ERR_NULL_PTR;
+
+    fe_aio_layout_t lay;
+    fe_aio_layout(&c, info, &lay);
+    if (mem_sz < lay.total) return FE_ERR_NO_MEM;
+
+    uint8_t *base = (uint8_t *)FE_ALIGN((uintptr_t)mem, FE_AIO_LINE);
+    fe_aio_t *a = (fe_aio_t *)base;
+    memset(a, 0, sizeof(*a));
+    a->info         = *info;
+    a->block_frames = c.block_frames;
+    a->depth        = c.depth;
+    a->frame_bytes  = (uint32_t)info->num_channels * (info->bits_per_sample / 8);
+    a->n_blocks     = (info->num_frames + c.block_frames - 1) / c.block_frames;
+    a->out_fd       = -1;
+    a->status       = FE_OK;
+
+    for (uint8_t i = 0; i < c.depth; i++) {
+        uint8_t *rd = base + lay.rd + (size_t)i * (lay.rd_raw + lay.rd_pcm);
+        a->rd[i].raw = rd;
+        a->rd[i].pcm = (q15_t *)(rd + lay.rd_raw);
+        a->wr[i].pcm = (q15_t *)(base + lay.wr + (size_t)i * lay.wr_pcm);
+        a->wr[i].raw = (uint8_t *)a->wr[i].pcm;
+    }
+
+    a->in_fd = open(in_path, O_RDONLY);
+    if (a->in_fd < 0) return FE_ERR_IO;
+    if (out_path != NULL) {
+        uint8_t h[FE_WAV_HEADER];
+        fe_wav_header(h, info->sample_rate, info->num_channels, 0);
+        a->out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (a->out_fd < 0 || pwrite(a->out_fd, h, sizeof(h), 0) != (ssize_t)sizeof(h)) {
+            if (a->out_fd >= 0) close(a->out_fd);
+            close(a->in_fd);
+            return FE_ERR_IO;
+        }
+    }
+
+    /* Explicit FE_AIO_IO_URING fails where the kernel refuses it; AUTO falls back */
+    a->backend = FE_AIO_THREAD;
+#ifdef FE_AIO_HAVE_URING
+    if (c.backend != FE_AIO_THREAD && fe_uring_init(&a->ring, 2u * c.depth) == 0) {
+        a->backend = FE_AIO_IO_URING;
+    }
+#endif
+    if (c.backend == FE_AIO_IO_URING && a->backend != FE_AIO_IO_URING) {
+        if (a->out_fd >= 0) close(a->out_fd);
+        close(a->in_fd);
+        return FE_ERR_BAD_CONFIG;
+    }
+
+    pthread_mutex_init(&a->lock, NULL);
+    pthread_cond_init(&a->io_cv, NULL);
+    pthread_cond_init(&a->user_cv, NULL);
+    if (pthread_create(&a->thread, NULL, fe_aio_main, a) != 0) {
+#ifdef FE_AIO_HAVE_URING
+        if (a->backend == FE_AIO_IO_URING) fe_uring_free(&a->ring);
+#endif
+        pthread_cond_destroy(&a->user_cv);
+        pthread_cond_destroy(&a->io_cv);
+        pthread_mutex_destroy(&a->lock);
+        if (a->out_fd >= 0) close(a->out_fd);
+        close(a->in_fd);
+        return FE_ERR_NO_MEM;
+    }
+
+    *aio_out = a;
+    return FE_OK;
+}
+
+const q15_t *fe_aio_read(fe_aio_t *a, size_t *n_frames)
+{
+    if (n_frames != NULL) *n_frames = 0;
+    if (a == NULL) return NULL;
+
+    /* Hand the previous block back to the read-ahead */
+    if (a->r_held) {
+        a->r_held = 0;
+        __atomic_store_n(&a->r_cons, a->r_cons + 1, __ATOMIC_RELEASE);
+        fe_aio_wake(a, &a->io_cv);
+    }
+
+    uint64_t c = a->r_cons;
+    if (c >= a->n_blocks) return NULL;
+    if (__atomic_load_n(&a->r_ready, __ATOMIC_ACQUIRE) <= c) {
+        __atomic_add_fetch(&a->read_stalls, 1, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&a->lock);
+        while (__atomic_load_n(&a->r_ready, __ATOMIC_ACQUIRE) <= c &&
+               __atomic_load_n(&a->status, __ATOMIC_RELAXED) == FE_OK) {
+            pthread_cond_wait(&a->user_cv, &a->lock);
+        }
+        pthread_mutex_unlock(&a->lock);
+        if (__atomic_load_n(&a->r_ready, __ATOMIC_ACQUIRE) <= c) return NULL;
+    }
+
+    const fe_aio_slot_t *s = &a->rd[c % a->depth];
+    a->r_held = 1;
+    if (n_frames != NULL) *n_frames = s->frames;
+    return s->pcm;
+}
+
+q15_t *fe_aio_write_slot(fe_aio_t *a)
+{
+    if (a == NULL || a->out_fd < 0) return NULL;
+
+    uint64_t h = a->w_head;
+    if (h - __atomic_load_n(&a->w_done, __ATOMIC_ACQUIRE) >= a->depth) {
+        __atomic_add_fetch(&a->write_stalls, 1, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&a->lock);
+        while (h - __atomic_load_n(&a->w_done, __ATOMIC_ACQUIRE) >= a->depth) {
+            pthread_cond_wait(&a->user_cv, &a->lock);
+        }
+        pthread_mutex_unlock(&a->lock);
+    }
+    return a->wr[h % a->depth].pcm;
+}
+
+fe_status_t fe_aio_write_commit(fe_aio_t *a, size_t n_frames)
+{
+    if (a == NULL) return FE_ERR_NULL_PTR;
+    if (a->out_fd < 0 || n_frames > a->block_frames) return FE_ERR_BAD_CONFIG;
+
+    uint64_t h = a->w_head;
+    if (h - __atomic_load_n(&a->w_done, __ATOMIC_ACQUIRE) >= a->depth) return FE_ERR_BUSY;
+
+    a->wr[h % a->depth].frames = (uint32_t)n_frames;
+    __atomic_store_n(&a->w_head, h + 1, __ATOMIC_RELEASE);
+    fe_aio_wake(a, &a->io_cv);
+    return (fe_status_t)__atomic_load_n(&a->status, __ATOMIC_RELAXED);
+}
+
+void fe_aio_stats(const fe_aio_t *a, fe_aio_stats_t *stats)
+{
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof(*stats));
+    if (a == NULL) return;
+
+    uint64_t r_ready = __atomic_load_n(&a->r_ready, __ATOMIC_ACQUIRE);
+    uint64_t r_cons  = __atomic_load_n(&a->r_cons, __ATOMIC_ACQUIRE);
+    uint64_t w_head  = __atomic_load_n(&a->w_head, __ATOMIC_ACQUIRE);
+    uint64_t w_done  = __atomic_load_n(&a->w_done, __ATOMIC_ACQUIRE);
+
+    stats->backend        = a->backend;
+    stats->depth          = a->depth;
+    stats->read_ready     = (uint32_t)(r_ready > r_cons ? r_ready - r_cons : 0);
+    stats->write_pending  = (uint32_t)(w_head - w_done);
+    stats->max_in_flight  = __atomic_load_n(&a->max_in_flight, __ATOMIC_RELAXED);
+    stats->blocks_read    = r_ready;
+    stats->blocks_written = w_done;
+    stats->read_stalls    = __atomic_load_n(&a->read_stalls, __ATOMIC_RELAXED);
+    stats->write_stalls   = __atomic_load_n(&a->write_stalls, __ATOMIC_RELAXED);
+    stats->io_idle        = __atomic_load_n(&a->io_idle, __ATOMIC_RELAXED);
+}
+
+fe_status_t fe_aio_close(fe_aio_t *a, fe_aio_stats_t *stats)
+{
+    if (a == NULL) return FE_ERR_NULL_PTR;
+
+    pthread_mutex_lock(&a->lock);
+    __atomic_store_n(&a->closing, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&a->io_cv);
+    pthread_mutex_unlock(&a->lock);
+    pthread_join(a->thread, NULL);
+
+    if (a->out_fd >= 0) {
+        if (a->status == FE_OK) {
+            uint8_t h[FE_WAV_HEADER];
+            fe_wav_header(h, a->info.sample_rate, a->info.num_channels, a->out_frames);
+            if (pwrite(a->out_fd, h, sizeof(h), 0) != (ssize_t)sizeof(h)) a->status = FE_ERR_IO;
+        }
+        if (close(a->out_fd) != 0) a->status = FE_ERR_IO;
+    }
+    close(a->in_fd);
+#ifdef FE_AIO_HAVE_URING
+    if (a->backend == FE_AIO_IO_URING) fe_uring_free(&a->ring);
+#endif
+
+    fe_aio_stats(a, stats);
+    pthread_cond_destroy(&a->user_cv);
+    pthread_cond_destroy(&a->io_cv);
+    pthread_mutex_destroy(&a->lock);
+    return (fe_status_t)a->status;
+}
+
+fe_status_t fe_aio_read_all(const char *path, const fe_aio_config_t *cfg,
+                            const fe_wav_info_t *info, q15_t *pcm, fe_aio_stats_t *stats)
+{
+    if (path == NULL || info == NULL || pcm == NULL) return FE_ERR_NULL_PTR;
+
+    size_t sz = fe_aio_bytes(cfg, info);
+    if (sz == 0) return FE_ERR_BAD_CONFIG;
+    void *mem = malloc(sz);
+    if (mem == NULL) return FE_ERR_NO_MEM;
+
+    fe_aio_t *aio;
+    fe_status_t st = fe_aio_open(mem, sz, cfg, path, info, NULL, &aio);
+    if (st != FE_OK) {
+        free(mem);
+        return st;
+    }
+
+    size_t ch = info->num_channels, pos = 0, n;
+    const q15_t *blk;
+    while ((blk = fe_aio_read(aio, &n)) != NULL) {
+        memcpy(pcm + pos * ch, blk, n * ch * sizeof(q15_t));
+        pos += n;
+    }
+
+    st = fe_aio_close(aio, stats);
+    free(mem);
+    return st;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file fe_hop.h
+ * @brief Stages of the STFT hop, for one channel (engine-internal).
+ *
+ * fe_process_hop() is these stages run back to back for every channel on
+ * the instance's own scratch. The stage pipeline (fe_pipeline.c) runs
+ * them on different threads instead, one channel hop per fe_work_t. Each
+ * stage touches its own part of the channel state, so different stages
+ * may run concurrently on different channels or hops:
+ *
+ *   fe_hop_condition  stages 1-2  dc, pre, hist (at hop->pos)
+ *   fe_hop_window     stage 3     hist (reads)
+ *   fe_hop_fft        stage 4     —
+ *   fe_hop_spectral   stage 5     vad, ns           if hop->spectral
+ *   fe_hop_gain       stage 5     ns (reads)        if hop->suppress
+ *   fe_hop_synth      stage 6     ola (stage 7, AGC, is not implemented)
+ *
+ * Runtime parameters (fe_params_set) are taken up by fe_hop_begin() and
+ * travel with the hop: fe_hop_condition() ramps the conditioning
+ * coefficients across a hop with hop->ramp set, fe_hop_gain() uses the
+ * hop's NS values.
+ *
+ * Between stages a channel's hop is carried entirely by its fe_work_t
+ * slices and the block exponent returned by fe_hop_fft(). Not for
+ * FE_MODE_LOW_LATENCY, which has its own block function.
+ *
+ * fe_hop_fft_batch() is stage 4 for many channel hops at once, of one
+ * instance or of several with the same configuration (the stream pool runs
+ * its streams stage-major through it).
+ */
+#pragma once
+
+#include "rtafe/fe_api.h"
+
+/** Per-hop ring geometry, stage enables and parameters, fixed at the start of the hop. */
+typedef struct {
+    uint16_t pos;             /**< Ring slot of the new hop */
+    uint16_t head;            /**< Frame start (oldest sample) after it */
+    uint8_t  spectral;        /**< Primed, NS or VAD enabled */
+    uint8_t  suppress;        /**< Primed, NS enabled */
+    uint8_t  ramp;            /**< A new parameter set takes effect with this hop */
+    q15_t    ns_over_sub;     /**< fe_params_t NS values for this hop's gain */
+    q31_t    ns_floor;
+} fe_hop_t;
+
+/**
+ * Geometry of the next hop, after taking up any parameter set published
+ * since the last one (fe_params_set). The ring does not advance until
+ * fe_hop_end(); call both on the thread that runs fe_hop_condition().
+ */
+void fe_hop_begin(fe_state_t *state, fe_hop_t *hop);
+
+/** Advance the history ring and warm-up past @p hop. */
+void fe_hop_end(fe_state_t *state, const fe_hop_t *hop);
+
+/** Carve a scratch block of fe_scratch_bytes() into @p work for @p state's configuration. */
+fe_status_t fe_work_bind(const fe_state_t *state, void *scratch, size_t scratch_sz, fe_work_t *work);
+
+void    fe_hop_condition(fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const q15_t *pcm_in);
+void    fe_hop_window(const fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const fe_work_t *work);
+/** @return Block exponent of a FE_PRECISION_Q15 spectrum, 0 otherwise */
+int     fe_hop_fft(const fe_state_t *state, const fe_work_t *work);
+/**
+ * fe_hop_fft() for @p n channel hops, exponents into @p fft_exp[n]. Q31
+ * with at least FFT_BATCH_MIN_LANES hops runs them as one
+ * fft_radix2_q31_batch() over @p re / @p im (lane layout, frame_len * n
+ * each) and leaves every lane in its work's fft_re / fft_im, bit-exact
+ * with fe_hop_fft(); anything else, where batching does not pay, goes one
+ * fe_hop_fft() after the other (@p re / @p im unused, may be NULL).
+ */
+void    fe_hop_fft_batch(const fe_state_t *state, const fe_work_t *work, size_t n,
+                         q31_t *re, q31_t *im, int *fft_exp);
+/** @return Channel VAD decision */
+uint8_t fe_hop_spectral(fe_state_t *state, uint8_t ch, const fe_work_t *work, int fft_exp);
+void    fe_hop_gain(fe_state_t *state, const fe_hop_t *hop, uint8_t ch, const fe_work_t *work);
+/** Writes hop_len samples of channel @p ch into interleaved @p pcm_out. */
+void    fe_hop_synth(fe_state_t *state, uint8_t ch, const fe_work_t *work, int fft_exp, q15_t *pcm_out);
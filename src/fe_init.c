@@ -163,10 +163,66 @@ void fe_process(fe_manager_t *mng)
     }
 }
 
+#ifdef FIXED_POINT
+/**
+ * Convert the whole input buffer to SAMPLING_RATE with the polyphase SRC.
+ * Samples are Q2.14 stored in sample_t; the FIR is linear so the format
+ * passes through unchanged.
+ */
+int _fe_resample_buffer(fe_manager_t *mng, uint32_t fs_in, uint32_t fs_out)
+{
+    uint16_t L, M, taps;
+    if (resample_geometry(fs_in, fs_out, &L, &M, &taps) != FE_OK) return -1;
+
+    uint16_t num_channels = mng->audio_info.num_channels;
+    size_t n_in = mng->config.num_samples;
+
+    resample_bank_t bank;
+    q15_t *coeffs = (q15_t *)malloc((size_t)L * taps * sizeof(q15_t));
+    q15_t *hist = (q15_t *)malloc(2 * (size_t)taps * sizeof(q15_t));
+    if (!coeffs || !hist || resample_bank_init(&bank, fs_in, fs_out, coeffs) != FE_OK) {
+        free(coeffs);
+        free(hist);
+        return -1;
+    }
+
+    size_t n_max = resample_max_out(&bank, n_in);
+    sample_t *out = (sample_t *)malloc(n_max * num_channels * sizeof(sample_t));
+    if (!out) {
+        free(coeffs);
+        free(hist);
+        return -1;
+    }
+
+    size_t n_out = 0;
+    for (uint16_t ch = 0; ch < num_channels; ch++) {
+        resample_state_t rs;
+        resample_init(&rs, &bank, hist);
+        n_out = resample_process(&rs, (const q15_t *)mng->audio_buffer.input_buffer + ch, n_in, num_channels,
+                                 (q15_t *)out + ch, num_channels);
+    }
+
+    free(mng->audio_buffer.input_buffer);
+    mng->audio_buffer.input_buffer = out;
+    mng->config.num_samples = n_out;
+    mng->audio_info.sample_rate = fs_out;
+
+    free(coeffs);
+    free(hist);
+    return 0;
+}
+#endif
+
 void fe_init_buffer(fe_manager_t *mng, const char *filename)
 {
     _wav_to_buffer(filename, mng, &mng->audio_info);
-    if(mng->audio_info.sample_rate != SAMPLING_RATE) {
+    if(mng->audio_info.sample_rate != 0 && mng->audio_info.sample_rate != SAMPLING_RATE) {
+    #ifdef FIXED_POINT
+        uint32_t fs_in = mng->audio_info.sample_rate;
+        if (_fe_resample_buffer(mng, fs_in, (uint32_t)SAMPLING_RATE) == 0) {
+            FE_LOG("Resampled input from %u Hz to %u Hz\n", fs_in, (uint32_t)SAMPLING_RATE);
+        } else
+    #endif
         FE_WARN("Current sampling rate is %u, we expect it to be %f\n", mng->audio_info.sample_rate, SAMPLING_RATE);
     }
     mng->audio_buffer.output_buffer = (sample_t*)malloc(mng->config.num_samples * mng->audio_info.num_channels * sizeof(sample_t));
@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 #include "module/dc_removal.h"
+#include "module/resample.h"
 
 #define BIT_PCM_FORMAT_8 8
 #define BIT_PCM_FORMAT_16 16
@@ -49,4 +50,7 @@ typedef struct fe_manager_t {
 void _wav_to_buffer(const char *filename, fe_manager_t *mng, fe_audio_info_t *info);
 sample_t _fe_process_sample(fe_manager_t *mng, sample_t in);
 void fe_process(fe_manager_t *mng);
+#ifdef FIXED_POINT
+int _fe_resample_buffer(fe_manager_t *mng, uint32_t fs_in, uint32_t fs_out);
+#endif
 void fe_init_buffer(fe_manager_t *mng, const char *filename);
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "rtafe/fe_offline.h"
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+/* fe_offline.c */
+
+#define FE_ALIGN(x, a)  (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+
+/** Chunk geometry; every length in hops of hop_len. */
+typedef struct {
+    uint32_t hop;                           /**< hop_len */
+    uint32_t unit;                          /**< Chunk grid in samples, see fe_offline_unit() */
+    uint32_t latency;                       /**< Streaming delay removed from the output, fe_latency() */
+    uint32_t warm;                          /**< Discarded lead-in per chunk */
+    uint32_t xfade;                         /**< Crossfade before each chunk boundary */
+    uint32_t chunk;
+    uint32_t phase;                         /**< Engine start points are multiples of this */
+    uint32_t n_hops;                        /**< Hops to flush the last input sample out */
+    uint32_t n_chunks;
+    uint8_t  n_workers;
+} fe_offline_plan_t;
+
+typedef struct {
+    size_t workers, state_stride, scratch_stride, io_stride, worker_stride;
+    size_t side, side_stride;
+    size_t total;
+} fe_offline_layout_t;
+
+typedef struct fe_offline_job fe_offline_job_t;
+
+typedef struct {
+    fe_offline_job_t *job;
+    fe_state_t       *state;
+    void             *scratch;
+    q15_t            *io;                   /**< [2 hops] zero-padded tail input, hop output */
+    uint64_t          processed;
+    pthread_t         thread;
+} fe_offline_worker_t;
+
+struct fe_offline_job {
+    const fe_config_t *cfg;
+    fe_offline_plan_t  plan;
+    const q15_t       *pcm_in;
+    q15_t             *pcm_out;
+    size_t             n_samples;
+    uint8_t           *side;                /**< Per-chunk crossfade heads, slice 0 unused */
+    size_t             side_stride;
+    size_t             scratch_sz;
+    uint32_t           next;                /**< Next unclaimed chunk */
+    int                status;              /**< First failing fe_status_t, else FE_OK */
+    fe_offline_worker_t workers[FE_OFFLINE_MAX_WORKERS];
+};
+
+/* ── Planning ───────────────────────────────────────────────────────────── */
+
+/* Chunk starts stay on the analysis grid (every frame_len / 2 samples in
+   low-latency mode), so a chunk sees the same frames as a serial run.
+   Both are powers of two, so the larger is a multiple of the smaller. */
+static uint32_t fe_offline_unit(const fe_config_t *cfg)
+{
+    uint32_t analysis = (cfg->mode == FE_MODE_LOW_LATENCY) ? cfg->frame_len / 2u : cfg->hop_len;
+    return analysis > cfg->hop_len ? analysis : cfg->hop_len;
+}
+
+/* The noise minima slide by a sub-window at a time, counted from the
+   engine's first hop. An engine started on a multiple of the sub-window
+   completes its sub-windows on the same hops as the serial run, so once
+   the warm-up frames have aged out of the window its minima are the
+   serial run's exactly; any other phase leaves a permanent difference. */
+static uint32_t fe_offline_phase(const fe_config_t *cfg)
+{
+    uint32_t subwin = (FE_NS_MIN_TRACK_LEN + NS_SUBWIN_COUNT - 1) / NS_SUBWIN_COUNT;
+    return subwin * (fe_offline_unit(cfg) / cfg->hop_len);
+}
+
+static inline uint64_t fe_round_up(uint64_t x, uint32_t unit)
+{
+    return (x + unit - 1) / unit * unit;
+}
+
+static fe_status_t fe_offline_check(const fe_config_t *cfg)
+{
+    if (cfg == NULL) return FE_ERR_NULL_PTR;
+    if (fe_state_bytes(cfg) == 0) return FE_ERR_BAD_CONFIG;
+    if (cfg->input_rate != 0 && cfg->input_rate != cfg->sample_rate) return FE_ERR_BAD_CONFIG;
+    return FE_OK;
+}
+
+uint32_t fe_offline_default_warmup(const fe_config_t *cfg)
+{
+    if (fe_offline_check(cfg) != FE_OK) return 0;
+
+    uint32_t analysis = (cfg->mode == FE_MODE_LOW_LATENCY) ? cfg->frame_len / 2u : cfg->hop_len;
+    uint64_t warm = (uint64_t)FE_OFFLINE_WARMUP_HOPS * analysis;
+
+    /* DC removal settles to 1% in ~5 time constants of 1 / (1 - alpha) samples */
+    q31_t alpha = cfg->dc_rm_alpha;
+    if (alpha == 0) {
+        uint16_t fc = cfg->dc_rm_cutoff_hz ? cfg->dc_rm_cutoff_hz : FE_DC_DEFAULT_CUTOFF_HZ;
+        alpha = dc_removal_alpha_q31((float)fc, (float)cfg->sample_rate);
+    }
+    if (alpha > 0) {
+        uint64_t tau = (1ULL << 31) / ((1ULL << 31) - (uint64_t)alpha);
+        if (5 * tau > warm) warm = 5 * tau;
+    }
+
+    warm = fe_round_up(warm, fe_offline_unit(cfg));
+    return warm > UINT32_MAX / 2 ? UINT32_MAX / 2 : (uint32_t)warm;
+}
+
+static uint8_t fe_offline_workers(const fe_offline_opts_t *opts)
+{
+    long n = opts->n_workers;
+    if (n == 0) n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    if (n > FE_OFFLINE_MAX_WORKERS) n = FE_OFFLINE_MAX_WORKERS;
+    return (uint8_t)n;
+}
+
+static void fe_offline_plan(const fe_config_t *cfg, const fe_offline_opts_t *opts,
+                            size_t n_samples, fe_offline_plan_t *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->hop     = cfg->hop_len;
+    p->unit    = fe_offline_unit(cfg);
+    p->phase   = fe_offline_phase(cfg);
+
+    uint32_t warm  = opts->warmup_len ? opts->warmup_len : fe_offline_default_warmup(cfg);
+    uint32_t xfade = opts->xfade_len ? opts->xfade_len : FE_OFFLINE_XFADE_HOPS * p->hop;
+    p->warm  = (uint32_t)(fe_round_up(warm, p->unit) / p->hop);
+    p->xfade = (uint32_t)(fe_round_up(xfade, p->hop) / p->hop);
+
+    if (n_samples == 0) {
+        p->n_workers = 1;
+        return;
+    }
+    /* Sized before any engine exists, so flush the longest delay an
+       instance can have (overlap-add over the whole frame); the exact one
+       is read back from worker 0 before processing */
+    p->n_hops = (uint32_t)((n_samples + cfg->frame_len - 1) / p->hop);
+
+    uint8_t workers = fe_offline_workers(opts);
+    uint64_t chunk;
+    if (opts->chunk_len) {
+        chunk = fe_round_up(opts->chunk_len, p->unit) / p->hop;
+    } else {
+        uint64_t even = (p->n_hops + (uint64_t)workers * FE_OFFLINE_CHUNKS_PER_WORKER - 1) /
+                        ((uint64_t)workers * FE_OFFLINE_CHUNKS_PER_WORKER);
+        uint64_t floor = (uint64_t)FE_OFFLINE_MIN_CHUNK_WARMUPS * (p->warm + p->xfade);
+        chunk = fe_round_up(even > floor ? even : floor, p->unit / p->hop);
+    }
+    /* Each boundary's crossfade lies inside the preceding chunk */
+    if (chunk <= p->xfade) chunk = fe_round_up(p->xfade + 1, p->unit / p->hop);
+    if (chunk > p->n_hops) chunk = p->n_hops;
+
+    p->chunk     = (uint32_t)chunk;
+    p->n_chunks  = (p->n_hops + p->chunk - 1) / p->chunk;
+    p->n_workers = workers < p->n_chunks ? workers : (uint8_t)p->n_chunks;
+}
+
+/* ── Arena layout ───────────────────────────────────────────────────────── */
+
+static void fe_offline_layout(const fe_config_t *cfg, const fe_offline_plan_t *p,
+                              fe_offline_layout_t *lay)
+{
+    size_t ch  = cfg->num_channels;
+    size_t cur = FE_ALIGN(sizeof(fe_offline_job_t), FE_CACHE_LINE);
+
+    lay->state_stride   = FE_ALIGN(fe_state_bytes(cfg), FE_CACHE_LINE);
+    lay->scratch_stride = FE_ALIGN(fe_scratch_bytes(cfg), FE_CACHE_LINE);
+    lay->io_stride      = FE_ALIGN(2 * (size_t)p->hop * ch * sizeof(q15_t), FE_CACHE_LINE);
+    lay->worker_stride  = lay->state_stride + lay->scratch_stride + lay->io_stride;
+    lay->workers        = cur;
+    cur += (size_t)p->n_workers * lay->worker_stride;
+    lay->side_stride    = FE_ALIGN((size_t)p->xfade * p->hop * ch * sizeof(q15_t), FE_CACHE_LINE);
+    lay->side           = cur;
+    cur += (size_t)p->n_chunks * lay->side_stride;
+
+    /* Slack to align the caller's block to a cache line */
+    lay->total = cur + (FE_CACHE_LINE - 1);
+}
+
+size_t fe_offline_bytes(const fe_config_t *cfg, const fe_offline_opts_t *opts, size_t n_samples)
+{
+    static const fe_offline_opts_t defaults;
+    if (fe_offline_check(cfg) != FE_OK) return 0;
+
+    fe_offline_plan_t plan;
+    fe_offline_layout_t lay;
+    fe_offline_plan(cfg, opts ? opts : &defaults, n_samples, &plan);
+    fe_offline_layout(cfg, &plan, &lay);
+    return lay.total;
+}
+
+/* ── Chunk processing ───────────────────────────────────────────────────── */
+
+/* Copy the part of output hop j that falls inside the file, latency removed */
+static void fe_offline_place(const fe_offline_job_t *job, const q15_t *hop_out, uint32_t j)
+{
+    const fe_offline_plan_t *p = &job->plan;
+    size_t ch = job->cfg->num_channels;
+    int64_t t0 = (int64_t)j * p->hop - p->latency;
+    int64_t lo = t0 < 0 ? -t0 : 0;
+    int64_t hi = (int64_t)job->n_samples - t0;
+    if (hi > p->hop) hi = p->hop;
+    if (hi <= lo) return;
+
+    memcpy(job->pcm_out + (size_t)(t0 + lo) * ch, hop_out + (size_t)lo * ch,
+           (size_t)(hi - lo) * ch * sizeof(q15_t));
+}
+
+/**
+ * Chunk k owns output hops [h0, h1). A fresh engine starts at least warm
+ * + xfade hops earlier, on the sub-window phase; the warm-up output is dropped, the crossfade hops go to
+ * the chunk's side buffer and the owned hops straight to pcm_out.
+ */
+static fe_status_t fe_offline_chunk(fe_offline_job_t *job, fe_offline_worker_t *w, uint32_t k)
+{
+    const fe_offline_plan_t *p = &job->plan;
+    size_t ch    = job->cfg->num_channels;
+    size_t hop_n = (size_t)p->hop * ch;
+    uint32_t h0  = k * p->chunk;
+    uint32_t h1  = (h0 + p->chunk < p->n_hops) ? h0 + p->chunk : p->n_hops;
+    uint32_t x0  = (k > 0) ? h0 - p->xfade : h0;
+    uint32_t hs  = (x0 > p->warm) ? (x0 - p->warm) / p->phase * p->phase : 0;
+    q15_t *pad   = w->io;
+    q15_t *out   = w->io + hop_n;
+    q15_t *side  = (q15_t *)(job->side + (size_t)k * job->side_stride);
+
+    fe_status_t st = fe_init(job->cfg, w->state, w->scratch, job->scratch_sz);
+    if (st != FE_OK) return st;
+
+    for (uint32_t j = hs; j < h1; j++) {
+        size_t s0 = (size_t)j * p->hop;
+        const q15_t *in = job->pcm_in + s0 * ch;
+        if (s0 + p->hop > job->n_samples) {
+            /* Flush past the end of the file with silence */
+            size_t m = s0 < job->n_samples ? job->n_samples - s0 : 0;
+            memcpy(pad, in, m * ch * sizeof(q15_t));
+            memset(pad + m * ch, 0, (hop_n - m * ch) * sizeof(q15_t));
+            in = pad;
+        }
+
+        st = fe_process_hop(w->state, in, out, NULL, 0);
+        if (st != FE_OK) return st;
+
+        if (j >= h0) {
+            fe_offline_place(job, out, j);
+        } else if (j >= x0) {
+            memcpy(side + (j - x0) * hop_n, out, hop_n * sizeof(q15_t));
+        }
+    }
+    w->processed += (uint64_t)(h1 - hs) * p->hop;
+    return FE_OK;
+}
+
+static void *fe_offline_worker_main(void *arg)
+{
+    fe_offline_worker_t *w = (fe_offline_worker_t *)arg;
+    fe_offline_job_t *job = w->job;
+
+    for (;;) {
+        if (__atomic_load_n(&job->status, __ATOMIC_RELAXED) != FE_OK) break;
+        uint32_t k = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (k >= job->plan.n_chunks) break;
+
+        fe_status_t st = fe_offline_chunk(job, w, k);
+        if (st != FE_OK) {
+            int expected = FE_OK;
+            __atomic_compare_exchange_n(&job->status, &expected, st, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Boundary k: over the xfade hops before h0, ramp linearly from the
+ * previous chunk's output (already in pcm_out) to chunk k's side buffer.
+ */
+static void fe_offline_crossfade(const fe_offline_job_t *job, uint32_t k)
+{
+    const fe_offline_plan_t *p = &job->plan;
+    size_t ch  = job->cfg->num_channels;
+    uint32_t x = p->xfade * p->hop;
+    int64_t t0 = (int64_t)(k * p->chunk - p->xfade) * p->hop - p->latency;
+    const q15_t *side = (const q15_t *)(job->side + (size_t)k * job->side_stride);
+
+    for (uint32_t i = 0; i < x; i++) {
+        int64_t t = t0 + i;
+        if (t < 0 || t >= (int64_t)job->n_samples) continue;
+
+        /* Q15 weight of the new chunk, strictly inside (0, 1) */
+        int32_t wgt = (int32_t)((((uint64_t)i + 1) << 15) / ((uint64_t)x + 1));
+        q15_t *y = job->pcm_out + (size_t)t * ch;
+        for (size_t c = 0; c < ch; c++) {
+            int32_t a = y[c];
+            int32_t d = (int32_t)side[i * ch + c] - a;
+            y[c] = (q15_t)(a + ((d * wgt + (1 << 14)) >> 15));
+        }
+    }
+}
+
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+fe_status_t fe_offline_process(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                               const fe_offline_opts_t *opts,
+                               const q15_t *pcm_in, q15_t *pcm_out, size_t n_samples,
+                               fe_offline_report_t *report)
+{
+    static const fe_offline_opts_t defaults;
+    fe_status_t st = fe_offline_check(cfg);
+    if (st != FE_OK) return st;
+    if (mem == NULL || pcm_in == NULL || pcm_out == NULL) return FE_ERR_NULL_PTR;
+    if (opts == NULL) opts = &defaults;
+
+    fe_offline_plan_t plan;
+    fe_offline_layout_t lay;
+    fe_offline_plan(cfg, opts, n_samples, &plan);
+    fe_offline_layout(cfg, &plan, &lay);
+    if (mem_sz < lay.total) return FE_ERR_NO_MEM;
+
+    uint8_t *base = (uint8_t *)FE_ALIGN((uintptr_t)mem, FE_CACHE_LINE);
+    fe_offline_job_t *job = (fe_offline_job_t *)base;
+    memset(job, 0, sizeof(*job));
+    job->cfg         = cfg;
+    job->plan        = plan;
+    job->pcm_in      = pcm_in;
+    job->pcm_out     = pcm_out;
+    job->n_samples   = n_samples;
+    job->side        = base + lay.side;
+    job->side_stride = lay.side_stride;
+    job->scratch_sz  = lay.scratch_stride;
+    job->status      = FE_OK;
+
+    for (uint8_t i = 0; i < plan.n_workers; i++) {
+        fe_offline_worker_t *w = &job->workers[i];
+        uint8_t *blk = base + lay.workers + (size_t)i * lay.worker_stride;
+        w->job     = job;
+        w->state   = (fe_state_t *)blk;
+        w->scratch = blk + lay.state_stride;
+        w->io      = (q15_t *)(blk + lay.state_stride + lay.scratch_stride);
+    }
+
+    /* Remove the delay the engine itself reports */
+    st = fe_init(cfg, job->workers[0].state, job->workers[0].scratch, job->scratch_sz);
+    if (st != FE_OK) return st;
+    job->plan.latency = fe_latency(job->workers[0].state);
+
+    /* Worker 0 is the calling thread */
+    uint8_t started = 1;
+    while (started < plan.n_workers) {
+        if (pthread_create(&job->workers[started].thread, NULL, fe_offline_worker_main,
+                           &job->workers[started]) != 0) {
+            break;  /* the threads that did start share the chunks */
+        }
+        started++;
+    }
+    if (plan.n_chunks > 0) fe_offline_worker_main(&job->workers[0]);
+    for (uint8_t i = 1; i < started; i++) {
+        pthread_join(job->workers[i].thread, NULL);
+    }
+    if (job->status != FE_OK) return (fe_status_t)job->status;
+
+    for (uint32_t k = 1; k < plan.n_chunks; k++) {
+        fe_offline_crossfade(job, k);
+    }
+
+    if (report != NULL) {
+        memset(report, 0, sizeof(*report));
+        report->warmup_len = plan.warm * plan.hop;
+        report->warmup_ms  = (uint32_t)((uint64_t)report->warmup_len * 1000 / cfg->sample_rate);
+        report->xfade_len  = plan.xfade * plan.hop;
+        report->chunk_len  = plan.chunk * plan.hop;
+        report->n_chunks   = plan.n_chunks;
+        report->n_workers  = started;
+        for (uint8_t i = 0; i < started; i++) report->processed += job->workers[i].processed;
+    }
+    return FE_OK;
+}
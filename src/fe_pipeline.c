@@ -0,0 +1,368 @@
+#include "rtafe/fe_pipeline.h"
+#include "fe_hop.h"
+#include <pthread.h>
+#include <string.h>
+/* fe_pipeline.c */
+
+#define FE_ALIGN(x, a)  (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+
+/*
+ * Work items are channel hops, numbered hop * num_channels + ch in stream
+ * order (mod 2^32). Each stage owns one counter, the number of items it
+ * has finished, and the next stage may take every item below it. Hops alternate between
+ * two slot sets (parity = hop & 1): a channel hop's scratch, block
+ * exponent, geometry, VAD result and output live in its parity's slot
+ * from the front stage until the caller collects the output one call
+ * later, by which time the back stage has retired the hop that used the
+ * slot before.
+ */
+
+/**
+ * Completion counter of one stage. Single writer (the stage), single
+ * waiter (the next stage, or the caller for the back stage); the waiter
+ * sets `sleeping` before blocking and the writer only signals when it is
+ * set. One per cache line.
+ */
+typedef struct {
+    _Alignas(FE_CACHE_LINE) uint32_t done;  /**< Items finished */
+    uint8_t        sleeping;
+    pthread_cond_t cv;
+} fe_pipe_seq_t;
+
+typedef struct {
+    fe_pipeline_t *pipe;
+    pthread_t      thread;
+} fe_pipe_worker_t;
+
+struct fe_pipeline {
+    fe_state_t   *state;
+    uint8_t       num_channels;
+    uint8_t       shutdown;
+    uint8_t       n_workers;                /**< Workers started */
+    uint64_t      hops;                     /**< Hops submitted */
+    size_t        hop_samples;              /**< hop_len * num_channels */
+
+    fe_work_t    *work;                     /**< [2 * num_channels] */
+    int          *exp;                      /**< [2 * num_channels] FE_PRECISION_Q15 block exponents */
+    uint8_t      *speech;                   /**< [2 * num_channels] VAD decision */
+    q15_t        *prob;                     /**< [2 * num_channels] VAD probability */
+    q15_t        *out[2];                   /**< [hop_samples] finished hops */
+    fe_hop_t      hop[2];
+
+    fe_pipe_seq_t front;                    /**< Stages 1-4 (caller) */
+    fe_pipe_seq_t spectral;                 /**< Stage 5 (worker 0) */
+    fe_pipe_seq_t back;                     /**< Stages 6-7 (worker 1) */
+
+    fe_pipe_worker_t workers[FE_PIPELINE_STAGES - 1];
+    pthread_mutex_t  lock;                  /**< Sleep/wake only, never on the hop path */
+};
+
+typedef struct {
+    size_t state, scratch, scratch_stride, work, speech, prob, out;
+    size_t total;
+} fe_pipe_layout_t;
+
+/* ── Arena layout ───────────────────────────────────────────────────────── */
+
+static void fe_pipe_layout(const fe_config_t *cfg, fe_pipe_layout_t *lay)
+{
+    size_t slots = 2 * (size_t)cfg->num_channels;
+    size_t cur = FE_ALIGN(sizeof(struct fe_pipeline), FE_CACHE_LINE);
+
+    /* Slot scratch doubles as the instance's own scratch at init */
+    lay->state          = cur;
+    cur += FE_ALIGN(fe_state_bytes(cfg), FE_CACHE_LINE);
+    lay->scratch_stride = FE_ALIGN(fe_scratch_bytes(cfg), FE_CACHE_LINE);
+    lay->scratch        = cur;
+    cur += slots * lay->scratch_stride;
+    lay->work           = cur;
+    cur += FE_ALIGN(slots * (sizeof(fe_work_t) + sizeof(int)), FE_CACHE_LINE);
+    lay->speech         = cur;
+    cur += FE_ALIGN(slots, FE_CACHE_LINE);
+    lay->prob           = cur;
+    cur += FE_ALIGN(slots * sizeof(q15_t), FE_CACHE_LINE);
+    lay->out            = cur;
+    cur += 2 * FE_ALIGN((size_t)cfg->hop_len * cfg->num_channels * sizeof(q15_t), FE_CACHE_LINE);
+
+    /* Slack to align the caller's block to a cache line */
+    lay->total = cur + (FE_CACHE_LINE - 1);
+}
+
+static fe_status_t fe_pipe_check(const fe_config_t *cfg)
+{
+    if (cfg == NULL) return FE_ERR_NULL_PTR;
+    if (fe_state_bytes(cfg) == 0) return FE_ERR_BAD_CONFIG;
+    if (cfg->mode != FE_MODE_STFT) return FE_ERR_BAD_CONFIG;
+    return FE_OK;
+}
+
+size_t fe_pipeline_bytes(const fe_config_t *cfg)
+{
+    if (fe_pipe_check(cfg) != FE_OK) return 0;
+    fe_pipe_layout_t lay;
+    fe_pipe_layout(cfg, &lay);
+    return lay.total;
+}
+
+/* ── Hand-off ───────────────────────────────────────────────────────────── */
+
+static inline void fe_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield");
+#endif
+}
+
+static inline uint8_t fe_pipe_reached(const fe_pipe_seq_t *q, uint32_t target)
+{
+    return (int32_t)(__atomic_load_n(&q->done, __ATOMIC_SEQ_CST) - target) >= 0;
+}
+
+/** Publish @p done items; wake the waiter only if it went to sleep. */
+static inline void fe_pipe_post(fe_pipeline_t *p, fe_pipe_seq_t *q, uint32_t done)
+{
+    /* seq_cst store/load pair with the waiter's sleeping store/done load:
+       one side always sees the other */
+    __atomic_store_n(&q->done, done, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&q->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&p->lock);
+        pthread_cond_signal(&q->cv);
+        pthread_mutex_unlock(&p->lock);
+    }
+}
+
+/**
+ * Wait until @p q has finished @p target items: poll FE_PIPELINE_SPIN
+ * times, then sleep.
+ * @return 1 once reached, 0 on shutdown
+ */
+static uint8_t fe_pipe_wait(fe_pipeline_t *p, fe_pipe_seq_t *q, uint32_t target)
+{
+    for (uint32_t i = 0; i < FE_PIPELINE_SPIN; i++) {
+        if (fe_pipe_reached(q, target)) return 1;
+        fe_cpu_relax();
+    }
+
+    pthread_mutex_lock(&p->lock);
+    __atomic_store_n(&q->sleeping, 1, __ATOMIC_SEQ_CST);
+    while (!fe_pipe_reached(q, target) && !p->shutdown) {
+        pthread_cond_wait(&q->cv, &p->lock);
+    }
+    __atomic_store_n(&q->sleeping, 0, __ATOMIC_RELAXED);
+    uint8_t ok = fe_pipe_reached(q, target);
+    pthread_mutex_unlock(&p->lock);
+    return ok;
+}
+
+/* ── Stage workers ──────────────────────────────────────────────────────── */
+
+/* Stage 5 on every item the front stage has finished */
+static void *fe_pipe_spectral_main(void *arg)
+{
+    fe_pipeline_t *p = ((fe_pipe_worker_t *)arg)->pipe;
+    fe_state_t *state = p->state;
+    uint8_t n_ch = p->num_channels;
+
+    uint32_t item = 0;
+    uint8_t ch = 0, par = 0;
+
+    while (fe_pipe_wait(p, &p->front, item + 1)) {
+        size_t slot = (size_t)par * n_ch + ch;
+        const fe_hop_t *h = &p->hop[par];
+        uint8_t speech = 0;
+
+        if (h->spectral) speech = fe_hop_spectral(state, ch, &p->work[slot], p->exp[slot]);
+        if (h->suppress) fe_hop_gain(state, h, ch, &p->work[slot]);
+        p->speech[slot] = speech;
+        fe_vad_status(state, ch, &p->prob[slot]);
+
+        fe_pipe_post(p, &p->spectral, ++item);
+        if (++ch == n_ch) {
+            ch = 0;
+            par ^= 1;
+        }
+    }
+    return NULL;
+}
+
+/* Stages 6-7 into the hop's output slot */
+static void *fe_pipe_back_main(void *arg)
+{
+    fe_pipeline_t *p = ((fe_pipe_worker_t *)arg)->pipe;
+    fe_state_t *state = p->state;
+    uint8_t n_ch = p->num_channels;
+
+    uint32_t item = 0;
+    uint8_t ch = 0, par = 0;
+
+    while (fe_pipe_wait(p, &p->spectral, item + 1)) {
+        size_t slot = (size_t)par * n_ch + ch;
+
+        fe_hop_synth(state, ch, &p->work[slot], p->exp[slot], p->out[par]);
+
+        fe_pipe_post(p, &p->back, ++item);
+        if (++ch == n_ch) {
+            ch = 0;
+            par ^= 1;
+        }
+    }
+    return NULL;
+}
+
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+fe_status_t fe_pipeline_init(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                             fe_pipeline_t **pipe_out)
+{
+    fe_status_t st = fe_pipe_check(cfg);
+    if (st != FE_OK) return st;
+    if (mem == NULL || pipe_out == NULL) return FE_ERR_NULL_PTR;
+
+    fe_pipe_layout_t lay;
+    fe_pipe_layout(cfg, &lay);
+    if (mem_sz < lay.total) return FE_ERR_NO_MEM;
+
+    uint8_t *base = (uint8_t *)FE_ALIGN((uintptr_t)mem, FE_CACHE_LINE);
+    fe_pipeline_t *p = (fe_pipeline_t *)base;
+    size_t slots = 2 * (size_t)cfg->num_channels;
+    size_t out_sz = FE_ALIGN((size_t)cfg->hop_len * cfg->num_channels * sizeof(q15_t), FE_CACHE_LINE);
+
+    memset(p, 0, sizeof(*p));
+    p->state        = (fe_state_t *)(base + lay.state);
+    p->num_channels = cfg->num_channels;
+    p->hop_samples  = (size_t)cfg->hop_len * cfg->num_channels;
+    p->work         = (fe_work_t *)(base + lay.work);
+    p->exp          = (int *)(p->work + slots);
+    p->speech       = base + lay.speech;
+    p->prob         = (q15_t *)(base + lay.prob);
+    p->out[0]       = (q15_t *)(base + lay.out);
+    p->out[1]       = (q15_t *)(base + lay.out + out_sz);
+
+    st = fe_init(cfg, p->state, base + lay.scratch, lay.scratch_stride);
+    if (st != FE_OK) return st;
+    for (size_t s = 0; s < slots; s++) {
+        st = fe_work_bind(p->state, base + lay.scratch + s * lay.scratch_stride,
+                          lay.scratch_stride, &p->work[s]);
+        if (st != FE_OK) return st;
+        p->exp[s] = 0;
+    }
+
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->front.cv, NULL);
+    pthread_cond_init(&p->spectral.cv, NULL);
+    pthread_cond_init(&p->back.cv, NULL);
+
+    static void *(*const stage_main[FE_PIPELINE_STAGES - 1])(void *) = {
+        fe_pipe_spectral_main, fe_pipe_back_main,
+    };
+    for (uint8_t i = 0; i < FE_PIPELINE_STAGES - 1; i++) {
+        p->workers[i].pipe = p;
+        if (pthread_create(&p->workers[i].thread, NULL, stage_main[i], &p->workers[i]) != 0) {
+            fe_pipeline_destroy(p);
+            return FE_ERR_NO_MEM;
+        }
+        p->n_workers++;
+    }
+
+    *pipe_out = p;
+    return FE_OK;
+}
+
+void fe_pipeline_destroy(fe_pipeline_t *p)
+{
+    if (p == NULL) return;
+
+    pthread_mutex_lock(&p->lock);
+    p->shutdown = 1;
+    pthread_cond_broadcast(&p->front.cv);
+    pthread_cond_broadcast(&p->spectral.cv);
+    pthread_mutex_unlock(&p->lock);
+
+    for (uint8_t i = 0; i < p->n_workers; i++) {
+        pthread_join(p->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&p->back.cv);
+    pthread_cond_destroy(&p->spectral.cv);
+    pthread_cond_destroy(&p->front.cv);
+    pthread_mutex_destroy(&p->lock);
+}
+
+fe_status_t fe_pipeline_process_hop(fe_pipeline_t *p, const q15_t *pcm_in, q15_t *pcm_out,
+                                    void *feature_out, size_t feature_sz)
+{
+    if (p == NULL || pcm_in == NULL || pcm_out == NULL) return FE_ERR_NULL_PTR;
+
+    fe_state_t *state = p->state;
+    uint8_t n_ch = p->num_channels;
+    uint64_t hop = p->hops;
+    uint32_t item = (uint32_t)(hop * n_ch);
+    uint8_t par = hop & 1;
+    fe_hop_t *h = &p->hop[par];
+
+    /* ── Front stage: this hop, channel by channel ────────────────────── */
+    fe_hop_begin(state, h);
+    for (uint8_t ch = 0; ch < n_ch; ch++) {
+        const fe_work_t *work = &p->work[(size_t)par * n_ch + ch];
+        fe_hop_condition(state, h, ch, pcm_in);
+        fe_hop_window(state, h, ch, work);
+        p->exp[(size_t)par * n_ch + ch] = fe_hop_fft(state, work);
+        fe_pipe_post(p, &p->front, item + ch + 1);
+    }
+    fe_hop_end(state, h);
+    p->hops = hop + 1;
+
+    /* ── Previous hop out; its slots are free for the next call ───────── */
+    if (hop == 0) {
+        memset(pcm_out, 0, p->hop_samples * sizeof(q15_t));
+        state->vad_speech = 0;
+    } else {
+        fe_pipe_wait(p, &p->back, item);
+        memcpy(pcm_out, p->out[par ^ 1], p->hop_samples * sizeof(q15_t));
+
+        uint8_t speech = 0;
+        for (uint8_t ch = 0; ch < n_ch; ch++) speech |= p->speech[(size_t)(par ^ 1) * n_ch + ch];
+        state->vad_speech = speech;
+    }
+
+    (void)feature_out;
+    (void)feature_sz;
+    return FE_OK;
+}
+
+uint16_t fe_pipeline_latency(const fe_pipeline_t *p)
+{
+    if (p == NULL) return 0;
+    return (uint16_t)(fe_latency(p->state) + p->state->hop_len);
+}
+
+uint8_t fe_pipeline_vad_status(const fe_pipeline_t *p, uint8_t ch, q15_t *prob_q15)
+{
+    if (prob_q15) *prob_q15 = 0;
+    if (p == NULL || p->hops < 2) return 0;
+
+    /* Last returned hop: hops - 2 */
+    uint8_t par = (uint8_t)((p->hops - 2) & 1);
+    const uint8_t *speech = p->speech + (size_t)par * p->num_channels;
+    const q15_t *prob = p->prob + (size_t)par * p->num_channels;
+
+    if (ch == FE_VAD_ANY_CHANNEL) {
+        if (prob_q15) {
+            for (uint8_t c = 0; c < p->num_channels; c++) {
+                if (prob[c] > *prob_q15) *prob_q15 = prob[c];
+            }
+        }
+        return p->state->vad_speech;
+    }
+
+    if (ch >= p->num_channels) return 0;
+    if (prob_q15) *prob_q15 = prob[ch];
+    return speech[ch];
+}
+
+fe_state_t *fe_pipeline_state(fe_pipeline_t *p)
+{
+    return p ? p->state : NULL;
+}
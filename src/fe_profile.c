@@ -0,0 +1,150 @@
+#include <string.h>
+#include "rtafe/fe_api.h"
+
+/* fe_profile.c — Per-stage cycle histograms (RTAFE_PROFILE builds only) */
+
+#ifdef RTAFE_PROFILE
+
+/** Log2 bucket with FE_PROF_SUB_BUCKETS linear steps per octave. */
+static inline uint32_t prof_bucket(uint32_t v)
+{
+    if (v < FE_PROF_SUB_BUCKETS) return v;
+    int msb = 31 - __builtin_clz(v);
+    return (uint32_t)(msb - FE_PROF_SUB_BITS + 1) * FE_PROF_SUB_BUCKETS
+         + ((v >> (msb - FE_PROF_SUB_BITS)) & (FE_PROF_SUB_BUCKETS - 1));
+}
+
+/** Largest value that falls into bucket idx. */
+static inline uint32_t prof_bucket_upper(uint32_t idx)
+{
+    if (idx < FE_PROF_SUB_BUCKETS) return idx;
+    int msb = (int)(idx / FE_PROF_SUB_BUCKETS) - 1 + FE_PROF_SUB_BITS;
+    uint32_t sub = idx % FE_PROF_SUB_BUCKETS;
+    uint64_t lower = (uint64_t)(FE_PROF_SUB_BUCKETS + sub) << (msb - FE_PROF_SUB_BITS);
+    uint64_t upper = lower + ((uint64_t)1 << (msb - FE_PROF_SUB_BITS)) - 1;
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32_t)upper;
+}
+
+static void prof_record(fe_prof_hist_t *h, uint32_t v)
+{
+    /* Single writer: bump seq to odd, update, bump back to even */
+    __atomic_store_n(&h->seq, h->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (h->count == 0 || v < h->min) h->min = v;
+    if (v > h->max) h->max = v;
+    h->sum += v;
+    h->count++;
+    h->bucket[prof_bucket(v)]++;
+
+    __atomic_store_n(&h->seq, h->seq + 1, __ATOMIC_RELEASE);
+}
+
+void fe_prof_init(fe_prof_t *prof)
+{
+    memset(prof, 0, sizeof(*prof));
+#ifdef ARM_TARGET
+    FE_SCB_DEMCR |= (1u << 24);   /* TRCENA */
+    FE_DWT_CYCCNT = 0;
+    FE_DWT_CONTROL |= 1;
+#endif
+}
+
+void fe_prof_commit(fe_prof_t *prof, const uint32_t *stage_cycles, uint32_t hop_cycles)
+{
+    for (int s = 0; s < FE_PROF_HOP; s++) {
+        /* Zero means the stage did not run this hop (disabled / gated) */
+        if (stage_cycles[s] != 0) prof_record(&prof->stage[s], stage_cycles[s]);
+    }
+    prof_record(&prof->stage[FE_PROF_HOP], hop_cycles);
+}
+
+fe_status_t fe_profile_get(const fe_state_t *state, fe_prof_stage_t stage, fe_prof_stats_t *out)
+{
+    if (state == NULL || out == NULL) return FE_ERR_NULL_PTR;
+    if ((unsigned)stage >= FE_PROF_NUM_STAGES) return FE_ERR_BAD_CONFIG;
+
+    const fe_prof_hist_t *h = &state->prof.stage[stage];
+    fe_prof_hist_t snap;
+    uint32_t s1, s2;
+    do {
+        s1 = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+        if (s1 & 1) continue;
+        memcpy(&snap, (const void *)h, sizeof(snap));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        s2 = __atomic_load_n(&h->seq, __ATOMIC_RELAXED);
+    } while ((s1 & 1) || s1 != s2);
+
+    memset(out, 0, sizeof(*out));
+    out->count = snap.count;
+    if (snap.count == 0) return FE_OK;
+
+    out->min = snap.min;
+    out->max = snap.max;
+    out->mean = (uint32_t)(snap.sum / snap.count);
+
+    /* p99: first bucket where the cumulative count reaches 99% */
+    uint64_t target = ((uint64_t)snap.count * 99 + 99) / 100;
+    uint64_t cum = 0;
+    for (uint32_t i = 0; i < FE_PROF_BUCKETS; i++) {
+        cum += snap.bucket[i];
+        if (cum >= target) {
+            out->p99 = prof_bucket_upper(i);
+            break;
+        }
+    }
+    if (out->p99 > out->max) out->p99 = out->max;
+
+    return FE_OK;
+}
+
+fe_status_t fe_profile_reset(fe_state_t *state)
+{
+    if (state == NULL) return FE_ERR_NULL_PTR;
+    for (int s = 0; s < FE_PROF_NUM_STAGES; s++) {
+        fe_prof_hist_t *h = &state->prof.stage[s];
+        __atomic_store_n(&h->seq, h->seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        h->count = 0;
+        h->min = 0;
+        h->max = 0;
+        h->sum = 0;
+        memset(h->bucket, 0, sizeof(h->bucket));
+        __atomic_store_n(&h->seq, h->seq + 1, __ATOMIC_RELEASE);
+    }
+    return FE_OK;
+}
+
+#else
+
+fe_status_t fe_profile_get(const fe_state_t *state, fe_prof_stage_t stage, fe_prof_stats_t *out)
+{
+    (void)state; (void)stage; (void)out;
+    return FE_ERR_BAD_CONFIG;
+}
+
+fe_status_t fe_profile_reset(fe_state_t *state)
+{
+    (void)state;
+    return FE_ERR_BAD_CONFIG;
+}
+
+#endif /* RTAFE_PROFILE */
+
+void fe_profile_dump(const fe_state_t *state, FILE *out)
+{
+    static const char *names[FE_PROF_NUM_STAGES] = {
+        "dc_pre", "window", "fft", "spectral", "gain", "output", "hop"
+    };
+
+    fprintf(out, "%-10s %10s %10s %10s %10s %10s\n", "stage", "count", "min", "mean", "p99", "max");
+    for (int s = 0; s < FE_PROF_NUM_STAGES; s++) {
+        fe_prof_stats_t st;
+        if (fe_profile_get(state, (fe_prof_stage_t)s, &st) != FE_OK) {
+            fprintf(out, "profiling disabled (build with -DRTAFE_PROFILE)\n");
+            return;
+        }
+        fprintf(out, "%-10s %10u %10u %10u %10u %10u\n",
+                names[s], st.count, st.min, st.mean, st.p99, st.max);
+    }
+}
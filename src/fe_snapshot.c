@@ -0,0 +1,256 @@
+#include <stddef.h>
+#include <string.h>
+#include "rtafe/fe_snapshot.h"
+
+/* fe_snapshot.c — Engine state snapshot / restore (rtafe/fe_snapshot.h) */
+
+/* FNV-1a, continued from @p h */
+static uint32_t snap_fnv1a(uint32_t h, const void *data, size_t n)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Header (checksum field as 0) and payload */
+static uint32_t snap_checksum(const fe_snapshot_hdr_t *hdr, const uint8_t *payload)
+{
+    fe_snapshot_hdr_t h = *hdr;
+    h.checksum = 0;
+    uint32_t sum = snap_fnv1a(2166136261u, &h, sizeof(h));
+    return snap_fnv1a(sum, payload, hdr->total_bytes - sizeof(h));
+}
+
+static inline uint8_t snap_f32(const fe_state_t *state)
+{
+    return state->precision == FE_PRECISION_F32;
+}
+
+static inline size_t snap_rec_bytes(const fe_state_t *state)
+{
+    return snap_f32(state) ? sizeof(fe_channel_f32_t) : sizeof(fe_channel_t);
+}
+
+/* Offset of the history ring in a channel block: the noise profile
+   (record + bins + minima rows) ends there */
+static inline size_t snap_chan_hist(const fe_state_t *state)
+{
+    return snap_f32(state) ? (size_t)((uint8_t *)fe_channel_f32(state, 0)->hist - state->chan)
+                           : (size_t)((uint8_t *)fe_channel(state, 0)->hist - state->chan);
+}
+
+static inline uint16_t snap_src_taps(const fe_state_t *state)
+{
+    return state->resample_block ? state->resample_bank.taps : 0;
+}
+
+static size_t snap_payload_bytes(const fe_state_t *state)
+{
+    size_t ch = state->num_channels;
+    size_t src = ch * (2 * (size_t)snap_src_taps(state) * sizeof(q15_t) + 2 * sizeof(uint16_t));
+    return ch * state->chan_stride + (snap_src_taps(state) ? src : 0);
+}
+
+size_t fe_snapshot_bytes(const fe_state_t *state)
+{
+    if (state == NULL) return 0;
+    return sizeof(fe_snapshot_hdr_t) + snap_payload_bytes(state);
+}
+
+fe_status_t fe_snapshot_save(const fe_state_t *state, void *buf, size_t buf_sz)
+{
+    if (state == NULL || buf == NULL) return FE_ERR_NULL_PTR;
+    size_t total = fe_snapshot_bytes(state);
+    if (buf_sz < total) return FE_ERR_NO_MEM;
+
+    fe_snapshot_hdr_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic        = FE_SNAPSHOT_MAGIC;
+    hdr.version      = FE_SNAPSHOT_VERSION;
+    hdr.header_bytes = sizeof(hdr);
+    hdr.total_bytes  = (uint32_t)total;
+    hdr.sample_rate  = state->sample_rate;
+    hdr.input_rate   = state->input_rate;
+    hdr.frame_len    = state->frame_len;
+    hdr.hop_len      = state->hop_len;
+    hdr.num_channels = state->num_channels;
+    hdr.flags        = state->flags;
+    hdr.precision    = state->precision;
+    hdr.window       = state->window;
+    hdr.mode         = state->mode;
+    hdr.vad_speech   = state->vad_speech;
+    hdr.src_taps     = snap_src_taps(state);
+    hdr.chan_stride  = (uint32_t)state->chan_stride;
+    hdr.chan_hist    = (uint32_t)snap_chan_hist(state);
+    hdr.hist_pos     = state->hist_pos;
+    hdr.warmup       = state->warmup;
+    /* Field by field: a struct copy may carry padding bytes; keep the image deterministic */
+    memset(&hdr.params, 0, sizeof(hdr.params));
+    hdr.params.flags              = state->params.flags;
+    hdr.params.dc_rm_alpha        = state->params.dc_rm_alpha;
+    hdr.params.pre_emphasis_alpha = state->params.pre_emphasis_alpha;
+    hdr.params.ns_over_sub        = state->params.ns_over_sub;
+    hdr.params.ns_floor           = state->params.ns_floor;
+
+    /* Channel blocks verbatim, their pointers stored as NULL */
+    uint8_t *out = (uint8_t *)buf + sizeof(hdr);
+    size_t stride = state->chan_stride;
+    for (uint8_t c = 0; c < state->num_channels; c++) {
+        uint8_t *blk = out + c * stride;
+        memcpy(blk, state->chan + c * stride, stride);
+        if (snap_f32(state)) {
+            fe_channel_f32_t rec;
+            memcpy(&rec, blk, sizeof(rec));
+            rec.ns.bins = NULL;
+            rec.ns.sub_min = NULL;
+            rec.hist = rec.ola = rec.fir = NULL;
+            memcpy(blk, &rec, sizeof(rec));
+        } else {
+            fe_channel_t rec;
+            memcpy(&rec, blk, sizeof(rec));
+            rec.ns.bins = NULL;
+            rec.ns.sub_min = NULL;
+            rec.hist = NULL;
+            rec.ola = NULL;
+            memcpy(blk, &rec, sizeof(rec));
+        }
+    }
+
+    /* SRC: histories (one contiguous arena slice), then { pos, phase } */
+    if (hdr.src_taps) {
+        uint8_t *p = out + state->num_channels * stride;
+        size_t hist_bytes = 2 * (size_t)hdr.src_taps * sizeof(q15_t);
+        for (uint8_t c = 0; c < state->num_channels; c++) {
+            memcpy(p, state->resample_block[c].hist, hist_bytes);
+            p += hist_bytes;
+        }
+        for (uint8_t c = 0; c < state->num_channels; c++) {
+            uint16_t pp[2] = { state->resample_block[c].pos, state->resample_block[c].phase };
+            memcpy(p, pp, sizeof(pp));
+            p += sizeof(pp);
+        }
+    }
+
+    hdr.checksum = snap_checksum(&hdr, out);
+    memcpy(buf, &hdr, sizeof(hdr));
+    return FE_OK;
+}
+
+/* Noise profile of one channel: VAD, NS bookkeeping, bins + minima rows */
+static void snap_restore_noise(fe_state_t *state, uint8_t c, const uint8_t *blk, size_t chan_hist)
+{
+    uint8_t *dst = state->chan + c * state->chan_stride;
+    size_t rec_bytes = snap_rec_bytes(state);
+
+    if (snap_f32(state)) {
+        fe_channel_f32_t rec, *d = (fe_channel_f32_t *)dst;
+        memcpy(&rec, blk, sizeof(rec));
+        d->vad = rec.vad;
+        d->ns.min_track_count = rec.ns.min_track_count;
+        d->ns.sub_idx         = rec.ns.sub_idx;
+        d->ns.total_power     = rec.ns.total_power;
+    } else {
+        fe_channel_t rec, *d = (fe_channel_t *)dst;
+        memcpy(&rec, blk, sizeof(rec));
+        d->vad = rec.vad;
+        d->ns.min_track_count = rec.ns.min_track_count;
+        d->ns.sub_idx         = rec.ns.sub_idx;
+        d->ns.total_power     = rec.ns.total_power;
+    }
+    memcpy(dst + rec_bytes, blk + rec_bytes, chan_hist - rec_bytes);
+}
+
+/* Stream position of one channel: filter memories, history ring, OLA tail / FIR */
+static void snap_restore_stream(fe_state_t *state, uint8_t c, const uint8_t *blk, size_t chan_hist)
+{
+    uint8_t *dst = state->chan + c * state->chan_stride;
+
+    if (snap_f32(state)) {
+        fe_channel_f32_t rec, *d = (fe_channel_f32_t *)dst;
+        memcpy(&rec, blk, sizeof(rec));
+        d->dc  = rec.dc;
+        d->pre = rec.pre;
+    } else {
+        fe_channel_t rec, *d = (fe_channel_t *)dst;
+        memcpy(&rec, blk, sizeof(rec));
+        d->dc  = rec.dc;
+        d->pre = rec.pre;
+    }
+    memcpy(dst + chan_hist, blk + chan_hist, state->chan_stride - chan_hist);
+}
+
+fe_status_t fe_snapshot_restore(fe_state_t *state, const void *buf, size_t buf_sz, uint8_t parts)
+{
+    if (state == NULL || buf == NULL) return FE_ERR_NULL_PTR;
+
+    /* ── Format ───────────────────────────────────────────────────────── */
+    fe_snapshot_hdr_t hdr;
+    if (buf_sz < sizeof(hdr)) return FE_ERR_CORRUPT;
+    memcpy(&hdr, buf, sizeof(hdr));
+    if (hdr.magic != FE_SNAPSHOT_MAGIC || hdr.version != FE_SNAPSHOT_VERSION ||
+        hdr.header_bytes != sizeof(hdr) || hdr.total_bytes > buf_sz || hdr.num_channels == 0 ||
+        hdr.chan_hist > hdr.chan_stride ||
+        hdr.total_bytes != sizeof(hdr) + (size_t)hdr.num_channels * hdr.chan_stride +
+                           (hdr.src_taps ? hdr.num_channels * (2u * hdr.src_taps * sizeof(q15_t) +
+                                                               2 * sizeof(uint16_t)) : 0)) {
+        return FE_ERR_CORRUPT;
+    }
+    const uint8_t *payload = (const uint8_t *)buf + sizeof(hdr);
+    if (snap_checksum(&hdr, payload) != hdr.checksum) return FE_ERR_CORRUPT;
+
+    /* ── Compatibility ────────────────────────────────────────────────── */
+    const uint8_t spectral = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    size_t chan_hist = snap_chan_hist(state);
+    if (parts == 0 || (parts & ~FE_SNAP_ALL)) return FE_ERR_BAD_CONFIG;
+    if (hdr.sample_rate != state->sample_rate || hdr.frame_len != state->frame_len ||
+        hdr.precision != state->precision || hdr.num_channels != state->num_channels ||
+        hdr.chan_hist != chan_hist) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if ((parts & FE_SNAP_NOISE) && (hdr.flags & spectral) != (state->flags & spectral)) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if ((parts & FE_SNAP_STREAM) &&
+        (hdr.input_rate != state->input_rate || hdr.hop_len != state->hop_len ||
+         hdr.flags != state->flags || hdr.window != state->window || hdr.mode != state->mode ||
+         hdr.src_taps != snap_src_taps(state) || hdr.chan_stride != state->chan_stride)) {
+        return FE_ERR_BAD_CONFIG;
+    }
+
+    /* ── Load ─────────────────────────────────────────────────────────── */
+    for (uint8_t c = 0; c < state->num_channels; c++) {
+        const uint8_t *blk = payload + c * (size_t)hdr.chan_stride;
+        if (parts & FE_SNAP_NOISE) snap_restore_noise(state, c, blk, chan_hist);
+        if (parts & FE_SNAP_STREAM) snap_restore_stream(state, c, blk, chan_hist);
+    }
+
+    if (parts & FE_SNAP_STREAM) {
+        if (hdr.src_taps) {
+            const uint8_t *p = payload + state->num_channels * state->chan_stride;
+            size_t hist_bytes = 2 * (size_t)hdr.src_taps * sizeof(q15_t);
+            for (uint8_t c = 0; c < state->num_channels; c++) {
+                memcpy(state->resample_block[c].hist, p, hist_bytes);
+                p += hist_bytes;
+            }
+            for (uint8_t c = 0; c < state->num_channels; c++) {
+                uint16_t pp[2];
+                memcpy(pp, p, sizeof(pp));
+                state->resample_block[c].pos   = pp[0];
+                state->resample_block[c].phase = pp[1];
+                p += sizeof(pp);
+            }
+        }
+        state->hist_pos    = hdr.hist_pos;
+        state->warmup      = hdr.warmup;
+        state->vad_speech  = hdr.vad_speech;
+        state->params      = hdr.params;
+        state->params_prev = hdr.params;
+        /* Nothing pending: the restored set is the published one */
+        state->ctl.next    = hdr.params;
+        state->ctl.applied = state->ctl.seq;
+    }
+    return FE_OK;
+}
@@ -0,0 +1,506 @@
+#include "rtafe/fe_stream.h"
+#include "fe_hop.h"
+#include "module/fft.h"
+#include <pthread.h>
+#include <string.h>
+/* fe_stream.c */
+
+#define FE_ALIGN(x, a)  (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+#define FE_QUEUE_MASK   (FE_STREAM_QUEUE_DEPTH - 1)
+
+/* Channel hops per batched FFT: enough lanes to fill the vector units,
+   few enough that the lane block stays in L1/L2. Fewer than
+   FFT_BATCH_MIN_LANES (a round's remainder, a build without SIMD, other
+   precisions) run one FFT at a time with no lane block. */
+#define FE_STREAM_FFT_LANES 8
+
+typedef struct {
+    const q15_t *pcm_in;
+    q15_t       *pcm_out;
+} fe_hop_req_t;
+
+/**
+ * Per-stream hop queue. Single producer (control thread writes head),
+ * single consumer (whichever worker holds the claim writes tail); the claim
+ * hand-off orders successive consumers. One record per cache line so
+ * neighbouring streams on different workers do not false-share.
+ */
+typedef struct {
+    _Alignas(FE_CACHE_LINE) fe_state_t *state;
+    uint32_t     head;                      /**< Next slot to fill */
+    uint32_t     tail;                      /**< Next slot to process */
+    uint32_t     completed;                 /**< Hops processed */
+    uint8_t      claimed;                   /**< 1 while owned by a work item */
+    fe_hop_req_t ring[FE_STREAM_QUEUE_DEPTH];
+} fe_stream_t;
+
+/**
+ * Worker deque of claimed stream ids. The owner pops batches from the
+ * bottom, thieves take from the top; a spinlock guards both ends (critical
+ * sections are a handful of loads). Capacity n_streams: a stream is queued
+ * on at most one deque at a time.
+ */
+typedef struct {
+    uint8_t   lock;
+    uint32_t  top;
+    uint32_t  bottom;
+    uint32_t *ids;
+} fe_deque_t;
+
+/**
+ * Worker. A round holds up to FE_STREAM_BATCH streams' channel hops, one
+ * scratch slot each (slot i * num_channels + ch); slot 0 doubles as the
+ * instance scratch of low-latency blocks.
+ */
+typedef struct {
+    _Alignas(FE_CACHE_LINE) fe_deque_t dq;
+    struct fe_stream_pool *pool;
+    void       *scratch;                    /**< Slot 0 */
+    fe_work_t  *work;                       /**< [FE_STREAM_BATCH * num_channels] */
+    int        *exp;                        /**< Block exponent per slot */
+    q31_t      *fft_re;                     /**< [FE_STREAM_FFT_LANES * frame_len] lane block (Q31) */
+    q31_t      *fft_im;
+    pthread_t   thread;
+    uint8_t     id;
+} fe_worker_t;
+
+struct fe_stream_pool {
+    uint32_t     n_streams;
+    uint8_t      n_workers;
+    uint8_t      n_channels;
+    uint8_t      low_latency;               /**< FE_MODE_LOW_LATENCY: whole blocks, no stages */
+    uint8_t      shutdown;
+    size_t       scratch_sz;
+    fe_stream_t *streams;
+    fe_worker_t  workers[FE_STREAM_MAX_WORKERS];
+
+    uint32_t     queued;                    /**< Stream ids sitting in deques */
+    uint32_t     pending;                   /**< Hops submitted, not completed */
+
+    pthread_mutex_t lock;                   /**< Sleep/wake only, never on the hop path */
+    pthread_cond_t  work_cv;
+    pthread_cond_t  done_cv;
+};
+
+typedef struct {
+    size_t streams, states, state_stride, ids, workers, worker_stride;
+    size_t scratch_stride, work, exp, lanes;    /* Offsets inside a worker block */
+    size_t total;
+} fe_pool_layout_t;
+
+/* ── Arena layout ───────────────────────────────────────────────────────── */
+
+static void fe_pool_layout(const fe_config_t *cfg, uint32_t n_streams, uint8_t n_workers,
+                           fe_pool_layout_t *lay)
+{
+    size_t cur = FE_ALIGN(sizeof(struct fe_stream_pool), FE_CACHE_LINE);
+
+    lay->streams        = cur;
+    cur += FE_ALIGN(n_streams * sizeof(fe_stream_t), FE_CACHE_LINE);
+    lay->state_stride   = FE_ALIGN(fe_state_bytes(cfg), FE_CACHE_LINE);
+    lay->states         = cur;
+    cur += n_streams * lay->state_stride;
+    lay->ids            = cur;
+    cur += FE_ALIGN((size_t)n_workers * n_streams * sizeof(uint32_t), FE_CACHE_LINE);
+
+    /* Per worker: slot scratch, slot work views and exponents, FFT lanes */
+    size_t slots = (size_t)FE_STREAM_BATCH * cfg->num_channels;
+    size_t lane_bytes = (cfg->precision == FE_PRECISION_Q31 && FFT_BATCH_MIN_LANES != 0)
+                      ? 2 * FE_ALIGN((size_t)FE_STREAM_FFT_LANES * cfg->frame_len * sizeof(q31_t),
+                                     FE_CACHE_LINE)
+                      : 0;
+    lay->scratch_stride = FE_ALIGN(fe_scratch_bytes(cfg), FE_CACHE_LINE);
+    lay->work           = slots * lay->scratch_stride;
+    lay->exp            = lay->work + FE_ALIGN(slots * sizeof(fe_work_t), FE_CACHE_LINE);
+    lay->lanes          = lay->exp + FE_ALIGN(slots * sizeof(int), FE_CACHE_LINE);
+    lay->worker_stride  = lay->lanes + lane_bytes;
+    lay->workers        = cur;
+    cur += n_workers * lay->worker_stride;
+
+    /* Slack to align the caller's block to a cache line */
+    lay->total = cur + (FE_CACHE_LINE - 1);
+}
+
+static fe_status_t fe_pool_check(const fe_config_t *cfg, uint32_t n_streams, uint8_t n_workers)
+{
+    if (cfg == NULL) return FE_ERR_NULL_PTR;
+    if (n_streams == 0 || n_workers == 0 || n_workers > FE_STREAM_MAX_WORKERS) {
+        return FE_ERR_BAD_CONFIG;
+    }
+    if (fe_state_bytes(cfg) == 0) return FE_ERR_BAD_CONFIG;
+    return FE_OK;
+}
+
+size_t fe_stream_pool_bytes(const fe_config_t *cfg, uint32_t n_streams, uint8_t n_workers)
+{
+    if (fe_pool_check(cfg, n_streams, n_workers) != FE_OK) return 0;
+    fe_pool_layout_t lay;
+    fe_pool_layout(cfg, n_streams, n_workers, &lay);
+    return lay.total;
+}
+
+/* ── Deque ──────────────────────────────────────────────────────────────── */
+
+static inline void dq_lock(fe_deque_t *dq)
+{
+    while (__atomic_test_and_set(&dq->lock, __ATOMIC_ACQUIRE)) { }
+}
+
+static inline void dq_unlock(fe_deque_t *dq)
+{
+    __atomic_clear(&dq->lock, __ATOMIC_RELEASE);
+}
+
+static void dq_push(fe_deque_t *dq, uint32_t cap, uint32_t id)
+{
+    dq_lock(dq);
+    dq->ids[dq->bottom % cap] = id;
+    dq->bottom++;
+    dq_unlock(dq);
+}
+
+/** Owner side: newest up to FE_STREAM_BATCH ids. */
+static uint32_t dq_pop(fe_deque_t *dq, uint32_t cap, uint32_t *out)
+{
+    dq_lock(dq);
+    uint32_t n = dq->bottom - dq->top;
+    if (n > FE_STREAM_BATCH) n = FE_STREAM_BATCH;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = dq->ids[(dq->bottom - n + i) % cap];
+    }
+    dq->bottom -= n;
+    dq_unlock(dq);
+    return n;
+}
+
+/** Thief side: oldest half, at most FE_STREAM_BATCH ids. */
+static uint32_t dq_steal(fe_deque_t *dq, uint32_t cap, uint32_t *out)
+{
+    dq_lock(dq);
+    uint32_t n = (dq->bottom - dq->top + 1) / 2;
+    if (n > FE_STREAM_BATCH) n = FE_STREAM_BATCH;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = dq->ids[(dq->top + i) % cap];
+    }
+    dq->top += n;
+    dq_unlock(dq);
+    return n;
+}
+
+/* ── Workers ────────────────────────────────────────────────────────────── */
+
+/** Retire the stream's oldest queued hop. */
+static void fe_hop_done(fe_stream_pool_t *pool, fe_stream_t *s)
+{
+    __atomic_store_n(&s->tail, s->tail + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&s->completed, s->completed + 1, __ATOMIC_RELEASE);
+    if (__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * One hop of each of @p n held streams, stage-major: every stream's
+ * conditioning and window, then all channel hops' FFTs as lane batches
+ * and the VAD / NS stage, then all synthesis. Each stage's code and
+ * tables stay hot across the streams instead of being evicted by the
+ * rest of a hop.
+ */
+static void fe_run_round(fe_stream_pool_t *pool, fe_worker_t *w, const uint32_t *ids, uint32_t n)
+{
+    uint8_t n_ch = pool->n_channels;
+    fe_stream_t *s[FE_STREAM_BATCH];
+    const fe_hop_req_t *req[FE_STREAM_BATCH];
+    fe_hop_t hop[FE_STREAM_BATCH];
+
+    for (uint32_t i = 0; i < n; i++) {
+        s[i] = &pool->streams[ids[i]];
+        req[i] = &s[i]->ring[s[i]->tail & FE_QUEUE_MASK];
+    }
+
+    if (pool->low_latency) {
+        /* No STFT stages to split: whole blocks, stream after stream */
+        for (uint32_t i = 0; i < n; i++) {
+            fe_set_scratch(s[i]->state, w->scratch, pool->scratch_sz);
+            fe_process_hop(s[i]->state, req[i]->pcm_in, req[i]->pcm_out, NULL, 0);
+            fe_hop_done(pool, s[i]);
+        }
+        return;
+    }
+
+    /* ── Front: conditioning and analysis window ──────────────────────── */
+    for (uint32_t i = 0; i < n; i++) {
+        fe_state_t *st = s[i]->state;
+        fe_hop_begin(st, &hop[i]);
+        st->vad_speech = 0;
+        for (uint8_t ch = 0; ch < n_ch; ch++) {
+            fe_hop_condition(st, &hop[i], ch, req[i]->pcm_in);
+            fe_hop_window(st, &hop[i], ch, &w->work[(size_t)i * n_ch + ch]);
+        }
+    }
+
+    /* ── Spectral: FFTs FE_STREAM_FFT_LANES channel hops at a time, then
+          VAD / NS (all streams share one configuration and its tables) ── */
+    size_t slots = (size_t)n * n_ch;
+    for (size_t t = 0; t < slots; t += FE_STREAM_FFT_LANES) {
+        size_t lanes = (slots - t < FE_STREAM_FFT_LANES) ? slots - t : FE_STREAM_FFT_LANES;
+        fe_hop_fft_batch(s[0]->state, &w->work[t], lanes, w->fft_re, w->fft_im, &w->exp[t]);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        fe_state_t *st = s[i]->state;
+        for (uint8_t ch = 0; ch < n_ch; ch++) {
+            size_t slot = (size_t)i * n_ch + ch;
+            if (hop[i].spectral) st->vad_speech |= fe_hop_spectral(st, ch, &w->work[slot], w->exp[slot]);
+            if (hop[i].suppress) fe_hop_gain(st, &hop[i], ch, &w->work[slot]);
+        }
+    }
+
+    /* ── Back: synthesis and overlap-add, the hop is out ──────────────── */
+    for (uint32_t i = 0; i < n; i++) {
+        fe_state_t *st = s[i]->state;
+        for (uint8_t ch = 0; ch < n_ch; ch++) {
+            size_t slot = (size_t)i * n_ch + ch;
+            fe_hop_synth(st, ch, &w->work[slot], w->exp[slot], req[i]->pcm_out);
+        }
+        fe_hop_end(st, &hop[i]);
+        fe_hop_done(pool, s[i]);
+    }
+}
+
+/**
+ * Give up the claim on a stream whose queue ran empty. Re-checks after the
+ * release: a hop submitted between the last head load and the release
+ * would otherwise wait for the next dispatch. seq_cst pairs with
+ * fe_stream_submit/dispatch so one side sees it.
+ * @return 1 if the stream was re-claimed and has a hop queued
+ */
+static int fe_stream_release(fe_stream_t *s)
+{
+    __atomic_store_n(&s->claimed, 0, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->head, __ATOMIC_SEQ_CST) == s->tail) return 0;
+
+    uint8_t expected = 0;
+    return __atomic_compare_exchange_n(&s->claimed, &expected, 1, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * Drain a work item's streams in rounds of one hop each, so every stream's
+ * hops stay in submission order; streams whose queue runs empty are
+ * released and leave the item.
+ */
+static void fe_run_batch(fe_stream_pool_t *pool, fe_worker_t *w, uint32_t *ids, uint32_t n)
+{
+    while (n > 0) {
+        uint32_t m = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            fe_stream_t *s = &pool->streams[ids[i]];
+            if (__atomic_load_n(&s->head, __ATOMIC_ACQUIRE) != s->tail || fe_stream_release(s)) {
+                ids[m++] = ids[i];
+            }
+        }
+        n = m;
+        if (n > 0) fe_run_round(pool, w, ids, n);
+    }
+}
+
+static uint32_t fe_find_work(fe_stream_pool_t *pool, fe_worker_t *w, uint32_t *batch)
+{
+    uint32_t cap = pool->n_streams;
+    uint32_t n = dq_pop(&w->dq, cap, batch);
+
+    for (uint8_t k = 1; n == 0 && k < pool->n_workers; k++) {
+        fe_worker_t *victim = &pool->workers[(w->id + k) % pool->n_workers];
+        n = dq_steal(&victim->dq, cap, batch);
+    }
+    return n;
+}
+
+static void *fe_worker_main(void *arg)
+{
+    fe_worker_t *w = (fe_worker_t *)arg;
+    fe_stream_pool_t *pool = w->pool;
+    uint32_t batch[FE_STREAM_BATCH];
+
+    for (;;) {
+        uint32_t n = fe_find_work(pool, w, batch);
+
+        if (n == 0) {
+            pthread_mutex_lock(&pool->lock);
+            while (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0 && !pool->shutdown) {
+                pthread_cond_wait(&pool->work_cv, &pool->lock);
+            }
+            uint8_t stop = pool->shutdown && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0;
+            pthread_mutex_unlock(&pool->lock);
+            if (stop) break;
+            continue;
+        }
+
+        __atomic_sub_fetch(&pool->queued, n, __ATOMIC_ACQ_REL);
+        fe_run_batch(pool, w, batch, n);
+    }
+    return NULL;
+}
+
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+fe_status_t fe_stream_pool_init(void *mem, size_t mem_sz, const fe_config_t *cfg,
+                                uint32_t n_streams, uint8_t n_workers,
+                                fe_stream_pool_t **pool_out)
+{
+    fe_status_t st = fe_pool_check(cfg, n_streams, n_workers);
+    if (st != FE_OK) return st;
+    if (mem == NULL || pool_out == NULL) return FE_ERR_NULL_PTR;
+
+    fe_pool_layout_t lay;
+    fe_pool_layout(cfg, n_streams, n_workers, &lay);
+    if (mem_sz < lay.total) return FE_ERR_NO_MEM;
+
+    uint8_t *base = (uint8_t *)FE_ALIGN((uintptr_t)mem, FE_CACHE_LINE);
+    fe_stream_pool_t *pool = (fe_stream_pool_t *)base;
+    memset(pool, 0, sizeof(*pool));
+    pool->n_streams   = n_streams;
+    pool->n_workers   = n_workers;
+    pool->n_channels  = cfg->num_channels;
+    pool->low_latency = (cfg->mode == FE_MODE_LOW_LATENCY);
+    pool->scratch_sz  = lay.scratch_stride;
+    pool->streams     = (fe_stream_t *)(base + lay.streams);
+
+    for (uint32_t s = 0; s < n_streams; s++) {
+        fe_stream_t *stream = &pool->streams[s];
+        memset(stream, 0, sizeof(*stream));
+        stream->state = (fe_state_t *)(base + lay.states + (size_t)s * lay.state_stride);
+        st = fe_init(cfg, stream->state, base + lay.workers, pool->scratch_sz);
+        if (st != FE_OK) return st;
+    }
+
+    size_t slots = (size_t)FE_STREAM_BATCH * cfg->num_channels;
+    size_t lane_bytes = (lay.worker_stride - lay.lanes) / 2;
+    for (uint8_t i = 0; i < n_workers; i++) {
+        fe_worker_t *w = &pool->workers[i];
+        uint8_t *blk = base + lay.workers + (size_t)i * lay.worker_stride;
+        w->pool    = pool;
+        w->id      = i;
+        w->scratch = blk;
+        w->work    = (fe_work_t *)(blk + lay.work);
+        w->exp     = (int *)(blk + lay.exp);
+        w->fft_re  = lane_bytes ? (q31_t *)(blk + lay.lanes) : NULL;
+        w->fft_im  = lane_bytes ? (q31_t *)(blk + lay.lanes + lane_bytes) : NULL;
+        w->dq.ids  = (uint32_t *)(base + lay.ids) + (size_t)i * n_streams;
+        for (size_t k = 0; k < slots; k++) {
+            st = fe_work_bind(pool->streams[0].state, blk + k * lay.scratch_stride,
+                              lay.scratch_stride, &w->work[k]);
+            if (st != FE_OK) return st;
+        }
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    for (uint8_t i = 0; i < n_workers; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, fe_worker_main, &pool->workers[i]) != 0) {
+            pool->n_workers = i;
+            fe_stream_pool_destroy(pool);
+            return FE_ERR_NO_MEM;
+        }
+    }
+
+    *pool_out = pool;
+    return FE_OK;
+}
+
+void fe_stream_pool_destroy(fe_stream_pool_t *pool)
+{
+    if (pool == NULL) return;
+    if (pool->n_workers > 0) fe_stream_wait(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint8_t i = 0; i < pool->n_workers; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+fe_status_t fe_stream_submit(fe_stream_pool_t *pool, uint32_t stream,
+                             const q15_t *pcm_in, q15_t *pcm_out)
+{
+    if (pool == NULL || pcm_in == NULL || pcm_out == NULL) return FE_ERR_NULL_PTR;
+    if (stream >= pool->n_streams) return FE_ERR_BAD_CONFIG;
+
+    fe_stream_t *s = &pool->streams[stream];
+    uint32_t head = s->head;
+    if (head - __atomic_load_n(&s->tail, __ATOMIC_ACQUIRE) >= FE_STREAM_QUEUE_DEPTH) {
+        return FE_ERR_BUSY;
+    }
+
+    s->ring[head & FE_QUEUE_MASK].pcm_in  = pcm_in;
+    s->ring[head & FE_QUEUE_MASK].pcm_out = pcm_out;
+    __atomic_add_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&s->head, head + 1, __ATOMIC_SEQ_CST);
+    return FE_OK;
+}
+
+void fe_stream_dispatch(fe_stream_pool_t *pool)
+{
+    if (pool == NULL) return;
+
+    uint32_t pushed = 0;
+    for (uint32_t i = 0; i < pool->n_streams; i++) {
+        fe_stream_t *s = &pool->streams[i];
+        if (__atomic_load_n(&s->head, __ATOMIC_SEQ_CST) ==
+            __atomic_load_n(&s->tail, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        uint8_t expected = 0;
+        if (!__atomic_compare_exchange_n(&s->claimed, &expected, 1, 0,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            continue;  /* a worker is already draining it */
+        }
+
+        /* Count before publishing so a fast thief never drives it negative */
+        __atomic_add_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+        dq_push(&pool->workers[i % pool->n_workers].dq, pool->n_streams, i);
+        pushed++;
+    }
+
+    if (pushed) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->work_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void fe_stream_wait(fe_stream_pool_t *pool)
+{
+    if (pool == NULL) return;
+
+    fe_stream_dispatch(pool);
+    pthread_mutex_lock(&pool->lock);
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) != 0) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+uint32_t fe_stream_completed(const fe_stream_pool_t *pool, uint32_t stream)
+{
+    if (pool == NULL || stream >= pool->n_streams) return 0;
+    return __atomic_load_n(&pool->streams[stream].completed, __ATOMIC_ACQUIRE);
+}
+
+fe_state_t *fe_stream_state(fe_stream_pool_t *pool, uint32_t stream)
+{
+    if (pool == NULL || stream >= pool->n_streams) return NULL;
+    return pool->streams[stream].state;
+}
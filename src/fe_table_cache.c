@@ -0,0 +1,112 @@
+#include "rtafe/fe_table_cache.h"
+#include "tables.h"
+#include <stdlib.h>
+#include <math.h>
+
+/* One slot per power of 2, log2(MIN_N) .. log2(MAX_N) */
+#define FE_TABLE_CACHE_SLOTS 13
+
+static const fe_tables_t *cache_slot[FE_TABLE_CACHE_SLOTS];
+static uint8_t cache_lock;
+
+/* ── Builders (same rounding as tools/gen_tables.c) ───────────────────── */
+
+static q15_t cache_q15(double x)
+{
+    double v = floor(x * 32767.0 + 0.5);
+    if (v > 32767.0) v = 32767.0;
+    if (v < -32768.0) v = -32768.0;
+    return (q15_t)v;
+}
+
+static q31_t cache_q31(double x)
+{
+    double v = floor(x * 2147483647.0 + 0.5);
+    if (v > 2147483647.0) v = 2147483647.0;
+    if (v < -2147483648.0) v = -2147483648.0;
+    return (q31_t)v;
+}
+
+static const fe_tables_t *cache_build(uint16_t n, int bits)
+{
+    /* One block: header, twiddles, packed Q1.15 twiddles, windows,
+       bit-reversal map */
+    size_t bytes = sizeof(fe_tables_t) + n * sizeof(q31_t) + n / 2 * sizeof(uint32_t) +
+                   4 * (size_t)n * sizeof(q15_t) + n * sizeof(uint16_t);
+    fe_tables_t *t = (fe_tables_t *)malloc(bytes);
+    if (t == NULL) return NULL;
+
+    q31_t *tw_cos = (q31_t *)(t + 1);
+    q31_t *tw_sin = tw_cos + n / 2;
+    uint32_t *tw_q15 = (uint32_t *)(tw_sin + n / 2);
+    q15_t *win    = (q15_t *)(tw_q15 + n / 2);
+    uint16_t *rev = (uint16_t *)(win + 4 * (size_t)n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        double x = 2.0 * M_PI * i / (n - 1);
+        win[i]         = cache_q15(0.5 * (1.0 - cos(x)));
+        win[n + i]     = cache_q15(0.54 - 0.46 * cos(x));
+        win[2 * n + i] = cache_q15(0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x));
+        win[3 * n + i] = cache_q15(sin(M_PI * i / (n - 1)));
+
+        uint16_t r = 0;
+        for (int b = 0; b < bits; b++) r |= (uint16_t)(((i >> b) & 1) << (bits - 1 - b));
+        rev[i] = r;
+    }
+    for (uint32_t i = 0; i < n / 2u; i++) {
+        double x = 2.0 * M_PI * i / n;
+        tw_cos[i] = cache_q31(cos(x));
+        tw_sin[i] = cache_q31(sin(x));
+        tw_q15[i] = (uint32_t)(uint16_t)cache_q15(cos(x)) |
+                    ((uint32_t)(uint16_t)cache_q15(sin(x)) << 16);
+    }
+
+    t->n          = n;
+    t->hann       = win;
+    t->hamming    = win + n;
+    t->blackman   = win + 2 * (size_t)n;
+    t->sine       = win + 3 * (size_t)n;
+    t->tw_cos     = tw_cos;
+    t->tw_sin     = tw_sin;
+    t->tw_q15     = tw_q15;
+    t->bitrev     = rev;
+    t->mel_start  = NULL;
+    t->mel_len    = NULL;
+    t->mel_offset = NULL;
+    t->mel_weight = NULL;
+    return t;
+}
+
+/* ── Public API ───────────────────────────────────────────────────────── */
+
+const struct fe_tables *fe_table_cache_get(uint16_t n)
+{
+    if (n < FE_TABLE_CACHE_MIN_N || (n & (n - 1)) != 0) return NULL;
+
+    int bits = 0;
+    while ((1u << bits) < n) bits++;
+    const fe_tables_t **slot = &cache_slot[bits - 3];
+
+    const fe_tables_t *t = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (t != NULL) return t;
+
+    while (__atomic_test_and_set(&cache_lock, __ATOMIC_ACQUIRE)) { }
+    t = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    if (t == NULL) {
+        t = cache_build(n, bits);
+        if (t != NULL) __atomic_store_n(slot, t, __ATOMIC_RELEASE);
+    }
+    __atomic_clear(&cache_lock, __ATOMIC_RELEASE);
+    return t;
+}
+
+fe_status_t fe_table_cache_prewarm(const uint16_t *sizes, size_t count)
+{
+    if (sizes == NULL && count != 0) return FE_ERR_NULL_PTR;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t n = sizes[i];
+        if (n < FE_TABLE_CACHE_MIN_N || (n & (n - 1)) != 0) return FE_ERR_BAD_CONFIG;
+        if (fe_table_cache_get(n) == NULL) return FE_ERR_NO_MEM;
+    }
+    return FE_OK;
+}
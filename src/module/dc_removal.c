@@ -5,3 +5,43 @@
  * y[n] = x[n] - x[n - 1] + alpha * y[n - 1]
  */
 
+void dc_removal_init(DCRemoval *dc, q31_t alpha)
+{
+    RTAFE_LOG("Initializing DCRemoval with alpha=0x%08X\n", (uint32_t)alpha);
+    dc->alpha = alpha;
+    dc->x_prev = 0;
+    dc->y_prev = 0;
+}
+
+q31_t dc_removal_alpha_q31(float fc, float fs)
+{
+    double alpha = dc_removal_alpha(fc, fs);
+    if (alpha >= 1.0) return INT32_MAX;
+    if (alpha <= 0.0) return 0;
+    return (q31_t)(alpha * 2147483648.0);
+}
+
+RTAFE_FAST_CODE q31_t dc_removal_process(DCRemoval *dc, q31_t x)
+{
+    /** Q1.31 * Q1.31 = Q2.62 -> Shift back to Q1.31. The difference is
+     *  folded in at Q2.62 before the shift (exact: it has no fraction
+     *  bits), so the whole update is one SMLAL on Cortex-M3/M4/M7 */
+    q63_t acc = (((q63_t)x - dc->x_prev) << Q1_31_SHIFT) + (q63_t)dc->alpha * dc->y_prev;
+    acc >>= Q1_31_SHIFT;
+
+    if (acc > INT32_MAX) acc = INT32_MAX;
+    else if (acc < INT32_MIN) acc = INT32_MIN;
+
+    dc->x_prev = x;
+    dc->y_prev = (q31_t)acc;
+
+    return (q31_t)acc;
+}
+
+void dc_removal_init_f32(DCRemovalF32 *dc, float alpha)
+{
+    RTAFE_LOG("Initializing DCRemovalF32 with alpha=%f\n", alpha);
+    dc->alpha = alpha;
+    dc->x_prev = 0.0f;
+    dc->y_prev = 0.0f;
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "utils.h"
+#include "rtafe/fe_types.h"
 
 typedef struct {
     float alpha;
@@ -56,6 +57,23 @@ static inline s16 _dc_remov_sample_proc_fixed(dc_remov *c, s16 in)
     return out;
 }
 
+/**
+ * Runtime corner-frequency design: pole for a -3 dB corner at fc (Hz)
+ *   alpha = (1 - sin(w)) / cos(w),  w = 2*pi*fc/fs
+ * Uses libm rather than fast_sine_cos: 1 - alpha ≈ w is tiny, so the
+ * polynomial's cos error would dominate. Init-time only.
+ */
+static inline float dc_removal_alpha(float fc, float fs)
+{
+    float w = 2.0f * (float)M_PI * fc / fs;
+    return (1.0f - sinf(w)) / cosf(w);
+}
+
+static inline void _dc_remov_design(dc_remov_coeffs *c, float fc, float fs)
+{
+    c->alpha = dc_removal_alpha(fc, fs);
+}
+
 static inline void _dc_remov_quantize(dc_remov_coeffs *c_float, dc_remov_coeffs_fixed *c_fixed) 
 {
     c_fixed->alpha = FLOAT_TO_Q2_14(c_float->alpha);
@@ -68,4 +86,38 @@ static inline void dc_removal_sample_process(dc_remov *c, sample_t *in)
     #else
         *in = _dc_remov_sample_proc(c, *in);
     #endif
+}
+
+#define dc_remov_sample_proc(c,x) _dc_remov_sample_proc(c,x)
+#define dc_remov_sample_proc_fixed(c,x) _dc_remov_sample_proc_fixed(c,x)
+
+/* ── Q1.31 block used by the hop engine (fe_process_hop) ────────────────── */
+
+typedef struct {
+    q31_t alpha;    /**< Pole position, Q1.31 (e.g. 0.995) */
+    q31_t x_prev;   /**< x[n - 1], Q1.31 */
+    q31_t y_prev;   /**< y[n - 1], Q1.31 */
+} DCRemoval;
+
+void dc_removal_init(DCRemoval *dc, q31_t alpha);
+q31_t dc_removal_alpha_q31(float fc, float fs);
+q31_t dc_removal_process(DCRemoval *dc, q31_t x);
+
+/* ── float32 block used by the FE_PRECISION_F32 hop path ────────────────── */
+
+typedef struct {
+    float alpha;    /**< Pole position (e.g. 0.995) */
+    float x_prev;   /**< x[n - 1] */
+    float y_prev;   /**< y[n - 1] */
+} DCRemovalF32;
+
+void dc_removal_init_f32(DCRemovalF32 *dc, float alpha);
+
+/** y[n] = x[n] - x[n-1] + alpha * y[n-1] (one FMA) */
+static inline float dc_removal_process_f32(DCRemovalF32 *dc, float x)
+{
+    float y = x - dc->x_prev + dc->alpha * dc->y_prev;
+    dc->x_prev = x;
+    dc->y_prev = y;
+    return y;
 }
\ No newline at end of file
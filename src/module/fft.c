@@ -12,10 +12,27 @@
  * Block scaling: each stage divides by 2, so after log2(N) stages the output
  * is scaled down by N. The caller must account for this (return value = number
  * of shifts applied).
+ *
+ * fft_radix2_q15() is the 16-bit variant: interleaved complex samples,
+ * packed twiddles, and a data-dependent shift per stage (block floating
+ * point) returned as the block exponent.
  */
 
 #include "fft.h"
 
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /* ── Helpers ────────────────────────────────────────────────────────────── */
 
 /** Count trailing zeros — gives log2(n) for power-of-2 n. */
@@ -39,7 +56,7 @@ static inline size_t bit_reverse(size_t x, int bits)
 
 /* ── FFT ────────────────────────────────────────────────────────────────── */
 
-int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
+RTAFE_FAST_CODE int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
                    const q31_t *tw_cos, const q31_t *tw_sin)
 {
     RTAFE_LOG("Starting radix-2 FFT on %zu points\n", n);
@@ -62,11 +79,9 @@ int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
         size_t group_size = half_size << 1;          /* distance between groups */
         size_t tw_stride = n / group_size;           /* step through twiddle table */
 
-        /* Block scaling: shift everything right by 1 to keep headroom */
-        for (size_t i = 0; i < n; i++) {
-            re[i] >>= 1;
-            im[i] >>= 1;
-        }
+        /* Block scaling: every element is read exactly once per stage, as
+           a top or a bottom input, so the >> 1 for headroom is applied on
+           load instead of in a separate pass over the block */
         total_shifts++;
 
         for (size_t k = 0; k < n; k += group_size) {
@@ -89,12 +104,484 @@ int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
                 q31_t wr = tw_cos[tw_idx];
                 q31_t wi = tw_sin[tw_idx];
 
-                q31_t br = re[bot];
-                q31_t bi = im[bot];
+                q31_t ar = re[top] >> 1;
+                q31_t ai = im[top] >> 1;
+                q31_t br = re[bot] >> 1;
+                q31_t bi = im[bot] >> 1;
 
+                /* One SMULL + SMLAL pair per component on Cortex-M3/M4/M7 */
                 q31_t t_re = (q31_t)(((q63_t)wr * br + (q63_t)wi * bi) >> 31);
                 q31_t t_im = (q31_t)(((q63_t)wr * bi - (q63_t)wi * br) >> 31);
 
+                re[bot] = ar - t_re;
+                im[bot] = ai - t_im;
+                re[top] = ar + t_re;
+                im[top] = ai + t_im;
+            }
+        }
+    }
+
+    return total_shifts;
+}
+
+/* ── Batched FFT ────────────────────────────────────────────────────────── */
+
+/*
+ * Lane kernels of the batched butterfly. Each computes, for its lanes,
+ * exactly what the scalar loop does: both inputs >> 1 on load, the twiddle
+ * products summed in 64 bits and truncated >> 31. The x86 paths widen the
+ * even and odd 32-bit lanes separately (PMULDQ, or PMULUDQ plus a sign
+ * correction on plain SSE2) and merge the two halves back; NEON widens
+ * with VMULL/VMLAL and narrows with VSHRN.
+ */
+#if defined(__SSE2__) && !defined(__ARM_NEON)
+
+/** Signed 32 x 32 -> 64 products of the even 32-bit lanes. */
+static inline __m128i fft_mul_even_epi32(__m128i a, __m128i b)
+{
+#if defined(__SSE4_1__)
+    return _mm_mul_epi32(a, b);
+#else
+    /* Unsigned product minus (a < 0 ? b : 0) + (b < 0 ? a : 0) in the high half */
+    __m128i fix = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+                                _mm_and_si128(_mm_srai_epi32(b, 31), a));
+    return _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(fix, 32));
+#endif
+}
+
+/** (w0 * x0 + w1 * x1) >> 31, or with - when @p neg, per 32-bit lane. */
+static inline __m128i fft_twiddle_x4(__m128i w0, __m128i x0, __m128i w1, __m128i x1, int neg)
+{
+    __m128i p_even = fft_mul_even_epi32(w0, x0);
+    __m128i q_even = fft_mul_even_epi32(w1, x1);
+    __m128i p_odd  = fft_mul_even_epi32(w0, _mm_srli_epi64(x0, 32));
+    __m128i q_odd  = fft_mul_even_epi32(w1, _mm_srli_epi64(x1, 32));
+    __m128i even = neg ? _mm_sub_epi64(p_even, q_even) : _mm_add_epi64(p_even, q_even);
+    __m128i odd  = neg ? _mm_sub_epi64(p_odd, q_odd) : _mm_add_epi64(p_odd, q_odd);
+    /* Bits 31..62 of each sum: low word of even >> 31, high word of odd << 1 */
+    const __m128i lo = _mm_set_epi32(0, -1, 0, -1);
+    return _mm_or_si128(_mm_and_si128(lo, _mm_srli_epi64(even, 31)),
+                        _mm_andnot_si128(lo, _mm_slli_epi64(odd, 1)));
+}
+
+#endif
+
+#if defined(__AVX2__) && !defined(__ARM_NEON)
+
+/** fft_twiddle_x4() on eight lanes. */
+static inline __m256i fft_twiddle_x8(__m256i w0, __m256i x0, __m256i w1, __m256i x1, int neg)
+{
+    __m256i p_even = _mm256_mul_epi32(w0, x0);
+    __m256i q_even = _mm256_mul_epi32(w1, x1);
+    __m256i p_odd  = _mm256_mul_epi32(w0, _mm256_srli_epi64(x0, 32));
+    __m256i q_odd  = _mm256_mul_epi32(w1, _mm256_srli_epi64(x1, 32));
+    __m256i even = neg ? _mm256_sub_epi64(p_even, q_even) : _mm256_add_epi64(p_even, q_even);
+    __m256i odd  = neg ? _mm256_sub_epi64(p_odd, q_odd) : _mm256_add_epi64(p_odd, q_odd);
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 31), _mm256_slli_epi64(odd, 1), 0xAA);
+}
+
+#endif
+
+/** One butterfly of fft_radix2_q31() on @p batch lanes sharing twiddle (wr, wi). */
+static inline void fft_batch_butterfly(q31_t *restrict tr, q31_t *restrict ti,
+                                       q31_t *restrict br, q31_t *restrict bi,
+                                       q31_t wr, q31_t wi, size_t batch)
+{
+    size_t t = 0;
+#if defined(__ARM_NEON)
+    const int32x2_t vwr = vdup_n_s32(wr), vwi = vdup_n_s32(wi);
+    for (; t + 4 <= batch; t += 4) {
+        int32x4_t xr = vshrq_n_s32(vld1q_s32(&br[t]), 1);
+        int32x4_t xi = vshrq_n_s32(vld1q_s32(&bi[t]), 1);
+        int32x4_t ar = vshrq_n_s32(vld1q_s32(&tr[t]), 1);
+        int32x4_t ai = vshrq_n_s32(vld1q_s32(&ti[t]), 1);
+        int64x2_t re_lo = vmlal_s32(vmull_s32(vget_low_s32(xr), vwr), vget_low_s32(xi), vwi);
+        int64x2_t re_hi = vmlal_s32(vmull_s32(vget_high_s32(xr), vwr), vget_high_s32(xi), vwi);
+        int64x2_t im_lo = vmlsl_s32(vmull_s32(vget_low_s32(xi), vwr), vget_low_s32(xr), vwi);
+        int64x2_t im_hi = vmlsl_s32(vmull_s32(vget_high_s32(xi), vwr), vget_high_s32(xr), vwi);
+        int32x4_t t_re = vcombine_s32(vshrn_n_s64(re_lo, 31), vshrn_n_s64(re_hi, 31));
+        int32x4_t t_im = vcombine_s32(vshrn_n_s64(im_lo, 31), vshrn_n_s64(im_hi, 31));
+        vst1q_s32(&br[t], vsubq_s32(ar, t_re));
+        vst1q_s32(&bi[t], vsubq_s32(ai, t_im));
+        vst1q_s32(&tr[t], vaddq_s32(ar, t_re));
+        vst1q_s32(&ti[t], vaddq_s32(ai, t_im));
+    }
+#elif defined(__SSE2__)
+#if defined(__AVX2__)
+    const __m256i wr8 = _mm256_set1_epi32(wr), wi8 = _mm256_set1_epi32(wi);
+    for (; t + 8 <= batch; t += 8) {
+        __m256i xr = _mm256_srai_epi32(_mm256_loadu_si256((const __m256i *)&br[t]), 1);
+        __m256i xi = _mm256_srai_epi32(_mm256_loadu_si256((const __m256i *)&bi[t]), 1);
+        __m256i ar = _mm256_srai_epi32(_mm256_loadu_si256((const __m256i *)&tr[t]), 1);
+        __m256i ai = _mm256_srai_epi32(_mm256_loadu_si256((const __m256i *)&ti[t]), 1);
+        __m256i t_re = fft_twiddle_x8(wr8, xr, wi8, xi, 0);
+        __m256i t_im = fft_twiddle_x8(wr8, xi, wi8, xr, 1);
+        _mm256_storeu_si256((__m256i *)&br[t], _mm256_sub_epi32(ar, t_re));
+        _mm256_storeu_si256((__m256i *)&bi[t], _mm256_sub_epi32(ai, t_im));
+        _mm256_storeu_si256((__m256i *)&tr[t], _mm256_add_epi32(ar, t_re));
+        _mm256_storeu_si256((__m256i *)&ti[t], _mm256_add_epi32(ai, t_im));
+    }
+#endif
+    const __m128i wr4 = _mm_set1_epi32(wr), wi4 = _mm_set1_epi32(wi);
+    for (; t + 4 <= batch; t += 4) {
+        __m128i xr = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&br[t]), 1);
+        __m128i xi = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&bi[t]), 1);
+        __m128i ar = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&tr[t]), 1);
+        __m128i ai = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&ti[t]), 1);
+        __m128i t_re = fft_twiddle_x4(wr4, xr, wi4, xi, 0);
+        __m128i t_im = fft_twiddle_x4(wr4, xi, wi4, xr, 1);
+        _mm_storeu_si128((__m128i *)&br[t], _mm_sub_epi32(ar, t_re));
+        _mm_storeu_si128((__m128i *)&bi[t], _mm_sub_epi32(ai, t_im));
+        _mm_storeu_si128((__m128i *)&tr[t], _mm_add_epi32(ar, t_re));
+        _mm_storeu_si128((__m128i *)&ti[t], _mm_add_epi32(ai, t_im));
+    }
+#endif
+    /* Remaining lanes (all of them without SIMD) */
+    for (; t < batch; t++) {
+        q31_t ar = tr[t] >> 1, ai = ti[t] >> 1;
+        q31_t xr = br[t] >> 1, xi = bi[t] >> 1;
+        q31_t t_re = (q31_t)(((q63_t)wr * xr + (q63_t)wi * xi) >> 31);
+        q31_t t_im = (q31_t)(((q63_t)wr * xi - (q63_t)wi * xr) >> 31);
+        br[t] = ar - t_re;
+        bi[t] = ai - t_im;
+        tr[t] = ar + t_re;
+        ti[t] = ai + t_im;
+    }
+}
+
+int fft_radix2_q31_batch(q31_t *re, q31_t *im, size_t n, size_t batch,
+                         const q31_t *tw_cos, const q31_t *tw_sin)
+{
+    RTAFE_LOG("Starting batched radix-2 FFT: %zu x %zu points\n", batch, n);
+    if (batch == 1) return fft_radix2_q31(re, im, n, tw_cos, tw_sin);
+
+    const int stages = log2_int(n);
+    int total_shifts = 0;
+
+    /* ── 1. Bit-reversal permutation (whole lane rows at once) ─────────── */
+    for (size_t i = 0; i < n; i++) {
+        size_t j = bit_reverse(i, stages);
+        if (j > i) {
+            q31_t *ri = &re[i * batch], *rj = &re[j * batch];
+            q31_t *ii = &im[i * batch], *ij = &im[j * batch];
+            for (size_t t = 0; t < batch; t++) {
+                q31_t tmp_re = ri[t]; ri[t] = rj[t]; rj[t] = tmp_re;
+                q31_t tmp_im = ii[t]; ii[t] = ij[t]; ij[t] = tmp_im;
+            }
+        }
+    }
+
+    /* ── 2. Butterfly stages, >> 1 block scaling applied on load ───────── */
+    for (int s = 0; s < stages; s++) {
+        size_t half_size = (size_t)1 << s;
+        size_t group_size = half_size << 1;
+        size_t tw_stride = n / group_size;
+        total_shifts++;
+
+        for (size_t k = 0; k < n; k += group_size) {
+            for (size_t j = 0; j < half_size; j++) {
+                /* Twiddle loaded once, reused by every lane */
+                fft_batch_butterfly(&re[(k + j) * batch], &im[(k + j) * batch],
+                                    &re[(k + j + half_size) * batch],
+                                    &im[(k + j + half_size) * batch],
+                                    tw_cos[j * tw_stride], tw_sin[j * tw_stride], batch);
+            }
+        }
+    }
+
+    return total_shifts;
+}
+
+void fft_batch_interleave(q31_t *dst, const q31_t *src, size_t n, size_t batch,
+                          size_t src_stride)
+{
+    for (size_t t = 0; t < batch; t++) {
+        const q31_t *x = &src[t * src_stride];
+        for (size_t i = 0; i < n; i++) {
+            dst[i * batch + t] = x[i];
+        }
+    }
+}
+
+void fft_batch_deinterleave(q31_t *dst, const q31_t *src, size_t n, size_t batch,
+                            size_t dst_stride)
+{
+    for (size_t t = 0; t < batch; t++) {
+        q31_t *y = &dst[t * dst_stride];
+        for (size_t i = 0; i < n; i++) {
+            y[i] = src[i * batch + t];
+        }
+    }
+}
+
+/* ── Q1.15 FFT (block floating point) ──────────────────────────────────── */
+
+/* Largest block peak a stage takes unscaled: (1 + sqrt(2)) * 13572 plus
+   the twiddle product's rounding stays below 32767 */
+#define FFT_Q15_STAGE_PEAK 13572
+
+static inline int fft_q15_stage_shift(uint32_t peak)
+{
+    return (peak <= FFT_Q15_STAGE_PEAK) ? 0 : (peak <= 2 * FFT_Q15_STAGE_PEAK) ? 1 : 2;
+}
+
+static inline uint32_t abs_q15(int32_t v)
+{
+    return (uint32_t)(v < 0 ? -v : v);
+}
+
+static inline uint32_t max_u32(uint32_t a, uint32_t b)
+{
+    return a > b ? a : b;
+}
+
+/* t = W * b >> s, W = cos - j*sin (DIT convention), rounded once */
+static inline void fft_q15_twiddle(uint32_t w, const q15_t *b, int s,
+                                   int32_t *t_re, int32_t *t_im)
+{
+    const int32_t rnd = 1 << (14 + s);
+#if defined(__ARM_FEATURE_DSP)
+    int32_t vb;
+    __builtin_memcpy(&vb, b, sizeof(vb));          /* re low, im high */
+    *t_re = (__smuad((int32_t)w, vb) + rnd) >> (15 + s);
+    *t_im = (__smusdx((int32_t)w, vb) + rnd) >> (15 + s);
+#else
+    const int32_t wr = (int16_t)(w & 0xFFFF);
+    const int32_t wi = (int16_t)(w >> 16);
+    *t_re = (wr * b[0] + wi * b[1] + rnd) >> (15 + s);
+    *t_im = (wr * b[1] - wi * b[0] + rnd) >> (15 + s);
+#endif
+}
+
+#if defined(__SSE2__)
+/*
+ * Four butterflies of fft_radix2_q15() on registers: va / vb hold four top
+ * and four bottom complex samples (re, im packed per 32-bit lane), w their
+ * four packed twiddles; va / vb are replaced by the outputs. The twiddle
+ * products are PMADDWD dual 16-bit MACs on the packed words, the x86
+ * counterpart of SMUAD / SMUSDX; rounding, shifts and 16-bit results match
+ * the scalar butterfly bit for bit.
+ */
+static inline void fft_q15_butterfly_x4(__m128i *va, __m128i *vb, __m128i w, int s)
+{
+    const __m128i hi   = _mm_set1_epi32((int32_t)0xFFFF0000);
+    const __m128i rnd  = _mm_set1_epi32(1 << (14 + s));
+    const __m128i half = _mm_set1_epi32((1 << s) >> 1);
+    const __m128i sh_t = _mm_cvtsi32_si128(15 + s);
+    const __m128i sh_a = _mm_cvtsi32_si128(s);
+
+    /* t_re = cos * re + sin * im, t_im = cos * im - sin * re */
+    __m128i ws = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, 0xB1), 0xB1);   /* (sin, cos) */
+    __m128i t_re = _mm_madd_epi16(*vb, w);
+    __m128i t_im = _mm_sub_epi32(_mm_madd_epi16(*vb, _mm_and_si128(ws, hi)),
+                                 _mm_madd_epi16(*vb, _mm_andnot_si128(hi, ws)));
+    t_re = _mm_sra_epi32(_mm_add_epi32(t_re, rnd), sh_t);
+    t_im = _mm_sra_epi32(_mm_add_epi32(t_im, rnd), sh_t);
+
+    /* a >> s, (re, im) widened to 32 bits; outputs packed back (the block
+       shift keeps them in range, so the saturation never engages) */
+    __m128i a_lo = _mm_sra_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(*va, *va), 16), half), sh_a);
+    __m128i a_hi = _mm_sra_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(*va, *va), 16), half), sh_a);
+    __m128i t_lo = _mm_unpacklo_epi32(t_re, t_im);
+    __m128i t_hi = _mm_unpackhi_epi32(t_re, t_im);
+    *va = _mm_packs_epi32(_mm_add_epi32(a_lo, t_lo), _mm_add_epi32(a_hi, t_hi));
+    *vb = _mm_packs_epi32(_mm_sub_epi32(a_lo, t_lo), _mm_sub_epi32(a_hi, t_hi));
+}
+
+/** Peak magnitude from lane-wise maxima / minima. */
+static inline uint32_t fft_q15_peak_x4(__m128i vmax, __m128i vmin)
+{
+    vmax = _mm_max_epi16(vmax, _mm_shuffle_epi32(vmax, 0x4E));
+    vmax = _mm_max_epi16(vmax, _mm_shuffle_epi32(vmax, 0xB1));
+    vmax = _mm_max_epi16(vmax, _mm_shufflelo_epi16(vmax, 0xB1));
+    vmin = _mm_min_epi16(vmin, _mm_shuffle_epi32(vmin, 0x4E));
+    vmin = _mm_min_epi16(vmin, _mm_shuffle_epi32(vmin, 0xB1));
+    vmin = _mm_min_epi16(vmin, _mm_shufflelo_epi16(vmin, 0xB1));
+    return max_u32(abs_q15((int16_t)_mm_cvtsi128_si32(vmax)),
+                   abs_q15((int16_t)_mm_cvtsi128_si32(vmin)));
+}
+
+/**
+ * Stage @p st of fft_radix2_q15() with shift @p s, four butterflies per
+ * step (n >= 8). Groups of 2 and 4 samples are split from two registers
+ * into tops and bottoms and merged back; from group size 8 on the
+ * twiddles of four consecutive butterflies are loaded once for all groups.
+ * @return Peak magnitude of the stage output
+ */
+static uint32_t fft_q15_stage_x4(q15_t *x, size_t n, const uint32_t *tw, int st, int s)
+{
+    const size_t half_size = (size_t)1 << st;
+    const size_t tw_stride = n >> (st + 1);
+    __m128i vmax = _mm_setzero_si128(), vmin = _mm_setzero_si128();
+
+    if (half_size < 4) {
+        const __m128i w = (half_size == 1)
+                        ? _mm_set1_epi32((int32_t)tw[0])
+                        : _mm_set_epi32((int32_t)tw[tw_stride], (int32_t)tw[0],
+                                        (int32_t)tw[tw_stride], (int32_t)tw[0]);
+        for (size_t k = 0; k < n; k += 8) {
+            __m128i r0 = _mm_loadu_si128((const __m128i *)&x[2 * k]);
+            __m128i r1 = _mm_loadu_si128((const __m128i *)&x[2 * k + 8]);
+            __m128i a, b;
+            if (half_size == 1) {
+                a = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(r0), _mm_castsi128_ps(r1),
+                                                    _MM_SHUFFLE(2, 0, 2, 0)));
+                b = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(r0), _mm_castsi128_ps(r1),
+                                                    _MM_SHUFFLE(3, 1, 3, 1)));
+            } else {
+                a = _mm_unpacklo_epi64(r0, r1);
+                b = _mm_unpackhi_epi64(r0, r1);
+            }
+            fft_q15_butterfly_x4(&a, &b, w, s);
+            vmax = _mm_max_epi16(vmax, _mm_max_epi16(a, b));
+            vmin = _mm_min_epi16(vmin, _mm_min_epi16(a, b));
+            if (half_size == 1) {
+                r0 = _mm_unpacklo_epi32(a, b);
+                r1 = _mm_unpackhi_epi32(a, b);
+            } else {
+                r0 = _mm_unpacklo_epi64(a, b);
+                r1 = _mm_unpackhi_epi64(a, b);
+            }
+            _mm_storeu_si128((__m128i *)&x[2 * k], r0);
+            _mm_storeu_si128((__m128i *)&x[2 * k + 8], r1);
+        }
+    } else {
+        for (size_t j = 0; j < half_size; j += 4) {
+            const __m128i w = _mm_set_epi32((int32_t)tw[(j + 3) * tw_stride], (int32_t)tw[(j + 2) * tw_stride],
+                                            (int32_t)tw[(j + 1) * tw_stride], (int32_t)tw[j * tw_stride]);
+            for (size_t k = 0; k < n; k += 2 * half_size) {
+                q15_t *top = &x[2 * (k + j)];
+                q15_t *bot = top + 2 * half_size;
+                __m128i a = _mm_loadu_si128((const __m128i *)top);
+                __m128i b = _mm_loadu_si128((const __m128i *)bot);
+                fft_q15_butterfly_x4(&a, &b, w, s);
+                vmax = _mm_max_epi16(vmax, _mm_max_epi16(a, b));
+                vmin = _mm_min_epi16(vmin, _mm_min_epi16(a, b));
+                _mm_storeu_si128((__m128i *)top, a);
+                _mm_storeu_si128((__m128i *)bot, b);
+            }
+        }
+    }
+    return fft_q15_peak_x4(vmax, vmin);
+}
+#endif
+
+RTAFE_FAST_CODE int fft_radix2_q15(q15_t *x, size_t n, const uint32_t *tw)
+{
+    RTAFE_LOG("Starting Q15 radix-2 FFT on %zu points\n", n);
+    const int stages = log2_int(n);
+    int exponent = 0;
+    uint32_t peak = 0;
+
+    /* ── 1. Bit-reversal permutation, peak of the input block ──────────── */
+    for (size_t i = 0; i < n; i++) {
+        size_t j = bit_reverse(i, stages);
+        if (j > i) {
+            q15_t tmp_re = x[2 * i]; x[2 * i] = x[2 * j]; x[2 * j] = tmp_re;
+            q15_t tmp_im = x[2 * i + 1]; x[2 * i + 1] = x[2 * j + 1]; x[2 * j + 1] = tmp_im;
+        }
+#if !defined(__SSE2__)
+        peak = max_u32(peak, max_u32(abs_q15(x[2 * i]), abs_q15(x[2 * i + 1])));
+#endif
+    }
+#if defined(__SSE2__)
+    if (n >= 8) {
+        __m128i vmax = _mm_setzero_si128(), vmin = _mm_setzero_si128();
+        for (size_t i = 0; i < 2 * n; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&x[i]);
+            vmax = _mm_max_epi16(vmax, v);
+            vmin = _mm_min_epi16(vmin, v);
+        }
+        peak = fft_q15_peak_x4(vmax, vmin);
+    } else {
+        for (size_t i = 0; i < 2 * n; i++) peak = max_u32(peak, abs_q15(x[i]));
+    }
+#endif
+
+    /* ── 2. Butterfly stages, shift chosen from the previous stage's peak ─ */
+    for (int st = 0; st < stages; st++) {
+        size_t half_size = (size_t)1 << st;
+        size_t group_size = half_size << 1;
+        size_t tw_stride = n / group_size;
+        const int s = fft_q15_stage_shift(peak);
+        const int32_t half_lsb = (1 << s) >> 1;
+        exponent += s;
+#if defined(__SSE2__)
+        if (n >= 8) {
+            peak = fft_q15_stage_x4(x, n, tw, st, s);
+            continue;
+        }
+#endif
+        peak = 0;
+
+        for (size_t k = 0; k < n; k += group_size) {
+            for (size_t j = 0; j < half_size; j++) {
+                q15_t *a = &x[2 * (k + j)];
+                q15_t *b = &x[2 * (k + j + half_size)];
+                int32_t t_re, t_im;
+                fft_q15_twiddle(tw[j * tw_stride], b, s, &t_re, &t_im);
+
+                int32_t a_re = (a[0] + (half_lsb)) >> s;
+                int32_t a_im = (a[1] + (half_lsb)) >> s;
+#if defined(__ARM_FEATURE_DSP)
+                /* Packed re/im: one SADD16/SSUB16 and one word store per output
+                   (the block shift guarantees no lane wraps) */
+                int32_t va = (int32_t)((uint16_t)a_re | ((uint32_t)a_im << 16));
+                int32_t vt = (int32_t)((uint16_t)t_re | ((uint32_t)t_im << 16));
+                int32_t vy0 = __sadd16(va, vt), vy1 = __ssub16(va, vt);
+                __builtin_memcpy(a, &vy0, sizeof(vy0));
+                __builtin_memcpy(b, &vy1, sizeof(vy1));
+                int32_t y0 = (int16_t)vy0, y1 = vy0 >> 16;
+                int32_t y2 = (int16_t)vy1, y3 = vy1 >> 16;
+#else
+                int32_t y0 = a_re + t_re, y1 = a_im + t_im;
+                int32_t y2 = a_re - t_re, y3 = a_im - t_im;
+                a[0] = (q15_t)y0; a[1] = (q15_t)y1;
+                b[0] = (q15_t)y2; b[1] = (q15_t)y3;
+#endif
+
+                peak = max_u32(peak, max_u32(max_u32(abs_q15(y0), abs_q15(y1)),
+                                             max_u32(abs_q15(y2), abs_q15(y3))));
+            }
+        }
+    }
+
+    return exponent;
+}
+
+/* ── float32 FFT ────────────────────────────────────────────────────────── */
+
+RTAFE_FAST_CODE void fft_radix2_f32(float *re, float *im, size_t n,
+                    const float *tw_cos, const float *tw_sin)
+{
+    RTAFE_LOG("Starting float radix-2 FFT on %zu points\n", n);
+    const int stages = log2_int(n);
+
+    for (size_t i = 0; i < n; i++) {
+        size_t j = bit_reverse(i, stages);
+        if (j > i) {
+            float tmp_re = re[i]; re[i] = re[j]; re[j] = tmp_re;
+            float tmp_im = im[i]; im[i] = im[j]; im[j] = tmp_im;
+        }
+    }
+
+    for (int s = 0; s < stages; s++) {
+        size_t half_size = (size_t)1 << s;
+        size_t group_size = half_size << 1;
+        size_t tw_stride = n / group_size;
+
+        for (size_t k = 0; k < n; k += group_size) {
+            for (size_t j = 0; j < half_size; j++) {
+                float wr = tw_cos[j * tw_stride];
+                float wi = tw_sin[j * tw_stride];
+
+                size_t top = k + j;
+                size_t bot = top + half_size;
+
+                /* T = W * X[bot], W = cos - j*sin (DIT convention) */
+                float t_re = wr * re[bot] + wi * im[bot];
+                float t_im = wr * im[bot] - wi * re[bot];
+
                 re[bot] = re[top] - t_re;
                 im[bot] = im[top] - t_im;
                 re[top] = re[top] + t_re;
@@ -102,6 +589,4 @@ int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
             }
         }
     }
-
-    return total_shifts;
 }
@@ -1,4 +1,4 @@
-/* fft.h — Fixed-point radix-2 DIT FFT with block scaling */
+/* fft.h — Fixed-point radix-2 DIT FFT with block scaling (Q1.31, Q1.15 block floating point) */
 
 #pragma once
 #include <stdint.h>
@@ -20,3 +20,93 @@
  */
 int fft_radix2_q31(q31_t *re, q31_t *im, size_t n,
                    const q31_t *tw_cos, const q31_t *tw_sin);
+
+/**
+ * Batched radix-2 DIT FFT: @p batch transforms of the same length computed
+ * together, one lane per transform.
+ *
+ * Layout is interleaved (transform-minor): sample i of transform t lives at
+ * re[i * batch + t] / im[i * batch + t]. Each butterfly loads its twiddle
+ * once and applies it to all lanes with unit-stride accesses. The lane
+ * kernel is written with intrinsics (the compiler does not vectorize the
+ * 32 x 32 -> 64 products): 8 lanes per step with AVX2, 4 with SSE4.1,
+ * SSE2 or NEON, scalar for the rest and on other targets. Every lane is
+ * bit-exact with fft_radix2_q31() on the same data.
+ *
+ * @param re        Real parts, n * batch interleaved. Modified in-place.
+ * @param im        Imaginary parts, n * batch interleaved. Modified in-place.
+ * @param n         FFT length (power of 2).
+ * @param batch     Number of transforms (lanes).
+ * @param tw_cos    Precomputed cosine twiddles (Q1.31), length n/2.
+ * @param tw_sin    Precomputed sine twiddles (Q1.31), length n/2.
+ * @return          Block-scaling shifts applied (same for every lane).
+ */
+int fft_radix2_q31_batch(q31_t *re, q31_t *im, size_t n, size_t batch,
+                         const q31_t *tw_cos, const q31_t *tw_sin);
+
+/**
+ * Smallest batch for which fft_radix2_q31_batch() beats as many
+ * fft_radix2_q31() calls, copies into and out of the lane layout included
+ * (bench_fe: fft_batch vs fft). Builds without SSE2 or NEON run every
+ * lane scalar and never win: 0 there, do not batch.
+ */
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define FFT_BATCH_MIN_LANES 4
+#else
+#define FFT_BATCH_MIN_LANES 0
+#endif
+
+/**
+ * Gather @p batch transforms stored @p src_stride samples apart into the
+ * interleaved layout of fft_radix2_q31_batch(): dst[i * batch + t] =
+ * src[t * src_stride + i].
+ */
+void fft_batch_interleave(q31_t *dst, const q31_t *src, size_t n, size_t batch,
+                          size_t src_stride);
+
+/** Inverse of fft_batch_interleave(): dst[t * dst_stride + i] = src[i * batch + t]. */
+void fft_batch_deinterleave(q31_t *dst, const q31_t *src, size_t n, size_t batch,
+                            size_t dst_stride);
+
+/**
+ * In-place radix-2 DIT FFT on interleaved Q1.15 complex data with
+ * per-stage block floating point.
+ *
+ * Before each stage the block peak picks a right shift of 0, 1 or 2 that
+ * keeps the stage from overflowing (a butterfly grows a component by at
+ * most 1 + sqrt(2)), so quiet frames keep their resolution instead of
+ * losing log2(n) bits to a fixed 1/2 per stage. The shift is folded into
+ * the twiddle product's rounding. Half the working set of the Q1.31
+ * transform; on cores with the DSP extension the twiddle product of one
+ * complex sample is one SMUAD + one SMUSDX against a packed twiddle word,
+ * with SSE2 four butterflies run at once on PMADDWD (bit-exact with the
+ * scalar butterfly). That packed arithmetic is where the speedup over
+ * fft_radix2_q31() comes from; the portable C fallback on other targets
+ * unpacks every product into scalar multiplies and is slower than Q31.
+ *
+ * @param x         Interleaved complex data (re, im), 2 * @p n values.
+ *                  Modified in-place (zero im for real input).
+ * @param n         FFT length (power of 2).
+ * @param tw        Packed Q1.15 twiddles, cos in the low half and sin in
+ *                  the high half of each word (fe_tables_t::tw_q15), n/2.
+ * @return          Block exponent e: output = FFT(input) * 2^-e.
+ */
+int fft_radix2_q15(q15_t *x, size_t n, const uint32_t *tw);
+
+/**
+ * In-place radix-2 DIT FFT, float32. Same structure and twiddle convention
+ * as fft_radix2_q31() but without block scaling (float has the headroom);
+ * the butterfly is written as multiply-adds that the compiler contracts
+ * to FMAs only when the target has them: the Cortex-M4/M7 FPUs, and on
+ * x86 -mfma or an -march that includes it (the Makefile's HOST_ARCH,
+ * -march=native by default). The x86-64 baseline has no FMA; there the
+ * products and sums stay separate, rounded twice.
+ *
+ * @param re        Real part array, length @p n. Modified in-place.
+ * @param im        Imaginary part array, length @p n. Modified in-place.
+ * @param n         FFT length (power of 2).
+ * @param tw_cos    Cosine twiddles, length n/2.
+ * @param tw_sin    Sine twiddles, length n/2.
+ */
+void fft_radix2_f32(float *re, float *im, size_t n,
+                    const float *tw_cos, const float *tw_sin);
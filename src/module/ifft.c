@@ -1 +1,65 @@
 /* ifft.c */
+#include "ifft.h"
+#include "fft.h"
+
+RTAFE_FAST_CODE int ifft_radix2_q31(q31_t *re, q31_t *im, size_t n,
+                    const q31_t *tw_cos, const q31_t *tw_sin)
+{
+    /* |im| is at most 2^31 / n after a block-scaled forward FFT, so the
+       negations cannot hit INT32_MIN */
+    for (size_t i = 0; i < n; i++) im[i] = -im[i];
+    int shifts = fft_radix2_q31(re, im, n, tw_cos, tw_sin);
+    for (size_t i = 0; i < n; i++) im[i] = -im[i];
+    return shifts;
+}
+
+/* -x for Q1.15, -(-1) saturating to 32767 */
+static inline q15_t neg_q15(q15_t v)
+{
+    return (v == INT16_MIN) ? INT16_MAX : (q15_t)-v;
+}
+
+RTAFE_FAST_CODE int ifft_radix2_q15(q15_t *x, size_t n, const uint32_t *tw)
+{
+    for (size_t i = 0; i < n; i++) x[2 * i + 1] = neg_q15(x[2 * i + 1]);
+    int exponent = fft_radix2_q15(x, n, tw);
+    for (size_t i = 0; i < n; i++) x[2 * i + 1] = neg_q15(x[2 * i + 1]);
+    return exponent;
+}
+
+RTAFE_FAST_CODE void ifft_radix2_f32(float *re, float *im, size_t n,
+                     const float *tw_cos, const float *tw_sin)
+{
+    for (size_t i = 0; i < n; i++) im[i] = -im[i];
+    fft_radix2_f32(re, im, n, tw_cos, tw_sin);
+    for (size_t i = 0; i < n; i++) im[i] = -im[i];
+}
+
+RTAFE_FAST_CODE void overlap_add_q31(q31_t *acc, const q31_t *frame, const q31_t *win, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        acc[i] += (q31_t)(((q63_t)frame[i] * win[i]) >> Q1_31_SHIFT);
+    }
+}
+
+RTAFE_FAST_CODE void overlap_add_q15(q31_t *acc, const q15_t *frame, const q31_t *win, size_t len, int shift)
+{
+    /* frame * 2^shift * win in Q1.31: one product, one shift */
+    const int rshift = Q1_31_SHIFT - shift;
+    if (rshift > 0) {
+        for (size_t i = 0; i < len; i++) {
+            acc[i] += (q31_t)(((q63_t)frame[2 * i] * win[i]) >> rshift);
+        }
+    } else {
+        for (size_t i = 0; i < len; i++) {
+            acc[i] += (q31_t)(((q63_t)frame[2 * i] * win[i]) << -rshift);
+        }
+    }
+}
+
+RTAFE_FAST_CODE void overlap_add_f32(float *acc, const float *frame, const float *win, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        acc[i] += frame[i] * win[i];
+    }
+}
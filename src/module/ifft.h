@@ -3,5 +3,42 @@
 #pragma once
 #include <stdint.h>
 #include "rtafe/fe_types.h"
-void ifft_radix2_q31(const q31_t *input, q31_t *output, size_t n);
-void overlap_add(q15_t *output, const q15_t *frame, size_t frame_len, size_t hop_len);
\ No newline at end of file
+
+/**
+ * In-place inverse FFT (fixed-point Q1.31) via the conjugation identity
+ * ifft(X) = conj(fft(conj(X))) / n, reusing fft_radix2_q31() and its
+ * twiddles. Block scaling divides by n, so a spectrum produced by
+ * fft_radix2_q31() (itself scaled by 1/n) comes back as x / n.
+ *
+ * @return Block-scaling shifts applied (log2(n)).
+ */
+int ifft_radix2_q31(q31_t *re, q31_t *im, size_t n,
+                    const q31_t *tw_cos, const q31_t *tw_sin);
+
+/**
+ * In-place inverse of fft_radix2_q15() via the same conjugation identity,
+ * unscaled: the output is n * ifft(X) * 2^-e.
+ *
+ * @return Block exponent e of the inverse transform.
+ */
+int ifft_radix2_q15(q15_t *x, size_t n, const uint32_t *tw);
+
+/** float32 inverse FFT, unscaled: ifft(X) * n (pairs with a 1/n-scaled forward). */
+void ifft_radix2_f32(float *re, float *im, size_t n,
+                     const float *tw_cos, const float *tw_sin);
+
+/**
+ * Weighted overlap-add: acc[i] += frame[i] * win[i] for i < len.
+ * @p win is a Q1.31 synthesis window (already carrying the OLA gain).
+ */
+void overlap_add_q31(q31_t *acc, const q31_t *frame, const q31_t *win, size_t len);
+
+/**
+ * overlap_add_q31() from the real parts of an interleaved Q1.15 frame
+ * (fft_radix2_q15 layout), each scaled by 2^@p shift (negative: right
+ * shift) into the accumulator's units before windowing.
+ */
+void overlap_add_q15(q31_t *acc, const q15_t *frame, const q31_t *win, size_t len, int shift);
+
+/** float32 variant of overlap_add_q31(). */
+void overlap_add_f32(float *acc, const float *frame, const float *win, size_t len);
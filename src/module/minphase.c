@@ -0,0 +1,51 @@
+/* minphase.c */
+#include <math.h>
+#include "minphase.h"
+#include "fft.h"
+#include "ifft.h"
+
+void minphase_fir_f32(const float *gain, size_t n, float *re, float *im,
+                      const float *tw_cos, const float *tw_sin,
+                      float *taps, size_t n_taps)
+{
+    size_t half = n / 2;
+    float inv_n = 1.0f / (float)n;
+
+    /* log|G| is real and even, so its cepstrum is real */
+    for (size_t k = 0; k <= half; k++) {
+        float g = gain[k] > MINPHASE_GAIN_FLOOR ? gain[k] : MINPHASE_GAIN_FLOOR;
+        re[k] = logf(g);
+        im[k] = 0.0f;
+        if (k > 0 && k < half) {
+            re[n - k] = re[k];
+            im[n - k] = 0.0f;
+        }
+    }
+    ifft_radix2_f32(re, im, n, tw_cos, tw_sin);
+
+    /* Fold: c[0], 2c[1 .. n/2), c[n/2], nothing at negative quefrency */
+    re[0] *= inv_n;
+    for (size_t i = 1; i < half; i++) re[i] *= 2.0f * inv_n;
+    re[half] *= inv_n;
+    for (size_t i = half + 1; i < n; i++) re[i] = 0.0f;
+    for (size_t i = 0; i < n; i++) im[i] = 0.0f;
+    fft_radix2_f32(re, im, n, tw_cos, tw_sin);
+
+    /* H = exp(C); Hermitian, so only the lower half needs exp/cos/sin */
+    for (size_t k = 0; k <= half; k++) {
+        float mag = expf(re[k]);
+        float ph = im[k];
+        re[k] = mag * cosf(ph);
+        im[k] = mag * sinf(ph);
+        if (k > 0 && k < half) {
+            re[n - k] = re[k];
+            im[n - k] = -im[k];
+        }
+    }
+    ifft_radix2_f32(re, im, n, tw_cos, tw_sin);
+
+    for (size_t i = 0; i < n_taps; i++) {
+        float taper = 0.5f * (1.0f + cosf((float)M_PI * (float)i / (float)n_taps));
+        taps[i] = re[i] * inv_n * taper;
+    }
+}
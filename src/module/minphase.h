@@ -0,0 +1,28 @@
+/* minphase.h — Minimum-phase FIR from a zero-phase gain vector */
+
+#pragma once
+#include <stddef.h>
+#include "rtafe/fe_types.h"
+
+#define MINPHASE_GAIN_FLOOR 1e-4f   /**< -80 dB, keeps log|G| finite */
+
+/**
+ * Minimum-phase FIR approximating the magnitude response @p gain, by the
+ * folded real cepstrum: log|G| → cepstrum, fold negative quefrencies onto
+ * positive ones, exp back into a spectrum, inverse transform. The
+ * response's energy sits at its head, so a short FIR realizes a spectral
+ * gain with a few samples of group delay instead of a frame of latency.
+ * The truncated tail is tapered with a half Hann.
+ *
+ * @param gain      [n / 2 + 1] linear magnitude, 1.0 = unity
+ * @param n         Transform length (power of 2); cepstral aliasing falls as n grows
+ * @param re        [n] work buffer, clobbered
+ * @param im        [n] work buffer, clobbered
+ * @param tw_cos    float cosine twiddles, length n / 2
+ * @param tw_sin    float sine twiddles, length n / 2
+ * @param taps      Output impulse response, length @p n_taps
+ * @param n_taps    Filter length, at most n / 2
+ */
+void minphase_fir_f32(const float *gain, size_t n, float *re, float *im,
+                      const float *tw_cos, const float *tw_sin,
+                      float *taps, size_t n_taps);
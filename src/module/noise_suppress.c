@@ -1,6 +1,7 @@
 #include "noise_suppress.h"
+#include "fixedpoint.h"
 #include <string.h>
-#include <stdlib.h>
+#include <float.h>
 
 /**
  * @brief Speech-aware adaptive noise estimation with minimum tracking.
@@ -15,10 +16,13 @@
  * - Noise power ≈ minimum power observed over past N frames
  * - Speech transients create peaks above the noise floor
  * - By tracking minimums, we build a reliable noise profile
- * - Reset periodically (every ~200-300ms for 10ms frames)
+ * - The window slides by sub-windows (Martin 2001): each completed
+ *   sub-window minimum enters a ring of NS_SUBWIN_COUNT rows and evicts
+ *   the oldest, so old minima age out without a full reset
  *
- * VAD-LIKE ACTIVITY DETECTION:
- * - Compares current frame energy against 1.5x noise estimate
+ * SPEECH-AWARE ADAPTATION:
+ * - Speech/non-speech decision comes from the standalone VAD (vad.c), which
+ *   runs once per hop on the shared power spectrum
  * - Speech frames trigger slower noise adaptation
  * - Prevents upward drift of noise estimate during speech
  *
@@ -27,156 +31,349 @@
  * - Gain output: Q6.9 (0 to ~512, typically 0-1 in linear)
  *
  * EMBEDDED OPTIMIZATION:
- * - No expensive division; uses fixed shifts for 1/8, 1/16
+ * - No division: fixed shifts for 1/8, 1/16, and the gain's 1/P[k] from the
+ *   table + Newton reciprocal (fixedpoint.h)
  * - Single-pass computation per frame
- * - Minimal state per channel (n_bins × 4 bytes for minimums)
+ * - Per channel: n_bins × 16 bytes of interleaved records (estimate,
+ *   sub-window minimum, window minimum, next window minimum) touched in
+ *   one streaming pass, plus NS_SUBWIN_COUNT contiguous rows of n_bins
+ *   minima of which every hop reads and writes a fixed number
  */
 
-fe_status_t noise_suppress_init(noise_suppress_state_t *state, size_t n_bins)
+/* Frames per sub-window so that NS_SUBWIN_COUNT of them span min_track_len */
+static inline uint16_t ns_subwin_len(uint16_t min_track_len)
 {
-    RTAFE_LOG("Initializing Noise Suppressor with n_bins=%zu\n", n_bins);
-    if (state == NULL) return FE_ERR_NULL_PTR;
-
-    /* If power_min is already allocated (pre-allocated from scratch), 
-       just initialize it. Otherwise allocate it. */
-    if (state->power_min == NULL) {
-        /* Allocate minimum tracking buffer (one per bin) */
-        state->power_min = (q31_t *)malloc(n_bins * sizeof(q31_t));
-        if (state->power_min == NULL) return FE_ERR_NULL_PTR;
+    uint16_t len = (uint16_t)((min_track_len + NS_SUBWIN_COUNT - 1) / NS_SUBWIN_COUNT);
+    return len ? len : 1;
+}
+
+/* Ring rows folded per hop so the NS_SUBWIN_COUNT - 1 that survive the next
+   completion are all in by the sub-window's last hop */
+static inline size_t ns_fold_count(uint16_t sub_len)
+{
+    return (NS_SUBWIN_COUNT - 1 + (size_t)sub_len - 1) / sub_len;
+}
+
+/* Row offsets (elements) folded on hop @p count of the sub-window completing
+   into slot @p sub_idx: survivors are the other slots, taken round-robin;
+   a row folded twice is harmless (min is idempotent) */
+static inline size_t ns_fold_rows(size_t *offs, uint8_t sub_idx, uint16_t count,
+                                  uint16_t sub_len, size_t n_bins)
+{
+    size_t n_fold = ns_fold_count(sub_len);
+    for (size_t j = 0; j < n_fold; j++) {
+        size_t u = ((size_t)count * n_fold + j) % (NS_SUBWIN_COUNT - 1);
+        offs[j] = ((sub_idx + 1 + u) % NS_SUBWIN_COUNT) * n_bins;
     }
+    return n_fold;
+}
+
+fe_status_t noise_suppress_init(noise_suppress_state_t *state, ns_bin_t *bins, q31_t *sub_min,
+                                size_t n_bins)
+{
+    RTAFE_LOG("Initializing Noise Suppressor with n_bins=%zu\n", n_bins);
+    if (state == NULL || bins == NULL || sub_min == NULL) return FE_ERR_NULL_PTR;
+
+    /* Per-bin records and the minima ring are carved by the caller
+       (engine arena); the suppressor never allocates */
+    state->bins = bins;
+    state->sub_min = sub_min;
 
-    /* Initialize with maximum values (will be overwritten on first frames) */
+    /* Minimums start at maximum (overwritten on first frames) */
     for (size_t i = 0; i < n_bins; i++) {
-        state->power_min[i] = INT32_MAX;
+        bins[i].noise_est = 0;
+        bins[i].power_min = INT32_MAX;
+        bins[i].win_min = INT32_MAX;
+        bins[i].fold_min = INT32_MAX;
     }
+    for (size_t i = 0; i < NS_SUBWIN_COUNT * n_bins; i++) sub_min[i] = INT32_MAX;
 
     state->min_track_count = 0;
+    state->sub_idx = 0;
     state->total_power = 0;
 
     return FE_OK;
 }
 
-void noise_suppress_process(noise_suppress_state_t *state,
-                            const q31_t *fft_re,
-                            const q31_t *fft_im,
-                            q31_t       *noise_est,
-                            q15_t       *gain_out,
-                            size_t       n_bins,
-                            q15_t        over_sub,
-                            q15_t        floor,
-                            uint16_t     min_track_len)
+RTAFE_FAST_CODE void noise_suppress_power(const q31_t *fft_re,
+                          const q31_t *fft_im,
+                          q31_t       *power,
+                          size_t       n_bins)
 {
-    if (state == NULL || fft_re == NULL || fft_im == NULL) return;
-    
-    state->total_power = 0;
-    q31_t max_power = 0;
-
-    /* ─────────────────────────────────────────────────────────────────────
-       STEP 1: Power Spectrum Computation & Minimum Tracking
-       
-       For each frequency bin: Power[k] = |X[k]|² = Re[k]² + Im[k]²
-       Track bin-wise minimum over sliding window for noise floor.
-       ───────────────────────────────────────────────────────────────────── */
+    /* Power[k] = |X[k]|² = Re[k]² + Im[k]²
+       Q1.31 * Q1.31 = Q2.62 -> Shift back to Q1.31, saturate at unity */
     for (size_t i = 0; i < n_bins; i++) {
-        q31_t power = (fft_re[i] * fft_re[i]) + (fft_im[i] * fft_im[i]);
-
-        /* Track minimum over sliding window (Martin 1994) */
-        if (power < state->power_min[i]) {
-            state->power_min[i] = power;
-        }
-
-        /* Accumulate for frame energy estimation (for VAD-like decision) */
-        state->total_power += power;
-        if (power > max_power) max_power = power;
+        q63_t acc = ((q63_t)fft_re[i] * fft_re[i] + (q63_t)fft_im[i] * fft_im[i]) >> Q1_31_SHIFT;
+        power[i] = (acc > INT32_MAX) ? INT32_MAX : (q31_t)acc;
     }
+}
 
-    /* ─────────────────────────────────────────────────────────────────────
-       STEP 2: Energy-Based Activity Detection (Simple VAD)
-       
-       Compare frame energy against noise estimate to determine if current
-       frame contains speech transients. This prevents noise floor from
-       drifting upward during speech bursts (Sohn et al. 1999).
-       ───────────────────────────────────────────────────────────────────── */
-    q31_t avg_power = state->total_power / n_bins;
-    q31_t noise_estimate_avg = 0;
+RTAFE_FAST_CODE void noise_suppress_power_q15(const q15_t *spec,
+                              int          shift,
+                              q31_t       *power,
+                              size_t       n_bins)
+{
     for (size_t i = 0; i < n_bins; i++) {
-        noise_estimate_avg += noise_est[i];
+        /* <= 2^31: both components -1.0 */
+        uint64_t acc = (uint64_t)((int32_t)spec[2 * i] * spec[2 * i]) +
+                       (uint64_t)((int32_t)spec[2 * i + 1] * spec[2 * i + 1]);
+        if (shift >= 0) {
+            acc = (shift >= 32 || acc > ((uint64_t)INT32_MAX >> shift)) ? INT32_MAX : acc << shift;
+        } else {
+            acc = (shift <= -32) ? 0 : acc >> -shift;
+        }
+        power[i] = (acc > INT32_MAX) ? INT32_MAX : (q31_t)acc;
     }
-    noise_estimate_avg /= n_bins;
+}
+
+void noise_suppress_update(noise_suppress_state_t *state,
+                           const q31_t *power,
+                           size_t       n_bins,
+                           uint8_t      is_speech,
+                           uint16_t     min_track_len)
+{
+    if (state == NULL || power == NULL) return;
 
-    /* Activity threshold: if avg power > 1.5x noise estimate, likely speech
-       (Both average and peak must exceed threshold to avoid false positives) */
-    q31_t activity_threshold = (noise_estimate_avg * 3) >> 1;  /* 1.5x via bit shift */
-    int is_speech_frame = (avg_power > activity_threshold) && (max_power > activity_threshold);
+    ns_bin_t *bins = state->bins;
 
     /* ─────────────────────────────────────────────────────────────────────
-       STEP 3: Adaptive Noise Estimate Update
-       
-       Use two time constants:
+       STEP 1 + 2: Minimum Tracking and Adaptive Noise Estimate Update
+
+       One pass over the interleaved records: track the bin-wise minimum over
+       the sliding window (current sub-window's running minimum against the
+       completed sub-windows', Martin 2001), then smooth the running estimate
+       towards it with two time constants selected by the VAD decision:
        - Silence frames: α = 1/8 (fast adaptation to changing noise)
        - Speech frames: α = 1/16 (slow adaptation, preserve noise floor)
-       
+
        Blend minimum estimate (short-term floor) with current estimate
        (long-term drift tracking) for smooth convergence.
+
+       The same pass slides the window (STEP 3): the current sub-window's
+       running minimum is mirrored into its ring row, and the surviving
+       rows are folded a fixed number per hop into fold_min. The hop that
+       completes the sub-window takes min(fold_min, run) as the new window
+       minimum — no extra pass, so no hop costs more than another.
        ───────────────────────────────────────────────────────────────────── */
-    q15_t alpha_num, alpha_den;
-    if (is_speech_frame) {
-        alpha_num = 1;      /* 1/16 = 0.0625 (slower) */
-        alpha_den = 16;
-    } else {
-        alpha_num = 1;      /* 1/8 = 0.125 (faster) */
-        alpha_den = 8;
-    }
+    const int alpha_shift = is_speech ? 4 : 3;
+    const uint16_t sub_len = ns_subwin_len(min_track_len);
+    const uint16_t count = state->min_track_count;
+    const uint8_t complete = (uint16_t)(count + 1) >= sub_len;
+    const uint8_t first = (count == 0);
+    q31_t *cur = state->sub_min + (size_t)state->sub_idx * n_bins;
+    size_t offs[NS_SUBWIN_COUNT - 1];
+    size_t n_fold = ns_fold_rows(offs, state->sub_idx, count, sub_len, n_bins);
+    q63_t total_power = 0;
 
     for (size_t i = 0; i < n_bins; i++) {
-        q31_t power = (fft_re[i] * fft_re[i]) + (fft_im[i] * fft_im[i]);
+        q31_t p = power[i];
+        q31_t run = bins[i].power_min;
+        q31_t est = bins[i].noise_est;
+        q31_t fold = first ? INT32_MAX : bins[i].fold_min;
 
-        /* Use minimum estimate as base for better noise floor tracking */
-        q31_t min_est = state->power_min[i];
+        if (p < run) run = p;
+        for (size_t j = 0; j < n_fold; j++) {
+            q31_t r = state->sub_min[offs[j] + i];
+            fold = (r < fold) ? r : fold;
+        }
+        q63_t wmin = (run < bins[i].win_min) ? run : bins[i].win_min;
+        wmin *= NS_MIN_BIAS;
+        q31_t min_est = (wmin > INT32_MAX) ? INT32_MAX : (q31_t)wmin;
+        total_power += p;
 
         /* Blend minimum estimate with current noise estimate:
            - min_est tracks short-term floor (reliable during speech)
-           - noise_est[i] tracks long-term changes (slow background changes)
+           - est tracks long-term changes (slow background changes)
            - Average provides smooth balance */
-        q31_t blended = (min_est + noise_est[i]) >> 1;
+        q31_t blended = (q31_t)(((q63_t)min_est + est) >> 1);
 
         /* Update with adaptive smoothing:
-           noise_est[i] = 7/8 * noise_est[i] + 1/8 * blended
+           est = (1 - α) * est + α * blended
            (Avoids tracking speech spikes as noise) */
-        noise_est[i] = noise_est[i] - (noise_est[i] >> 3)  /* 7/8 * old */
-                       + (blended >> 3);                    /* 1/8 * blended */
-
-        /* ─────────────────────────────────────────────────────────────────
-           STEP 4: Spectral Subtraction Gain Computation
-           
-           Implements: Gain[k] = (Power[k] - α·NoiseEst[k]) / Power[k]
-           where α = over_sub (over-subtraction factor, typically 1.0-1.5)
-           
-           Bounded by spectral floor to prevent over-attenuation.
-           Output format Q6.9: 512 represents unity gain (no suppression).
-           ───────────────────────────────────────────────────────────────── */
+        q31_t next = est - (est >> alpha_shift) + (blended >> alpha_shift);
+
+        /* During speech, rise is capped at +1/16 per hop (~0.26 dB) so a
+           minimum that just aged out cannot pull speech energy into the floor */
+        if (is_speech) {
+            q31_t cap = est + (est >> 4) + 1;
+            if (next > cap) next = cap;
+        }
+
+        bins[i].noise_est = next;
+        cur[i] = run;
+        bins[i].fold_min = fold;
+        if (complete) bins[i].win_min = (run < fold) ? run : fold;
+        bins[i].power_min = complete ? INT32_MAX : run;
+    }
+    state->total_power = (total_power > INT32_MAX) ? INT32_MAX : (q31_t)total_power;
+
+    /* STEP 3: the window slides by one sub-window (~50ms if frame=10ms,
+       min_track_len=20) so the estimate can follow a slowly changing
+       acoustic environment; the next sub-window completes into the slot
+       of the now oldest row */
+    if (complete) state->sub_idx = (uint8_t)((state->sub_idx + 1) % NS_SUBWIN_COUNT);
+    state->min_track_count = complete ? 0 : (uint16_t)(count + 1);
+}
+
+RTAFE_FAST_CODE void noise_suppress_gain(const noise_suppress_state_t *state,
+                         const q31_t *power,
+                         q15_t       *gain_out,
+                         size_t       n_bins,
+                         q15_t        over_sub,
+                         q31_t        floor)
+{
+    const ns_bin_t *bins = state->bins;
+
+    /* ─────────────────────────────────────────────────────────────────────
+       Spectral Subtraction Gain Computation
+
+       Implements: Gain[k] = (Power[k] - α·NoiseEst[k]) / Power[k]
+       where α = over_sub (over-subtraction factor, typically 1.0-1.5)
+
+       Bounded by spectral floor to prevent over-attenuation.
+       Output format Q6.9: 512 represents unity gain (no suppression).
+       ───────────────────────────────────────────────────────────────────── */
+    for (size_t i = 0; i < n_bins; i++) {
         q15_t gain = 0;
-        if (power > floor) {
-            q31_t numerator = power - ((over_sub * noise_est[i]) >> 9);
+        if (power[i] > floor) {
+            q63_t numerator = (q63_t)power[i] - (((q63_t)over_sub * bins[i].noise_est) >> 9);
             if (numerator < floor) numerator = floor;
-            gain = (q15_t)((numerator << 9) / (power + 1)); /* Q6.9 */
+            /* numerator <= power, so the quotient fits Q6.9 */
+            gain = (q15_t)fx_div_u32((uint32_t)numerator, (uint32_t)power[i] + 1u, 9);
         }
         gain_out[i] = gain;
     }
+}
 
-    /* ─────────────────────────────────────────────────────────────────────
-       STEP 5: Periodic Minimum Tracker Reset
-       
-       Every min_track_len frames (~200ms if frame=10ms, min_track_len=20),
-       reset minimums to restart minimum search. This allows noise estimate
-       to adapt to slowly changing acoustic environment.
-       ───────────────────────────────────────────────────────────────────── */
-    state->min_track_count++;
-    if (state->min_track_count >= min_track_len) {
-        /* Reset minimums for next tracking window */
-        for (size_t i = 0; i < n_bins; i++) {
-            state->power_min[i] = INT32_MAX;
+void noise_suppress_process(noise_suppress_state_t *state,
+                            const q31_t *power,
+                            q15_t       *gain_out,
+                            size_t       n_bins,
+                            uint8_t      is_speech,
+                            q15_t        over_sub,
+                            q31_t        floor,
+                            uint16_t     min_track_len)
+{
+    if (state == NULL || power == NULL) return;
+
+    noise_suppress_update(state, power, n_bins, is_speech, min_track_len);
+    noise_suppress_gain(state, power, gain_out, n_bins, over_sub, floor);
+}
+
+/* ── float32 variant ────────────────────────────────────────────────────── */
+
+fe_status_t noise_suppress_init_f32(noise_suppress_f32_t *state, ns_bin_f32_t *bins, float *sub_min,
+                                    size_t n_bins)
+{
+    RTAFE_LOG("Initializing float Noise Suppressor with n_bins=%zu\n", n_bins);
+    if (state == NULL || bins == NULL || sub_min == NULL) return FE_ERR_NULL_PTR;
+
+    state->bins = bins;
+    state->sub_min = sub_min;
+    for (size_t i = 0; i < n_bins; i++) {
+        bins[i].noise_est = 0.0f;
+        bins[i].power_min = FLT_MAX;
+        bins[i].win_min = FLT_MAX;
+        bins[i].fold_min = FLT_MAX;
+    }
+    for (size_t i = 0; i < NS_SUBWIN_COUNT * n_bins; i++) sub_min[i] = FLT_MAX;
+    state->min_track_count = 0;
+    state->sub_idx = 0;
+    state->total_power = 0.0f;
+
+    return FE_OK;
+}
+
+void noise_suppress_power_f32(const float *fft_re,
+                              const float *fft_im,
+                              float       *power,
+                              size_t       n_bins)
+{
+    for (size_t i = 0; i < n_bins; i++) {
+        power[i] = fft_re[i] * fft_re[i] + fft_im[i] * fft_im[i];
+    }
+}
+
+void noise_suppress_update_f32(noise_suppress_f32_t *state,
+                               const float *power,
+                               size_t       n_bins,
+                               uint8_t      is_speech,
+                               uint16_t     min_track_len)
+{
+    if (state == NULL || power == NULL) return;
+
+    ns_bin_f32_t *bins = state->bins;
+    const float alpha = is_speech ? (1.0f / 16.0f) : (1.0f / 8.0f);
+    const uint16_t sub_len = ns_subwin_len(min_track_len);
+    const uint16_t count = state->min_track_count;
+    const uint8_t complete = (uint16_t)(count + 1) >= sub_len;
+    const uint8_t first = (count == 0);
+    float *cur = state->sub_min + (size_t)state->sub_idx * n_bins;
+    size_t offs[NS_SUBWIN_COUNT - 1];
+    size_t n_fold = ns_fold_rows(offs, state->sub_idx, count, sub_len, n_bins);
+    float total_power = 0.0f;
+
+    for (size_t i = 0; i < n_bins; i++) {
+        float p = power[i];
+        float run = bins[i].power_min;
+        float est = bins[i].noise_est;
+        float fold = first ? FLT_MAX : bins[i].fold_min;
+
+        if (p < run) run = p;
+        for (size_t j = 0; j < n_fold; j++) {
+            float r = state->sub_min[offs[j] + i];
+            fold = (r < fold) ? r : fold;
+        }
+        float min_est = NS_MIN_BIAS * ((run < bins[i].win_min) ? run : bins[i].win_min);
+        total_power += p;
+
+        float blended = 0.5f * (min_est + est);
+        float next = est + alpha * (blended - est);
+
+        /* Speech rise cap, +1/16 per hop (one Q1.31 LSB of slack as in
+           the fixed-point path) */
+        if (is_speech) {
+            float cap = est * (17.0f / 16.0f) + 0x1p-31f;
+            if (next > cap) next = cap;
         }
-        state->min_track_count = 0;
+
+        bins[i].noise_est = next;
+        cur[i] = run;
+        bins[i].fold_min = fold;
+        if (complete) bins[i].win_min = (run < fold) ? run : fold;
+        bins[i].power_min = complete ? FLT_MAX : run;
+    }
+    state->total_power = total_power;
+
+    if (complete) state->sub_idx = (uint8_t)((state->sub_idx + 1) % NS_SUBWIN_COUNT);
+    state->min_track_count = complete ? 0 : (uint16_t)(count + 1);
+}
+
+/** 1/x for x > 0 without a divide: exponent-flip seed + 2 Newton steps (~1e-5 rel). */
+static inline float ns_rcp_f32(float x)
+{
+    union { float f; uint32_t u; } v = { x };
+    v.u = 0x7EF311C3u - v.u;
+    float r = v.f;
+    r = r * (2.0f - x * r);
+    r = r * (2.0f - x * r);
+    return r;
+}
+
+void noise_suppress_gain_f32(const noise_suppress_f32_t *state,
+                             const float *power,
+                             float       *gain_out,
+                             size_t       n_bins,
+                             float        over_sub,
+                             float        floor)
+{
+    const ns_bin_f32_t *bins = state->bins;
+
+    /* Gain[k] = max(P[k] - α·N[k], floor) / P[k], 0 where P[k] <= floor */
+    for (size_t i = 0; i < n_bins; i++) {
+        float p = power[i];
+        float num = p - over_sub * bins[i].noise_est;
+        if (num < floor) num = floor;
+        gain_out[i] = (p > floor) ? num * ns_rcp_f32(p) : 0.0f;
     }
-}
\ No newline at end of file
+}
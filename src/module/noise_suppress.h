@@ -8,7 +8,7 @@
  * ALGORITHM BASIS:
  * - Minimum-tracking noise estimation (Martin 1994, Sohn et al. 1999)
  * - Speech-aware smoothing to avoid tracking speech transients
- * - Energy-based voice activity detection (VAD-like)
+ * - Speech/non-speech decision supplied by the standalone VAD (vad.h)
  * - Fixed-point arithmetic for ARM Cortex-M, RISC-V, and DSP cores
  *
  * REFERENCES:
@@ -19,6 +19,9 @@
  * [3] Dabov, K., Foi, A., & Katkovnik, V. (2011). "Audio denoising by time-
  *     frequency block thresholding." In Audio Signal Processing for Next-Generation
  *     Multimedia Communication (pp. 297-326).
+ * [4] Martin, R. (2001). "Noise power spectral density estimation based on
+ *     optimal smoothing and minimum statistics." IEEE Trans. Speech Audio
+ *     Process., 9(5), 504-512.
  *
  * SUITABLE FOR:
  * - Real-time audio processing on embedded devices (< 50ms latency)
@@ -30,44 +33,199 @@
 
 #include "rtafe/fe_types.h"
 
+/**
+ * Minimum statistics window, split into sub-windows (Martin 2001): the
+ * minimum over the last min_track_len frames is the minimum of the
+ * NS_SUBWIN_COUNT most recent completed sub-window minima and the running
+ * minimum of the current one. When a sub-window completes its minimum
+ * replaces the oldest slot of a small per-bin ring, so the window slides
+ * by a sub-window at a time and the floor never jumps back to "no
+ * minimum" as a periodic full reset would.
+ *
+ * The minimum of the rows that survive the next completion is folded one
+ * row per hop while the current sub-window runs, so the completing hop
+ * only combines it with the running minimum: every hop does the same
+ * work, no hop pays for a fold over the whole ring.
+ */
+#define NS_SUBWIN_COUNT 4
+
+/**
+ * Bias compensation applied to the window minimum. The minimum of D raw
+ * periodogram frames sits near mean / D; a full window of ~20 frames is
+ * roughly 3x deeper than the average of the old reset-every-window
+ * tracker, whose level the VAD threshold and over-subtraction are tuned to.
+ */
+#define NS_MIN_BIAS 3
+
+/**
+ * Per-bin noise tracking record. The running estimate and the minima are
+ * read and written together on every hop, so they are stored interleaved
+ * and one streaming pass touches a single array.
+ */
+typedef struct {
+    q31_t noise_est;          /**< Running noise estimate (Q1.31) */
+    q31_t power_min;          /**< Running minimum of the current sub-window */
+    q31_t win_min;            /**< Minimum over the completed sub-windows in the ring */
+    q31_t fold_min;           /**< Surviving ring rows folded so far (next win_min) */
+} ns_bin_t;
+
+/** Stride of ns_bin_t::noise_est in q31_t units, for strided readers (VAD). */
+#define NS_BIN_STRIDE (sizeof(ns_bin_t) / sizeof(q31_t))
+
 /**
  * Noise suppression state for speech-aware adaptive estimation.
  * Maintains minimal state for embedded devices.
  */
 typedef struct {
-    q31_t *power_min;         /**< Minimum power estimate per bin */
-    uint16_t min_track_count; /**< Frame counter for minimum tracking */
-    q31_t total_power;        /**< Total frame power for VAD-like decision */
+    ns_bin_t *bins;           /**< Per-bin noise estimate + minima */
+    q31_t *sub_min;           /**< [NS_SUBWIN_COUNT][n_bins] sub-window minima, the current one running */
+    uint16_t min_track_count; /**< Frames into the current sub-window */
+    uint8_t sub_idx;          /**< Ring slot the current sub-window completes into */
+    q31_t total_power;        /**< Total frame power (saturating) */
 } noise_suppress_state_t;
 
 /**
  * Initialize noise suppression state.
  * @param state       State structure to initialize
+ * @param bins        Caller-provided storage for n_bins records (arena slice)
+ * @param sub_min     Caller-provided storage for NS_SUBWIN_COUNT * n_bins
+ *                    minima, one contiguous row per sub-window
  * @param n_bins      Number of frequency bins
- * @return FE_OK on success, FE_ERR_NULL_PTR if state is NULL
+ * @return FE_OK on success, FE_ERR_NULL_PTR if state, bins or sub_min is NULL
  */
-fe_status_t noise_suppress_init(noise_suppress_state_t *state, size_t n_bins);
+fe_status_t noise_suppress_init(noise_suppress_state_t *state, ns_bin_t *bins, q31_t *sub_min,
+                                size_t n_bins);
+
+/**
+ * Compute the per-bin power spectrum |X[k]|^2 = Re[k]^2 + Im[k]^2 (Q1.31,
+ * saturating). Shared by the VAD and the suppressor so it runs once per hop.
+ *
+ * @param fft_re      Real FFT values (Q1.31)
+ * @param fft_im      Imaginary FFT values (Q1.31)
+ * @param power       Output power per bin (n_bins)
+ * @param n_bins      Number of frequency bins
+ */
+void noise_suppress_power(const q31_t *fft_re,
+                          const q31_t *fft_im,
+                          q31_t       *power,
+                          size_t       n_bins);
+
+/**
+ * noise_suppress_power() from an interleaved Q1.15 spectrum
+ * (fft_radix2_q15 layout). |X[k]|^2 is formed exactly in 32 bits, then
+ * shifted by @p shift (negative: right) into the Q1.31 power units of the
+ * Q1.31 path and saturated.
+ *
+ * @param spec        Interleaved re, im bins (at least n_bins pairs)
+ * @param shift       Left shift of |X|^2 into Q1.31 power units
+ * @param power       Output power per bin (n_bins)
+ * @param n_bins      Number of bins
+ */
+void noise_suppress_power_q15(const q15_t *spec,
+                              int          shift,
+                              q31_t       *power,
+                              size_t       n_bins);
+
+/**
+ * Update minimum tracker and running noise estimate from the power spectrum.
+ * Speech/non-speech decision comes from the standalone VAD (vad.h).
+ * O(n_bins) every hop, the same on every hop: one pass over the records,
+ * the current sub-window's ring row and ceil((NS_SUBWIN_COUNT - 1) /
+ * sub-window length) other rows folded towards the next window minimum.
+ *
+ * @param state       Noise suppression state (per-bin records updated in-place)
+ * @param power       Power spectrum of the current frame (n_bins)
+ * @param n_bins      Number of frequency bins
+ * @param is_speech   Non-zero if the VAD flagged this hop as speech
+ * @param min_track_len  Minimum tracking window length (frames) - suggest 15-25;
+ *                       sub-windows are ceil(min_track_len / NS_SUBWIN_COUNT)
+ */
+void noise_suppress_update(noise_suppress_state_t *state,
+                           const q31_t *power,
+                           size_t       n_bins,
+                           uint8_t      is_speech,
+                           uint16_t     min_track_len);
+
+/**
+ * Spectral subtraction gain from power and noise estimate.
+ *
+ * @param state       Noise suppression state (reads the noise estimate)
+ * @param power       Power spectrum of the current frame (n_bins)
+ * @param gain_out    Output suppression gain per bin (Q6.9)
+ * @param n_bins      Number of frequency bins
+ * @param over_sub    Over-subtraction factor (Q6.9)
+ * @param floor       Spectral floor, Q1.31 power: bins at or below it get gain 0
+ */
+void noise_suppress_gain(const noise_suppress_state_t *state,
+                         const q31_t *power,
+                         q15_t       *gain_out,
+                         size_t       n_bins,
+                         q15_t        over_sub,
+                         q31_t        floor);
 
 /**
  * Update noise estimate and compute spectral suppression gain.
- * Uses speech-aware adaptive tracking for better embedded performance.
+ * Convenience wrapper: noise_suppress_update() + noise_suppress_gain().
  *
  * @param state       Noise suppression state (maintains tracking statistics)
- * @param fft_re      Real FFT values
- * @param fft_im      Imaginary FFT values
- * @param noise_est   Running noise estimate (n_bins, updated in-place)
+ * @param power       Power spectrum of the current frame (n_bins)
  * @param gain_out    Output suppression gain per bin (Q6.9)
  * @param n_bins      Number of frequency bins
+ * @param is_speech   Non-zero if the VAD flagged this hop as speech
  * @param over_sub    Over-subtraction factor (Q6.9)
- * @param floor       Spectral floor minimum
+ * @param floor       Spectral floor, Q1.31 power
  * @param min_track_len  Minimum tracking window length (frames) - suggest 15-25
  */
 void noise_suppress_process(noise_suppress_state_t *state,
-                            const q31_t *fft_re,
-                            const q31_t *fft_im,
-                            q31_t       *noise_est,
+                            const q31_t *power,
                             q15_t       *gain_out,
                             size_t       n_bins,
+                            uint8_t      is_speech,
                             q15_t        over_sub,
-                            q15_t        floor,
+                            q31_t        floor,
                             uint16_t     min_track_len);
+
+/* ── float32 variant (FE_PRECISION_F32 hop path) ────────────────────────── */
+
+typedef struct {
+    float noise_est;
+    float power_min;
+    float win_min;
+    float fold_min;
+} ns_bin_f32_t;
+
+#define NS_BIN_F32_STRIDE (sizeof(ns_bin_f32_t) / sizeof(float))
+
+typedef struct {
+    ns_bin_f32_t *bins;
+    float *sub_min;
+    uint16_t min_track_count;
+    uint8_t sub_idx;
+    float total_power;
+} noise_suppress_f32_t;
+
+fe_status_t noise_suppress_init_f32(noise_suppress_f32_t *state, ns_bin_f32_t *bins, float *sub_min,
+                                    size_t n_bins);
+
+void noise_suppress_power_f32(const float *fft_re,
+                              const float *fft_im,
+                              float       *power,
+                              size_t       n_bins);
+
+/** Same smoothing constants and speech cap as noise_suppress_update(). */
+void noise_suppress_update_f32(noise_suppress_f32_t *state,
+                               const float *power,
+                               size_t       n_bins,
+                               uint8_t      is_speech,
+                               uint16_t     min_track_len);
+
+/**
+ * Spectral subtraction gain (linear, 1.0 = unity), division-free: 1/P[k]
+ * comes from a bit-trick seed refined by two Newton steps.
+ */
+void noise_suppress_gain_f32(const noise_suppress_f32_t *state,
+                             const float *power,
+                             float       *gain_out,
+                             size_t       n_bins,
+                             float        over_sub,
+                             float        floor);
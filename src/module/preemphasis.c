@@ -1,6 +1,10 @@
 #include "preemphasis.h"
 /* preemphasis.c */
 
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
 void pre_emphasis_init(PreEmphasis *filt, q15_t alpha_q15)
 {
     RTAFE_LOG("Initializing PreEmphasis filter with alpha_q15=0x%04X\n", (uint16_t)alpha_q15);
@@ -8,15 +12,22 @@ void pre_emphasis_init(PreEmphasis *filt, q15_t alpha_q15)
     filt->alpha_q15 = alpha_q15;
 }
 
-q15_t pre_emphasis_process(PreEmphasis *filt, q15_t x)
+RTAFE_FAST_CODE q15_t pre_emphasis_process(PreEmphasis *filt, q15_t x)
 {
     /** Difference equation for Direct Form I
      * y[n] = x[n] - alpha * x[n - 1]
      */
 
-    int32_t acc, mul;
+    int32_t mul;
     q15_t out;
 
+#if defined(__ARM_FEATURE_DSP)
+    /** SMULBB + SSAT: same truncation and clamp as the generic path */
+    mul = __smulbb(filt->alpha_q15, filt->x_prev) >> Q1_15_SHIFT;
+    out = (q15_t)__ssat((int32_t)x - mul, 16);
+#else
+    int32_t acc;
+
     mul = (int32_t)filt->alpha_q15 * (int32_t)filt->x_prev;
 
     /** Q1.15 * Q1.15 = Q2.30 -> Shift back to Q1.15 */
@@ -28,8 +39,16 @@ q15_t pre_emphasis_process(PreEmphasis *filt, q15_t x)
     else if (acc < INT16_MIN) acc = INT16_MIN;
 
     out = (q15_t)acc;
+#endif
 
     filt->x_prev = x;
 
     return out;
-}
\ No newline at end of file
+}
+
+void pre_emphasis_init_f32(PreEmphasisF32 *filt, float alpha)
+{
+    RTAFE_LOG("Initializing PreEmphasisF32 filter with alpha=%f\n", alpha);
+    filt->x_prev = 0.0f;
+    filt->alpha = alpha;
+}
@@ -2,7 +2,7 @@
 #pragma once
 
 #include <stdint.h>
-#include "fe_types.h"
+#include "rtafe/fe_types.h"
 
 typedef struct {
     /** Alpha need to be recomputed -> Choose appropriate alpha depend on your application */
@@ -12,4 +12,20 @@ typedef struct {
 
 /** Direct form I from Richard Lyons */
 q15_t pre_emphasis_process(PreEmphasis *filt, q15_t x);
-void pre_emphasis_init(PreEmphasis *filt, q15_t alpha_q15);
\ No newline at end of file
+void pre_emphasis_init(PreEmphasis *filt, q15_t alpha_q15);
+
+/* float32 variant (FE_PRECISION_F32 hop path) */
+typedef struct {
+    float alpha;
+    float x_prev;
+} PreEmphasisF32;
+
+void pre_emphasis_init_f32(PreEmphasisF32 *filt, float alpha);
+
+/** y[n] = x[n] - alpha * x[n - 1] */
+static inline float pre_emphasis_process_f32(PreEmphasisF32 *filt, float x)
+{
+    float y = x - filt->alpha * filt->x_prev;
+    filt->x_prev = x;
+    return y;
+}
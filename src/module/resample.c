@@ -0,0 +1,152 @@
+#include "resample.h"
+#include <math.h>
+#include <string.h>
+/* resample.c */
+
+static uint32_t gcd_u32(uint32_t a, uint32_t b)
+{
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+fe_status_t resample_geometry(uint32_t fs_in, uint32_t fs_out,
+                              uint16_t *L, uint16_t *M, uint16_t *taps)
+{
+    if (fs_in == 0 || fs_out == 0) return FE_ERR_BAD_CONFIG;
+
+    uint32_t g = gcd_u32(fs_in, fs_out);
+    uint32_t l = fs_out / g;
+    uint32_t m = fs_in / g;
+    if (l > RS_MAX_PHASES || m > UINT16_MAX) return FE_ERR_BAD_CONFIG;
+
+    /* Keep the transition band constant relative to the lower rate:
+       decimating by M/L needs M/L times more taps per branch */
+    uint32_t ratio = (m > l) ? (m + l - 1) / l : 1;
+
+    if (L) *L = (uint16_t)l;
+    if (M) *M = (uint16_t)m;
+    if (taps) *taps = (uint16_t)(RS_TAPS_PER_RATIO * ratio);
+    return FE_OK;
+}
+
+fe_status_t resample_bank_init(resample_bank_t *bank, uint32_t fs_in, uint32_t fs_out,
+                               q15_t *coeffs)
+{
+    RTAFE_LOG("Initializing resampler bank %u -> %u Hz\n", fs_in, fs_out);
+    if (bank == NULL || coeffs == NULL) return FE_ERR_NULL_PTR;
+
+    uint16_t L, M, taps;
+    fe_status_t st = resample_geometry(fs_in, fs_out, &L, &M, &taps);
+    if (st != FE_OK) return st;
+
+    /** Prototype at the upsampled rate L*fs_in:
+     *  h[i] = 2fc * sinc(2fc * (i - c)) * blackman(i),  fc = cutoff / (2 * max(L, M))
+     */
+    const size_t n = (size_t)L * taps;
+    const double c = (n - 1) * 0.5;
+    const double fc = RS_CUTOFF * 0.5 / (L > M ? L : M);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i - c;
+        double x = 2.0 * M_PI * fc * t;
+        double sinc = (t == 0.0) ? 2.0 * fc : sin(x) / (M_PI * t);
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * i / (n - 1))
+                        + 0.08 * cos(4.0 * M_PI * i / (n - 1));
+        sum += sinc * w;
+    }
+    /* Unity passband gain per output: each branch sums to ~1 → total = L */
+    const double scale = (double)L / sum;
+
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i - c;
+        double x = 2.0 * M_PI * fc * t;
+        double sinc = (t == 0.0) ? 2.0 * fc : sin(x) / (M_PI * t);
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * i / (n - 1))
+                        + 0.08 * cos(4.0 * M_PI * i / (n - 1));
+        double q = floor(sinc * w * scale * 32768.0 + 0.5);
+        if (q > INT16_MAX) q = INT16_MAX;
+        else if (q < INT16_MIN) q = INT16_MIN;
+
+        /* Branch p = i % L, tap k = i / L (k = 0 → newest input).
+           Store time-reversed so the dot product walks oldest → newest. */
+        size_t p = i % L;
+        size_t k = i / L;
+        coeffs[p * taps + (taps - 1 - k)] = (q15_t)q;
+    }
+
+    bank->L = L;
+    bank->M = M;
+    bank->taps = taps;
+    bank->coeffs = coeffs;
+    return FE_OK;
+}
+
+fe_status_t resample_init(resample_state_t *rs, const resample_bank_t *bank, q15_t *hist)
+{
+    if (rs == NULL || bank == NULL || hist == NULL) return FE_ERR_NULL_PTR;
+
+    rs->bank = bank;
+    rs->hist = hist;
+    rs->pos = 0;
+    rs->phase = 0;
+    memset(hist, 0, 2 * bank->taps * sizeof(q15_t));
+    return FE_OK;
+}
+
+size_t resample_max_out(const resample_bank_t *bank, size_t n_in)
+{
+    return (n_in * bank->L + bank->M - 1) / bank->M + 1;
+}
+
+size_t resample_process(resample_state_t *rs,
+                        const q15_t *in, size_t n_in, size_t in_stride,
+                        q15_t *out, size_t out_stride)
+{
+    const resample_bank_t *bank = rs->bank;
+    const uint16_t L = bank->L;
+    const uint16_t M = bank->M;
+    const uint16_t taps = bank->taps;
+    q15_t *hist = rs->hist;
+    uint16_t pos = rs->pos;
+    uint16_t phase = rs->phase;
+    size_t n_out = 0;
+
+    for (size_t i = 0; i < n_in; i++) {
+        /* Push newest sample into both halves of the ring */
+        pos = (uint16_t)((pos + 1 == taps) ? 0 : pos + 1);
+        q15_t x = in[i * in_stride];
+        hist[pos] = x;
+        hist[pos + taps] = x;
+
+        /* Window oldest → newest is contiguous: hist[pos + 1 .. pos + taps] */
+        const q15_t *win = &hist[pos + 1];
+
+        while (phase < L) {
+            const q15_t *h = &bank->coeffs[(size_t)phase * taps];
+
+            /** Q1.15 * Q1.15 = Q2.30, accumulate wide then round back to Q1.15 */
+            q63_t acc = 0;
+            for (uint16_t k = 0; k < taps; k++) {
+                acc += (int32_t)h[k] * win[k];
+            }
+            acc = (acc + (1 << 14)) >> Q1_15_SHIFT;
+
+            if (acc > INT16_MAX) acc = INT16_MAX;
+            else if (acc < INT16_MIN) acc = INT16_MIN;
+
+            out[n_out * out_stride] = (q15_t)acc;
+            n_out++;
+            phase += M;
+        }
+        phase -= L;
+    }
+
+    rs->pos = pos;
+    rs->phase = phase;
+    return n_out;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file resample.h
+ * @brief Rational polyphase FIR sample-rate converter (Q1.15).
+ *
+ * Converts fs_in → fs_out with L/M = fs_out/fs_in reduced by gcd, e.g.
+ *   48000 → 16000 : L = 1,   M = 3
+ *   16000 → 48000 : L = 3,   M = 1
+ *   44100 → 16000 : L = 160, M = 441
+ *
+ * ALGORITHM:
+ * - Windowed-sinc (Blackman) prototype of L * taps coefficients, cutoff at
+ *   RS_CUTOFF of the lower Nyquist, split into L polyphase branches
+ * - Only the branch that lands on an output instant is evaluated, so the
+ *   cost is `taps` MACs per output sample regardless of L
+ * - History is a double-written ring (2 * taps) so each dot product reads
+ *   one contiguous window — no modulo in the inner loop
+ *
+ * The coefficient bank is designed once at init into caller memory and is
+ * read-only afterwards; it can be shared by all channels with the same
+ * ratio. Each channel owns its own history and phase.
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+
+#define RS_MAX_PHASES     256    /**< Upper bound on L after gcd reduction */
+#define RS_TAPS_PER_RATIO 16     /**< Taps per branch per unit of max(L,M)/L */
+#define RS_CUTOFF         0.90f  /**< Passband edge, fraction of lower Nyquist */
+
+typedef struct {
+    uint16_t L;              /**< Interpolation factor */
+    uint16_t M;              /**< Decimation factor */
+    uint16_t taps;           /**< Taps per polyphase branch */
+    const q15_t *coeffs;     /**< [L][taps] branch-major, time-reversed */
+} resample_bank_t;
+
+typedef struct {
+    const resample_bank_t *bank;
+    q15_t   *hist;           /**< Double-written history, 2 * taps */
+    uint16_t pos;            /**< Index of newest sample in hist[0, taps) */
+    uint16_t phase;          /**< Next output position relative to newest input, in 1/L */
+} resample_state_t;
+
+/**
+ * Reduce fs_out/fs_in and report the bank geometry.
+ * @return FE_OK, or FE_ERR_BAD_CONFIG if L exceeds RS_MAX_PHASES or a rate is 0
+ */
+fe_status_t resample_geometry(uint32_t fs_in, uint32_t fs_out,
+                              uint16_t *L, uint16_t *M, uint16_t *taps);
+
+/**
+ * Design the polyphase coefficient bank.
+ * @param bank     Bank to fill
+ * @param fs_in    Input rate (Hz)
+ * @param fs_out   Output rate (Hz)
+ * @param coeffs   Storage for L * taps coefficients (see resample_geometry)
+ */
+fe_status_t resample_bank_init(resample_bank_t *bank, uint32_t fs_in, uint32_t fs_out,
+                               q15_t *coeffs);
+
+/**
+ * Bind a channel to a bank and clear its history.
+ * @param hist     Storage for 2 * bank->taps samples
+ */
+fe_status_t resample_init(resample_state_t *rs, const resample_bank_t *bank, q15_t *hist);
+
+/** Upper bound on output samples produced from n_in input samples. */
+size_t resample_max_out(const resample_bank_t *bank, size_t n_in);
+
+/**
+ * Convert a block of one channel.
+ *
+ * @param rs          Channel state
+ * @param in          Input samples (stride @p in_stride for interleaved data)
+ * @param n_in        Number of input samples
+ * @param in_stride   Distance between consecutive input samples
+ * @param out         Output samples (stride @p out_stride)
+ * @param out_stride  Distance between consecutive output samples
+ * @return            Number of output samples written
+ */
+size_t resample_process(resample_state_t *rs,
+                        const q15_t *in, size_t n_in, size_t in_stride,
+                        q15_t *out, size_t out_stride);
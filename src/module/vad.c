@@ -0,0 +1,122 @@
+#include "vad.h"
+#include <math.h>
+/* vad.c */
+
+/** Q8 log2 via leading-zero count + linear mantissa (max error ~0.086). */
+static inline int32_t log2_q8(uint64_t x)
+{
+    if (x == 0) return 0;
+    int msb = 63 - __builtin_clzll(x);
+    uint32_t frac = (msb >= 8) ? (uint32_t)(x >> (msb - 8))
+                               : (uint32_t)(x << (8 - msb));
+    return (msb << 8) + (int32_t)(frac & 0xFF);
+}
+
+/** Probability smoothing, start-up hold-off and hangover from the mean band SNR. */
+static uint8_t vad_decide(vad_state_t *vad, int32_t snr_mean)
+{
+    /* ── Probability: linear ramp, 0.5 at threshold, smoothed over hops ─── */
+    int32_t raw = (snr_mean * 32767) / (2 * vad->threshold_q8);
+    if (raw > 32767) raw = 32767;
+    vad->prob_q15 = (q15_t)(vad->prob_q15 + ((raw - vad->prob_q15) >> 2));
+
+    /* ── Decision with start-up hold-off and hangover ───────────────────── */
+    uint8_t active = (snr_mean > vad->threshold_q8);
+    if (vad->hop_count < VAD_INIT_HOPS) {
+        vad->hop_count++;
+        active = 0;
+    }
+
+    if (active) {
+        vad->hangover_cnt = vad->hangover_len;
+        vad->is_speech = 1;
+    } else if (vad->hangover_cnt > 0) {
+        vad->hangover_cnt--;
+        vad->is_speech = 1;
+    } else {
+        vad->is_speech = 0;
+    }
+
+    return vad->is_speech;
+}
+
+fe_status_t vad_init(vad_state_t *vad, q15_t threshold_q8, uint16_t hangover_len)
+{
+    RTAFE_LOG("Initializing VAD with threshold_q8=%d hangover=%u\n", threshold_q8, hangover_len);
+    if (vad == NULL) return FE_ERR_NULL_PTR;
+
+    vad->threshold_q8 = (threshold_q8 > 0) ? threshold_q8 : VAD_DEFAULT_THRESH;
+    vad->prob_q15     = 0;
+    vad->hangover_len = hangover_len;
+    vad->hangover_cnt = 0;
+    vad->hop_count    = 0;
+    vad->is_speech    = 0;
+
+    return FE_OK;
+}
+
+uint8_t vad_process(vad_state_t *vad,
+                    const q31_t *power,
+                    const q31_t *noise_est,
+                    size_t       noise_stride,
+                    size_t       n_bins)
+{
+    if (vad == NULL || power == NULL || noise_est == NULL || n_bins < 2) return 0;
+
+    /* ── Sub-band SNR: one pass of band sums, skip DC bin ───────────────── */
+    size_t n_bands = VAD_NUM_BANDS;
+    if (n_bins - 1 < n_bands) n_bands = n_bins - 1;
+    size_t band_w = (n_bins - 1) / n_bands;
+
+    int32_t snr_sum = 0;
+    size_t k = 1;
+    for (size_t b = 0; b < n_bands; b++) {
+        size_t end = (b == n_bands - 1) ? n_bins : k + band_w;
+        uint64_t p_band = 0, n_band = 1;   /* +1 keeps log2 defined */
+        for (; k < end; k++) {
+            p_band += (uint32_t)power[k];
+            n_band += (uint32_t)noise_est[k * noise_stride];
+        }
+
+        int32_t snr = log2_q8(p_band) - log2_q8(n_band) - VAD_NOISE_BIAS_Q8;
+        if (snr < 0) snr = 0;
+        else if (snr > VAD_SNR_MAX_Q8) snr = VAD_SNR_MAX_Q8;
+        snr_sum += snr;
+    }
+    int32_t snr_mean = snr_sum / (int32_t)n_bands;
+
+    return vad_decide(vad, snr_mean);
+}
+
+uint8_t vad_process_f32(vad_state_t *vad,
+                        const float *power,
+                        const float *noise_est,
+                        size_t       noise_stride,
+                        size_t       n_bins)
+{
+    if (vad == NULL || power == NULL || noise_est == NULL || n_bins < 2) return 0;
+
+    /* Same bands and Q8 log2 units as vad_process(); the 2^-31 offsets
+       stand in for the fixed-point path's one-LSB floor */
+    size_t n_bands = VAD_NUM_BANDS;
+    if (n_bins - 1 < n_bands) n_bands = n_bins - 1;
+    size_t band_w = (n_bins - 1) / n_bands;
+
+    int32_t snr_sum = 0;
+    size_t k = 1;
+    for (size_t b = 0; b < n_bands; b++) {
+        size_t end = (b == n_bands - 1) ? n_bins : k + band_w;
+        float p_band = 0x1p-31f, n_band = 0x1p-31f;
+        for (; k < end; k++) {
+            p_band += power[k];
+            n_band += noise_est[k * noise_stride];
+        }
+
+        int32_t snr = (int32_t)(256.0f * log2f(p_band / n_band)) - VAD_NOISE_BIAS_Q8;
+        if (snr < 0) snr = 0;
+        else if (snr > VAD_SNR_MAX_Q8) snr = VAD_SNR_MAX_Q8;
+        snr_sum += snr;
+    }
+
+    return vad_decide(vad, snr_sum / (int32_t)n_bands);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file vad.h
+ * @brief Low-cost sub-band SNR voice activity detector with hangover.
+ *
+ * Runs once per hop on the power spectrum already computed for noise
+ * suppression and reuses the suppressor's running noise estimate, so the
+ * only extra work is one pass of band sums plus VAD_NUM_BANDS log2 lookups.
+ *
+ * DECISION:
+ * - Bins [1, n_bins) are split into VAD_NUM_BANDS equal bands
+ * - Per band: snr_b = log2(P_b / N_b) - bias, clamped to [0, VAD_SNR_MAX_Q8];
+ *   the bias undoes the downward bias of the minimum-statistics estimate
+ * - Mean band SNR > threshold → speech; hangover keeps the flag set for
+ *   a few hops after the last speech hop so word tails are not clipped
+ * - The first VAD_INIT_HOPS hops are forced to non-speech so the noise
+ *   estimate can converge with fast adaptation
+ *
+ * Q-FORMAT NOTES:
+ * - Band SNR / threshold: Q8 log2 units (256 = 3.01 dB)
+ * - Speech probability: Q1.15 (32767 = certain speech)
+ */
+#pragma once
+
+#include "rtafe/fe_types.h"
+
+#define VAD_NUM_BANDS        8
+#define VAD_INIT_HOPS        8      /**< Forced-silence hops at start-up */
+#define VAD_SNR_MAX_Q8       (8 << 8)  /**< Clamp band SNR at ~24 dB */
+#define VAD_NOISE_BIAS_Q8    640    /**< Min-statistics bias, 2.5 in Q8 log2 ≈ 7.5 dB */
+#define VAD_DEFAULT_THRESH   384    /**< 1.5 in Q8 log2 ≈ 4.5 dB */
+#define VAD_DEFAULT_HANGOVER 8      /**< Hops held after last speech */
+
+typedef struct {
+    q15_t    threshold_q8;   /**< Mean band SNR threshold, Q8 log2 */
+    q15_t    prob_q15;       /**< Smoothed speech probability, Q1.15 */
+    uint16_t hangover_len;   /**< Hangover length in hops */
+    uint16_t hangover_cnt;   /**< Hops left in current hangover */
+    uint16_t hop_count;      /**< Hops seen (saturates at VAD_INIT_HOPS) */
+    uint8_t  is_speech;      /**< Decision for the latest hop (with hangover) */
+} vad_state_t;
+
+/**
+ * Initialize VAD state.
+ * @param vad           State structure to initialize
+ * @param threshold_q8  Mean band SNR threshold (Q8 log2), 0 = default
+ * @param hangover_len  Hangover in hops, 0 disables hangover
+ * @return FE_OK on success, FE_ERR_NULL_PTR if vad is NULL
+ */
+fe_status_t vad_init(vad_state_t *vad, q15_t threshold_q8, uint16_t hangover_len);
+
+/**
+ * Classify one hop.
+ *
+ * @param vad         VAD state
+ * @param power       Power spectrum of the current frame (n_bins, Q1.31)
+ * @param noise_est   Running noise estimate maintained by the suppressor
+ * @param noise_stride Distance between consecutive estimates in q31_t units
+ *                    (NS_BIN_STRIDE for the suppressor's interleaved records)
+ * @param n_bins      Number of frequency bins
+ * @return            1 if speech (including hangover), 0 otherwise
+ */
+uint8_t vad_process(vad_state_t *vad,
+                    const q31_t *power,
+                    const q31_t *noise_est,
+                    size_t       noise_stride,
+                    size_t       n_bins);
+
+/**
+ * float32 variant of vad_process() for the FE_PRECISION_F32 hop path.
+ * Band SNRs use log2f() and feed the same Q8 threshold, probability and
+ * hangover logic, so both paths share vad_state_t and its tuning.
+ */
+uint8_t vad_process_f32(vad_state_t *vad,
+                        const float *power,
+                        const float *noise_est,
+                        size_t       noise_stride,
+                        size_t       n_bins);
@@ -1,13 +1,38 @@
 #include "window.h"
+#include <math.h>
 /* window.c */
 
-void window_apply(const q15_t *window, q15_t *frame, size_t frame_len)
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+
+/**
+ * Two Q1.15 products per iteration on DSP cores (Cortex-M4/M7): one word
+ * load per operand, SMULBB/SMULTT on the halves, SSAT and a packed store.
+ * Bit-exact with the scalar loop (truncating >> 15, saturate).
+ */
+static inline void window_pair_q15(const q15_t *w, const q15_t *x, q15_t *y)
+{
+    int32_t vw, vx;
+    __builtin_memcpy(&vw, w, sizeof(vw));
+    __builtin_memcpy(&vx, x, sizeof(vx));
+    int32_t lo = __ssat(__smulbb(vw, vx) >> Q1_15_SHIFT, 16);
+    int32_t hi = __ssat(__smultt(vw, vx) >> Q1_15_SHIFT, 16);
+    uint32_t vy = (uint16_t)lo | ((uint32_t)hi << 16);
+    __builtin_memcpy(y, &vy, sizeof(vy));
+}
+#endif
+
+RTAFE_FAST_CODE void window_apply(const q15_t *window, q15_t *frame, size_t frame_len)
 {
     /** Windowed signal
      *  x_w[n] = x[n] * w[n]
      */
     RTAFE_LOG("Applying window to frame of length %zu\n", frame_len);
-    for (size_t n = 0; n < frame_len; n++) {
+    size_t n = 0;
+#if defined(__ARM_FEATURE_DSP)
+    for (; n + 1 < frame_len; n += 2) window_pair_q15(&window[n], &frame[n], &frame[n]);
+#endif
+    for (; n < frame_len; n++) {
         /** Q1.15 * Q1.15 = Q2.30 -> Shift back to Q1.15 */
         int32_t acc = (int32_t)frame[n] * (int32_t)window[n];
         acc = acc >> Q1_15_SHIFT;
@@ -17,4 +42,108 @@ void window_apply(const q15_t *window, q15_t *frame, size_t frame_len)
 
         frame[n] = (q15_t)acc;
     }
-}
\ No newline at end of file
+}
+
+void window_apply_f32(const float *window, float *frame, size_t frame_len)
+{
+    RTAFE_LOG("Applying float window to frame of length %zu\n", frame_len);
+    for (size_t n = 0; n < frame_len; n++) {
+        frame[n] *= window[n];
+    }
+}
+
+RTAFE_FAST_CODE void window_apply_to(const q15_t *window, const q15_t *src, q15_t *dst, size_t len)
+{
+    size_t n = 0;
+#if defined(__ARM_FEATURE_DSP)
+    for (; n + 1 < len; n += 2) window_pair_q15(&window[n], &src[n], &dst[n]);
+#endif
+    for (; n < len; n++) {
+        int32_t acc = ((int32_t)src[n] * (int32_t)window[n]) >> Q1_15_SHIFT;
+
+        if (acc > INT16_MAX) acc = INT16_MAX;
+        else if (acc < INT16_MIN) acc = INT16_MIN;
+
+        dst[n] = (q15_t)acc;
+    }
+}
+
+RTAFE_FAST_CODE void window_apply_to_f32(const float *window, const float *src, float *dst, size_t len)
+{
+    for (size_t n = 0; n < len; n++) {
+        dst[n] = src[n] * window[n];
+    }
+}
+
+/* ── Analysis/synthesis pairs ───────────────────────────────────────────── */
+
+/** Periodic Hann of length @p len at index @p i. */
+static inline double window_hann_p(size_t i, size_t len)
+{
+    return 0.5 - 0.5 * cos(2.0 * M_PI * (double)i / (double)len);
+}
+
+fe_status_t window_pair_design(uint8_t type, size_t n, size_t hop,
+                               float *analysis, float *synthesis, size_t *ola_len)
+{
+    if (analysis == NULL || synthesis == NULL || ola_len == NULL) return FE_ERR_NULL_PTR;
+    if (hop == 0 || hop > n || n % hop != 0) return FE_ERR_BAD_CONFIG;
+
+    size_t support = n;
+    switch (type) {
+    case WINDOW_PAIR_HANN:
+        for (size_t i = 0; i < n; i++) {
+            analysis[i]  = (float)window_hann_p(i, n);
+            synthesis[i] = 1.0f;
+        }
+        break;
+    case WINDOW_PAIR_SQRT_HANN:
+        for (size_t i = 0; i < n; i++) {
+            analysis[i]  = (float)sqrt(window_hann_p(i, n));
+            synthesis[i] = analysis[i];
+        }
+        break;
+    case WINDOW_PAIR_RECT:
+        for (size_t i = 0; i < n; i++) {
+            analysis[i]  = 1.0f;
+            synthesis[i] = 1.0f;
+        }
+        break;
+    case WINDOW_PAIR_ASYM: {
+        /* Product = Hann(2 * hop) over the last 2 * hop samples */
+        if (2 * hop > n) return FE_ERR_BAD_CONFIG;
+        size_t rise = n - hop;
+        size_t tail = n - 2 * hop;
+        support = 2 * hop;
+        for (size_t i = 0; i < n; i++) {
+            double wa = (i < rise) ? sqrt(window_hann_p(i, 2 * rise))
+                                   : sqrt(window_hann_p(i - tail, 2 * hop));
+            double ws = 0.0;
+            if (i >= rise)      ws = wa;
+            else if (i >= tail) ws = (wa > 0.0) ? window_hann_p(i - tail, 2 * hop) / wa : 0.0;
+            analysis[i]  = (float)wa;
+            synthesis[i] = (float)ws;
+        }
+        break;
+    }
+    default:
+        return FE_ERR_BAD_CONFIG;
+    }
+
+    /* COLA: sum over hop-shifted copies of the product must be flat */
+    double lo = INFINITY, hi = 0.0;
+    for (size_t i = 0; i < hop; i++) {
+        double s = 0.0;
+        for (size_t k = i; k < n; k += hop) s += (double)analysis[k] * synthesis[k];
+        if (s < lo) lo = s;
+        if (s > hi) hi = s;
+    }
+    if (lo <= 0.0 || (hi - lo) > WINDOW_COLA_TOL * hi) return FE_ERR_BAD_CONFIG;
+
+    /* Fold the OLA gain into the synthesis window */
+    double scale = 2.0 / (lo + hi);
+    for (size_t i = 0; i < n; i++) synthesis[i] = (float)(synthesis[i] * scale);
+
+    *ola_len = support;
+    return FE_OK;
+}
@@ -1,7 +1,58 @@
 /* window.h — Windowing stage (apply precomputed analysis window) */
 #pragma once
 #include "rtafe/fe_types.h"
-#include "../math/tables.h"
 #include <stdint.h>
 
-void window_apply(const q15_t *window, q15_t *frame, size_t frame_len);
\ No newline at end of file
+void window_apply(const q15_t *window, q15_t *frame, size_t frame_len);
+
+/** float32 variant: x_w[n] = x[n] * w[n] */
+void window_apply_f32(const float *window, float *frame, size_t frame_len);
+
+/**
+ * Out-of-place window: dst[n] = src[n] * window[n], n < len. Windowing a
+ * frame that wraps around a history ring is two calls, one per segment,
+ * with @p window and @p dst advanced by the first segment's length.
+ */
+void window_apply_to(const q15_t *window, const q15_t *src, q15_t *dst, size_t len);
+
+/** float32 variant of window_apply_to(). */
+void window_apply_to_f32(const float *window, const float *src, float *dst, size_t len);
+
+/* ── Analysis/synthesis pairs ───────────────────────────────────────────── */
+
+/**
+ * Analysis/synthesis window pairs for STFT resynthesis. All windows are
+ * periodic (DFT-even), the form that satisfies COLA exactly.
+ */
+typedef enum {
+    WINDOW_PAIR_HANN      = 0,  /**< Hann analysis, rectangular synthesis (hop ≤ N/2) */
+    WINDOW_PAIR_SQRT_HANN = 1,  /**< sqrt-Hann / sqrt-Hann (hop ≤ N/2) */
+    WINDOW_PAIR_RECT      = 2,  /**< Rectangular / rectangular (any hop, no taper) */
+    WINDOW_PAIR_ASYM      = 3,  /**< Asymmetric low delay, synthesis spans 2 * hop (hop ≤ N/2) */
+} window_pair_t;
+
+#define WINDOW_COLA_TOL 1e-4f   /**< Max relative ripple of the overlapped product */
+
+/**
+ * Design an analysis/synthesis pair for frame length @p n and hop @p hop,
+ * verify perfect reconstruction and pre-scale the synthesis window so that
+ * overlap-adding hop-shifted products sums to exactly 1 (no per-hop gain
+ * normalization).
+ *
+ * ASYM follows Mauler & Martin: the analysis window rises over n - hop
+ * samples and falls over the last hop; the synthesis window is zero up to
+ * n - 2 * hop, so output only depends on the last 2 * hop samples of the
+ * frame and the algorithmic delay drops from n - hop to hop.
+ *
+ * @param type       window_pair_t
+ * @param n          Frame length
+ * @param hop        Hop length, must divide @p n
+ * @param analysis   [n] analysis window out
+ * @param synthesis  [n] pre-scaled synthesis window out
+ * @param ola_len    Synthesis support out: nonzero tail of @p synthesis,
+ *                   a multiple of @p hop (overlap-add buffer length)
+ * @return FE_OK, or FE_ERR_BAD_CONFIG if the pair is unknown, the geometry
+ *         unsupported, or the overlapped product is not constant
+ */
+fe_status_t window_pair_design(uint8_t type, size_t n, size_t hop,
+                               float *analysis, float *synthesis, size_t *ola_len);
@@ -0,0 +1,94 @@
+/**
+ * @file test_arena.c
+ * @brief State/scratch arenas: exact sizing, cache-line slices, no writes past the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "rtafe/fe_api.h"
+
+#define GUARD      64
+#define GUARD_BYTE 0xA5
+
+static int aligned(const void *p)
+{
+    return ((uintptr_t)p % FE_CACHE_LINE) == 0;
+}
+
+static int guard_intact(const uint8_t *p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] != GUARD_BYTE) return 0;
+    }
+    return 1;
+}
+
+static int run_case(const char *name, uint8_t channels, uint8_t flags, uint32_t input_rate,
+                    size_t misalign)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate  = 16000;
+    cfg.input_rate   = input_rate;
+    cfg.frame_len    = 256;
+    cfg.hop_len      = 128;
+    cfg.num_channels = channels;
+    cfg.flags        = flags;
+
+    size_t state_sz = fe_state_bytes(&cfg);
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+
+    /* Deliberately misaligned arenas followed by a guard band */
+    uint8_t *state_mem = (uint8_t *)malloc(state_sz + GUARD + 16);
+    uint8_t *scratch_mem = (uint8_t *)malloc(scratch_sz + GUARD + 16);
+    uint8_t *sp = state_mem + 8;     /* header needs pointer alignment only */
+    uint8_t *xp = scratch_mem + misalign;
+    memset(sp + state_sz, GUARD_BYTE, GUARD);
+    memset(xp + scratch_sz, GUARD_BYTE, GUARD);
+
+    fe_state_t *state = (fe_state_t *)sp;
+    fe_status_t st = fe_init(&cfg, state, xp, scratch_sz);
+
+    q15_t *pcm_in  = (q15_t *)calloc((size_t)channels * 256, sizeof(q15_t));
+    q15_t *pcm_out = (q15_t *)calloc((size_t)channels * 256, sizeof(q15_t));
+    for (size_t i = 0; i < (size_t)channels * 256; i++) pcm_in[i] = (q15_t)((i * 7919) & 0x3FFF);
+    for (int hop = 0; hop < 4 && st == FE_OK; hop++) {
+        st = fe_process_hop(state, pcm_in, pcm_out, NULL, 0);
+    }
+
+    int slices_aligned = aligned(state->work.frame_q15) && aligned(state->work.fft_re) &&
+                         aligned(state->work.fft_im);
+    for (uint8_t c = 0; c < channels; c++) {
+        fe_channel_t *chan = fe_channel(state, c);
+        slices_aligned &= aligned(chan);
+        /* Bin records follow the channel record inside the same block */
+        if (chan->ns.bins) slices_aligned &= (chan->ns.bins == (ns_bin_t *)(chan + 1));
+    }
+    int guards = guard_intact(sp + state_sz, GUARD) && guard_intact(xp + scratch_sz, GUARD);
+    int short_scratch = fe_init(&cfg, state, xp, scratch_sz - 1) == FE_ERR_NO_MEM;
+
+    int pass = (st == FE_OK) && slices_aligned && guards && short_scratch;
+    printf("  %-24s: state=%zu scratch=%zu aligned=%d guards=%d [%s]\n",
+           name, state_sz, scratch_sz, slices_aligned, guards, pass ? "PASS" : "FAIL");
+
+    free(pcm_in);
+    free(pcm_out);
+    free(state_mem);
+    free(scratch_mem);
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    printf("\n--- Engine arenas ---\n");
+    failures += run_case("mono, no spectral",   1, FE_FLAG_DC_REMOVAL, 0, 0);
+    failures += run_case("stereo NS+VAD",       2, FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD, 0, 3);
+    failures += run_case("8ch NS+VAD, 48k SRC", 8, FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD, 48000, 13);
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
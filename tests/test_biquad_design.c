@@ -0,0 +1,61 @@
+/**
+ * @file test_biquad_design.c
+ * @brief Runtime sample-rate filter design: rate scaling, shared cache, DC pole.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "biquad.h"
+#include "module/dc_removal.h"
+
+static int coeffs_equal(const biquad_coeffs *a, const biquad_coeffs *b)
+{
+    return fabsf(a->b0 - b->b0) < 1e-6f && fabsf(a->b1 - b->b1) < 1e-6f &&
+           fabsf(a->b2 - b->b2) < 1e-6f && fabsf(a->a1 - b->a1) < 1e-6f &&
+           fabsf(a->a2 - b->a2) < 1e-6f;
+}
+
+int main(void)
+{
+    int failures = 0, pass;
+
+    printf("\n--- Runtime biquad / DC design ---\n");
+
+    /* Same normalized frequency at two rates must give the same filter */
+    biquad_coeffs c16, c48;
+    biquad_design_coeffs(&c16, BIQUAD_LPF, 1000.0f, 0.707f, 16000.0f);
+    biquad_design_coeffs(&c48, BIQUAD_LPF, 3000.0f, 0.707f, 48000.0f);
+    pass = coeffs_equal(&c16, &c48);
+    failures += !pass;
+    printf("  LPF 1k@16k == 3k@48k          : [%s]\n", pass ? "PASS" : "FAIL");
+
+    /* Legacy macro still designs at SAMPLING_RATE */
+    biquad bq;
+    biquad_lpf(&bq, 3000.0f, 0.707f);
+    pass = coeffs_equal(&bq.coeff, &c48);
+    failures += !pass;
+    printf("  biquad_lpf() uses SAMPLING_RATE: [%s]\n", pass ? "PASS" : "FAIL");
+
+    /* Cache: same key shares one block, different fs gets its own */
+    const biquad_design *a = biquad_design_get(BIQUAD_HPF, 100.0f, 0.707f, 16000.0f);
+    const biquad_design *b = biquad_design_get(BIQUAD_HPF, 100.0f, 0.707f, 16000.0f);
+    const biquad_design *c = biquad_design_get(BIQUAD_HPF, 100.0f, 0.707f, 48000.0f);
+    biquad_coeffs_fixed q;
+    biquad_quantize(&a->coeff, &q);
+    pass = a && a == b && c && c != a && biquad_design_cache_count() == 2 &&
+           q.b0 == a->coeff_fixed.b0 && q.a1 == a->coeff_fixed.a1 && q.a2 == a->coeff_fixed.a2;
+    failures += !pass;
+    printf("  Design cache sharing / Q2.14   : entries=%d [%s]\n",
+           biquad_design_cache_count(), pass ? "PASS" : "FAIL");
+
+    /* DC pole: 20 Hz corner, closer to 1 at the higher rate */
+    float a16 = dc_removal_alpha(20.0f, 16000.0f);
+    float a48 = dc_removal_alpha(20.0f, 48000.0f);
+    pass = (a16 > 0.99f && a16 < 0.995f) && (a48 > a16) && (a48 < 1.0f) &&
+           dc_removal_alpha_q31(20.0f, 16000.0f) == (q31_t)((double)a16 * 2147483648.0);
+    failures += !pass;
+    printf("  DC alpha 20 Hz: %.5f@16k %.5f@48k [%s]\n", a16, a48, pass ? "PASS" : "FAIL");
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file test_fe_common.h
+ * @brief Fixtures shared by the hop engine tests: a seedable noise source
+ *        and the engine configuration builder.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "rtafe/fe_api.h"
+
+/** Pre-emphasis of test_config(), Q1.15 (0.9) */
+#define TEST_PRE_EMPHASIS 0x7333
+
+static uint32_t test_lcg = 1;
+
+/** Restart test_noise() at @p seed, to replay the same sequence. */
+static inline void test_noise_seed(uint32_t seed)
+{
+    test_lcg = seed;
+}
+
+/** Uniform noise in [-1, 1) from a 32-bit LCG. */
+static inline double test_noise(void)
+{
+    test_lcg = test_lcg * 1664525u + 1013904223u;
+    return ((int32_t)(test_lcg >> 16) - 32768) / 32768.0;
+}
+
+/**
+ * Engine configuration of the tests: 16 kHz, noise suppression and VAD
+ * on, TEST_PRE_EMPHASIS, STFT mode. The arguments are the fields the
+ * tests vary; set anything else on the result.
+ */
+static inline void test_config(fe_config_t *cfg, uint8_t precision, uint8_t window,
+                               uint8_t channels, uint16_t frame_len, uint16_t hop_len)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->sample_rate        = 16000;
+    cfg->frame_len          = frame_len;
+    cfg->hop_len            = hop_len;
+    cfg->num_channels       = channels;
+    cfg->flags              = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg->pre_emphasis_alpha = TEST_PRE_EMPHASIS;
+    cfg->precision          = precision;
+    cfg->window             = window;
+    cfg->mode               = FE_MODE_STFT;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_fft_q15.c
+ * @brief Q1.15 block-floating-point FFT: SNR against a double-precision
+ *        DFT at loud and quiet levels, no overflow on worst-case inputs,
+ *        and the fft/ifft round trip.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "module/fft.h"
+#include "module/ifft.h"
+
+#define MAX_N 1024
+
+static uint32_t tw[MAX_N / 2];
+static q15_t x[2 * MAX_N];
+static double ref_re[MAX_N], ref_im[MAX_N];
+
+static uint32_t lcg = 7;
+
+static int16_t q15_round(double v)
+{
+    v = floor(v * 32767.0 + 0.5);
+    return (int16_t)(v > 32767.0 ? 32767.0 : v < -32768.0 ? -32768.0 : v);
+}
+
+/* Same packing and rounding as tools/gen_tables.c */
+static void make_twiddles(size_t n)
+{
+    for (size_t i = 0; i < n / 2; i++) {
+        double a = 2.0 * M_PI * i / n;
+        tw[i] = (uint32_t)(uint16_t)q15_round(cos(a)) | ((uint32_t)(uint16_t)q15_round(sin(a)) << 16);
+    }
+}
+
+static void make_input(size_t n, double amp)
+{
+    for (size_t i = 0; i < n; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        double u = ((int32_t)(lcg >> 16) - 32768) / 32768.0;
+        x[2 * i]     = (q15_t)lrint(amp * u * 32767.0);
+        x[2 * i + 1] = 0;
+    }
+}
+
+static void reference_dft(size_t n)
+{
+    for (size_t k = 0; k < n; k++) {
+        double sr = 0.0, si = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double a = 2.0 * M_PI * (double)((k * i) % n) / n;
+            sr += x[2 * i] * cos(a) + x[2 * i + 1] * sin(a);
+            si += x[2 * i + 1] * cos(a) - x[2 * i] * sin(a);
+        }
+        ref_re[k] = sr;
+        ref_im[k] = si;
+    }
+}
+
+/* SNR of the scaled-back FFT output against the reference, dB */
+static double fft_snr(size_t n, int exponent)
+{
+    double sig = 0.0, err = 0.0;
+    for (size_t k = 0; k < n; k++) {
+        double yr = ldexp(x[2 * k], exponent), yi = ldexp(x[2 * k + 1], exponent);
+        sig += ref_re[k] * ref_re[k] + ref_im[k] * ref_im[k];
+        err += (yr - ref_re[k]) * (yr - ref_re[k]) + (yi - ref_im[k]) * (yi - ref_im[k]);
+    }
+    return 10.0 * log10(sig / (err + 1e-30));
+}
+
+static int test_snr(size_t n, double amp, double min_snr)
+{
+    make_twiddles(n);
+    make_input(n, amp);
+    reference_dft(n);
+    int e = fft_radix2_q15(x, n, tw);
+    double snr = fft_snr(n, e);
+    int pass = snr >= min_snr;
+    printf("  N=%-4zu level %6.1f dBFS: exp %2d, SNR %5.1f dB (min %.0f) : [%s]\n", n,
+           20.0 * log10(amp), e, snr, min_snr, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* Full-scale DC and alternating inputs concentrate everything in one bin,
+   the worst case for the per-stage growth */
+static int test_no_overflow(size_t n)
+{
+    make_twiddles(n);
+    int pass = 1;
+    for (int kind = 0; kind < 3; kind++) {
+        for (size_t i = 0; i < n; i++) {
+            x[2 * i]     = (kind == 0) ? INT16_MIN : (kind == 1) ? ((i & 1) ? INT16_MIN : INT16_MAX)
+                                                                 : INT16_MAX;
+            x[2 * i + 1] = (kind == 2) ? INT16_MIN : 0;
+        }
+        reference_dft(n);
+        int e = fft_radix2_q15(x, n, tw);
+        pass &= fft_snr(n, e) > 40.0;                  /* a wrap lands near 0 dB */
+    }
+    printf("  N=%-4zu full-scale DC / Nyquist / complex DC, no wrap      : [%s]\n", n,
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* ifft(fft(x)) = n * x * 2^-(e1 + e2) */
+static int test_round_trip(size_t n)
+{
+    static q15_t orig[MAX_N];
+    make_twiddles(n);
+    make_input(n, 0.5);
+    for (size_t i = 0; i < n; i++) orig[i] = x[2 * i];
+
+    int e1 = fft_radix2_q15(x, n, tw);
+    int e2 = ifft_radix2_q15(x, n, tw);
+    int log2n = 0;
+    while (((size_t)1 << log2n) < n) log2n++;
+
+    double sig = 0.0, err = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double y = ldexp(x[2 * i], e1 + e2 - log2n);
+        sig += (double)orig[i] * orig[i];
+        err += (y - orig[i]) * (y - orig[i]);
+    }
+    double snr = 10.0 * log10(sig / (err + 1e-30));
+    int pass = snr >= 55.0;
+    printf("  N=%-4zu round trip SNR %.1f dB (exp %d + %d)             : [%s]\n", n, snr,
+           e1, e2, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Q1.15 block-floating-point FFT ---\n");
+
+    for (size_t n = 64; n <= MAX_N; n *= 4) {
+        failures += test_snr(n, 0.5, 60.0);
+        failures += test_snr(n, 1.0 / 256.0, 40.0);
+        failures += test_no_overflow(n);
+        failures += test_round_trip(n);
+    }
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file test_file_io.c
+ * @brief Async WAV I/O: every PCM width decodes to the expected Q1.15,
+ *        read → write → read round trips are lossless on both backends,
+ *        the stall counters see the slow side, and bad input is rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "rtafe/fe_file_io.h"
+
+#define N_FRAMES  100003          /* not a multiple of the block size */
+#define BLOCK     4096
+
+static char in_path[64], out_path[64], bad_path[64];
+
+static q15_t expected(size_t i)
+{
+    uint32_t x = (uint32_t)i * 2654435761u;
+    x ^= x >> 13;
+    return (q15_t)(x & 0xFFFF);
+}
+
+static void put_le(FILE *f, uint32_t v, int bytes)
+{
+    for (int b = 0; b < bytes; b++) fputc((v >> (8 * b)) & 0xFF, f);
+}
+
+/* Sample i carries expected(i) in its top 16 bits (8-bit: top 8); the
+   bits below are 0x80.. so rounding to 16 bits must not carry */
+static void write_wav(const char *path, uint16_t ch, uint16_t bits, size_t frames)
+{
+    FILE *f = fopen(path, "wb");
+    uint32_t data = (uint32_t)(frames * ch * (bits / 8));
+    fwrite("RIFF", 1, 4, f);
+    put_le(f, 36 + 12 + data, 4);
+    fwrite("WAVE", 1, 4, f);
+    fwrite("LIST", 1, 4, f);                    /* a chunk the reader must skip */
+    put_le(f, 4, 4);
+    fwrite("INFO", 1, 4, f);
+    fwrite("fmt ", 1, 4, f);
+    put_le(f, 16, 4);
+    put_le(f, 1, 2);
+    put_le(f, ch, 2);
+    put_le(f, 16000, 4);
+    put_le(f, 16000u * ch * (bits / 8), 4);
+    put_le(f, ch * (bits / 8), 2);
+    put_le(f, bits, 2);
+    fwrite("data", 1, 4, f);
+    put_le(f, data, 4);
+    for (size_t i = 0; i < frames * ch; i++) {
+        uint16_t v = (uint16_t)expected(i);
+        switch (bits) {
+        case 8:  fputc((uint8_t)((v >> 8) ^ 0x80), f); break;
+        case 16: put_le(f, v, 2); break;
+        case 24: put_le(f, ((uint32_t)v << 8) | 0x7F, 3); break;
+        default: put_le(f, ((uint32_t)v << 16) | 0x7FFF, 4); break;
+        }
+    }
+    fclose(f);
+}
+
+static q15_t expected_at(size_t i, uint16_t bits)
+{
+    return bits == 8 ? (q15_t)(expected(i) & ~0xFF) : expected(i);
+}
+
+/* Read in_path through the pipeline, copy every block to out_path */
+static int copy_through(uint16_t ch, uint16_t bits, uint8_t backend, uint8_t depth,
+                        useconds_t dsp_us, fe_aio_stats_t *stats)
+{
+    fe_wav_info_t info;
+    if (fe_wav_probe(in_path, &info) != FE_OK) return 0;
+    if (info.num_channels != ch || info.bits_per_sample != bits || info.num_frames != N_FRAMES) return 0;
+
+    fe_aio_config_t cfg = { BLOCK, depth, backend };
+    size_t sz = fe_aio_bytes(&cfg, &info);
+    void *mem = malloc(sz);
+    fe_aio_t *aio;
+    if (fe_aio_open(mem, sz, &cfg, in_path, &info, out_path, &aio) != FE_OK) {
+        free(mem);
+        return -1;
+    }
+
+    int ok = 1;
+    size_t pos = 0, n;
+    const q15_t *blk;
+    while ((blk = fe_aio_read(aio, &n)) != NULL) {
+        for (size_t i = 0; i < n * ch; i++) ok &= blk[i] == expected_at(pos * ch + i, bits);
+        if (dsp_us) usleep(dsp_us);
+        q15_t *slot = fe_aio_write_slot(aio);
+        memcpy(slot, blk, n * ch * sizeof(q15_t));
+        ok &= fe_aio_write_commit(aio, n) == FE_OK;
+        pos += n;
+    }
+    ok &= pos == N_FRAMES;
+    ok &= fe_aio_close(aio, stats) == FE_OK;
+    free(mem);
+    return ok;
+}
+
+/* out_path is a 16-bit WAV holding the same samples */
+static int check_output(uint16_t ch, uint16_t bits)
+{
+    fe_wav_info_t info;
+    if (fe_wav_probe(out_path, &info) != FE_OK) return 0;
+    if (info.num_channels != ch || info.bits_per_sample != 16 || info.num_frames != N_FRAMES ||
+        info.sample_rate != 16000) {
+        return 0;
+    }
+
+    q15_t *pcm = (q15_t *)malloc((size_t)N_FRAMES * ch * sizeof(q15_t));
+    int ok = fe_aio_read_all(out_path, NULL, &info, pcm, NULL) == FE_OK;
+    for (size_t i = 0; i < (size_t)N_FRAMES * ch; i++) ok &= pcm[i] == expected_at(i, bits);
+    free(pcm);
+    return ok;
+}
+
+static int test_formats(uint8_t backend, const char *name)
+{
+    static const struct { uint16_t ch, bits; } fmts[] = { { 2, 16 }, { 1, 24 }, { 3, 32 }, { 1, 8 } };
+    int failures = 0;
+
+    for (size_t f = 0; f < sizeof(fmts) / sizeof(fmts[0]); f++) {
+        fe_aio_stats_t st;
+        write_wav(in_path, fmts[f].ch, fmts[f].bits, N_FRAMES);
+        int r = copy_through(fmts[f].ch, fmts[f].bits, backend, 4, 0, &st);
+        if (r < 0) {
+            printf("  %-8s : unavailable on this kernel, skipped\n", name);
+            return 0;
+        }
+        size_t n_blocks = (N_FRAMES + BLOCK - 1) / BLOCK;
+        int pass = r && check_output(fmts[f].ch, fmts[f].bits) && st.backend == backend &&
+                   st.blocks_read == n_blocks && st.blocks_written == n_blocks &&
+                   st.read_ready == 0 && st.write_pending == 0 &&
+                   st.max_in_flight >= 1 && st.max_in_flight <= 2 * st.depth;
+        printf("  %-8s : %u ch %2u-bit decode + 16-bit round trip, %zu blocks, max in flight %u : [%s]\n",
+               name, fmts[f].ch, fmts[f].bits, n_blocks, st.max_in_flight, pass ? "PASS" : "FAIL");
+        failures += !pass;
+    }
+    return failures;
+}
+
+/* Slow DSP: the I/O thread runs ahead and idles, the caller never waits for output */
+static int test_stalls(uint8_t backend, const char *name)
+{
+    fe_aio_stats_t st;
+    write_wav(in_path, 1, 16, N_FRAMES);
+    int r = copy_through(1, 16, backend, 4, 2000, &st);
+    if (r < 0) return 0;
+    int pass = r && st.io_idle > 0 && st.write_stalls == 0 && st.read_stalls <= 1;
+    printf("  %-8s : slow consumer: read stalls %llu, write stalls %llu, io idle %llu : [%s]\n",
+           name, (unsigned long long)st.read_stalls, (unsigned long long)st.write_stalls,
+           (unsigned long long)st.io_idle, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static int test_errors(void)
+{
+    fe_wav_info_t info;
+    int pass = fe_wav_probe("/nonexistent/x.wav", &info) == FE_ERR_IO;
+
+    FILE *f = fopen(bad_path, "wb");
+    fputs("RIFF\x10\0\0\0WAVEjunk", f);
+    fclose(f);
+    pass &= fe_wav_probe(bad_path, &info) == FE_ERR_IO;
+
+    write_wav(in_path, 2, 16, 1000);
+    pass &= fe_wav_probe(in_path, &info) == FE_OK && info.num_frames == 1000;
+    fe_aio_config_t cfg = { 0 };
+    size_t sz = fe_aio_bytes(&cfg, &info);
+    void *mem = malloc(sz);
+    fe_aio_t *aio;
+    pass &= fe_aio_open(mem, sz - 64, &cfg, in_path, &info, NULL, &aio) == FE_ERR_NO_MEM;
+    pass &= fe_aio_open(mem, sz, &cfg, "/nonexistent/x.wav", &info, NULL, &aio) == FE_ERR_IO;
+    cfg.depth = FE_AIO_MAX_DEPTH + 1;
+    pass &= fe_aio_bytes(&cfg, &info) == 0;
+
+    /* Read-only handle: no write slots; closing early is fine */
+    cfg.depth = 0;
+    size_t n;
+    pass &= fe_aio_open(mem, sz, &cfg, in_path, &info, NULL, &aio) == FE_OK &&
+            fe_aio_write_slot(aio) == NULL && fe_aio_read(aio, &n) != NULL && n == 1000 &&
+            fe_aio_read(aio, &n) == NULL && n == 0 && fe_aio_close(aio, NULL) == FE_OK;
+    free(mem);
+
+    printf("  missing/corrupt files, small arena, bad depth, read-only : [%s]\n", pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    snprintf(in_path, sizeof(in_path), "/tmp/rtafe_aio_in_%d.wav", (int)getpid());
+    snprintf(out_path, sizeof(out_path), "/tmp/rtafe_aio_out_%d.wav", (int)getpid());
+    snprintf(bad_path, sizeof(bad_path), "/tmp/rtafe_aio_bad_%d.wav", (int)getpid());
+    printf("\n--- Async WAV file I/O ---\n");
+
+    failures += test_formats(FE_AIO_IO_URING, "io_uring");
+    failures += test_formats(FE_AIO_THREAD, "pthread");
+    failures += test_stalls(FE_AIO_IO_URING, "io_uring");
+    failures += test_stalls(FE_AIO_THREAD, "pthread");
+    failures += test_errors();
+
+    unlink(in_path);
+    unlink(out_path);
+    unlink(bad_path);
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_fixedpoint.c
+ * @brief Fast-math kernels (utils/fixedpoint.h) against libm: checks the
+ *        documented error bounds over dense input sweeps, saturation edges
+ *        and block/scalar agreement for every *_block() variant.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fixedpoint.h"
+
+static uint32_t lcg = 2024;
+
+static uint32_t rand_u32(void)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    uint32_t hi = lcg;
+    lcg = lcg * 1664525u + 1013904223u;
+    return (hi & 0xFFFF0000u) | (lcg >> 16);
+}
+
+/* Random value with a random magnitude, so every exponent is covered */
+static uint32_t rand_scaled(void)
+{
+    uint32_t x = rand_u32();
+    return x >> (rand_u32() % 32);
+}
+
+static int report(const char *name, double err, double bound, const char *unit)
+{
+    int pass = err <= bound;
+    printf("  %-13s max err %10.3e %-8s (bound %.3e) : [%s]\n", name, err, unit, bound,
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static int test_saturation(void)
+{
+    int pass = fx_add_sat_q31(INT32_MAX, 1) == INT32_MAX &&
+               fx_add_sat_q31(INT32_MIN, -1) == INT32_MIN &&
+               fx_sub_sat_q31(INT32_MIN, 1) == INT32_MIN &&
+               fx_sub_sat_q31(5, 7) == -2 &&
+               fx_add_sat_q15(30000, 30000) == INT16_MAX &&
+               fx_add_sat_q15(-30000, -30000) == INT16_MIN &&
+               fx_mul_q15(INT16_MIN, INT16_MIN) == INT16_MAX &&
+               fx_mul_q31(INT32_MIN, INT32_MIN) == INT32_MAX &&
+               fx_mul_q15(16384, 16384) == 8192 &&
+               fx_clz32(0) == 32 && fx_clz32(1) == 31;
+
+    /* Block variants agree with the scalar kernels (odd length: DSP tail) */
+    q15_t a[37], b[37], s[37], m[37];
+    for (int i = 0; i < 37; i++) {
+        a[i] = (q15_t)rand_u32();
+        b[i] = (q15_t)rand_u32();
+    }
+    fx_add_sat_q15_block(a, b, s, 37);
+    fx_mul_q15_block(a, b, m, 37);
+    for (int i = 0; i < 37; i++) {
+        pass &= s[i] == fx_add_sat_q15(a[i], b[i]) && m[i] == fx_mul_q15(a[i], b[i]);
+    }
+
+    printf("  Saturating ops / block variants                          : [%s]\n",
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* Each Q1.31 / uint32_t block variant against its scalar kernel, saturation
+   edges and zero inputs included */
+static int test_blocks(void)
+{
+    enum { N = 64 };
+    q31_t a[N], b[N], add[N], sub[N], mul[N];
+    uint32_t x[N], recip[N], rsqrt[N], num[N], div[N];
+    int32_t lg[N], ex_in[N];
+    uint32_t ex[N];
+    q15_t at[N];
+    int r_shift[N], s_shift[N];
+
+    for (int i = 0; i < N; i++) {
+        a[i] = (q31_t)rand_u32();
+        b[i] = (q31_t)rand_u32();
+        x[i] = rand_scaled();
+        num[i] = rand_u32();
+        ex_in[i] = (int32_t)(rand_u32() % (33u << 16)) - (17 << 16);
+    }
+    a[0] = INT32_MIN; b[0] = 1;                      /* sub saturates low */
+    a[1] = INT32_MAX; b[1] = -1;                     /* sub saturates high */
+    a[2] = INT32_MIN; b[2] = INT32_MIN;              /* mul saturates */
+    x[3] = 0;                                        /* recip / rsqrt of 0 */
+    x[4] = UINT32_MAX;
+
+    fx_add_sat_q31_block(a, b, add, N);
+    fx_sub_sat_q31_block(a, b, sub, N);
+    fx_mul_q31_block(a, b, mul, N);
+    fx_recip_block(x, recip, r_shift, N);
+    fx_rsqrt_block(x, rsqrt, s_shift, N);
+    fx_div_u32_block(num, x, div, N, 9);
+    fx_log2_block(x, lg, N);
+    fx_exp2_block(ex_in, ex, N);
+    fx_atan2_block(a, b, at, N);
+
+    int ok_sub = 1, ok_mul = 1, ok_recip = 1, ok_rsqrt = 1, ok_rest = 1;
+    for (int i = 0; i < N; i++) {
+        int shift;
+        ok_sub &= sub[i] == fx_sub_sat_q31(a[i], b[i]);
+        ok_mul &= mul[i] == fx_mul_q31(a[i], b[i]);
+        ok_recip &= recip[i] == fx_recip_u32(x[i], &shift) && r_shift[i] == shift;
+        ok_rsqrt &= rsqrt[i] == fx_rsqrt_u32(x[i], &shift) && s_shift[i] == shift;
+        ok_rest &= add[i] == fx_add_sat_q31(a[i], b[i]) &&
+                   div[i] == fx_div_u32(num[i], x[i], 9) && lg[i] == fx_log2_u32(x[i]) &&
+                   ex[i] == fx_exp2_q16(ex_in[i]) && at[i] == fx_atan2_q15(a[i], b[i]);
+    }
+    ok_sub &= sub[0] == INT32_MIN && sub[1] == INT32_MAX;
+    ok_mul &= mul[2] == INT32_MAX;
+    ok_recip &= recip[3] == 0 && r_shift[3] == 0;
+    ok_rsqrt &= rsqrt[3] == 0 && s_shift[3] == 0;
+
+    printf("  fx_sub_sat_q31_block vs scalar                           : [%s]\n", ok_sub ? "PASS" : "FAIL");
+    printf("  fx_mul_q31_block vs scalar                               : [%s]\n", ok_mul ? "PASS" : "FAIL");
+    printf("  fx_recip_block vs scalar                                 : [%s]\n", ok_recip ? "PASS" : "FAIL");
+    printf("  fx_rsqrt_block vs scalar                                 : [%s]\n", ok_rsqrt ? "PASS" : "FAIL");
+    printf("  add / div / log2 / exp2 / atan2 blocks vs scalar         : [%s]\n", ok_rest ? "PASS" : "FAIL");
+    return !ok_sub + !ok_mul + !ok_recip + !ok_rsqrt + !ok_rest;
+}
+
+int main(void)
+{
+    int failures = 0;
+    const int n = 1 << 20;
+    printf("\n--- Fixed-point fast math ---\n");
+
+    failures += test_saturation();
+    failures += test_blocks();
+
+    /* Reciprocal and division */
+    double rel = 0.0, div_err = 0.0;
+    for (int i = 0; i < n; i++) {
+        uint32_t d = rand_scaled() | 1u;
+        int shift;
+        uint32_t r = fx_recip_u32(d, &shift);
+        double e = fabs(ldexp((double)r, -shift) * d - 1.0);
+        if (e > rel) rel = e;
+
+        uint32_t num = rand_u32() % (d > 1 ? d : 2);
+        double ref = ldexp((double)num, 9) / d;
+        double q = fx_div_u32(num, d, 9);
+        e = fabs(q - ref) - ref * 0x1p-23;
+        if (e > div_err) div_err = e;
+    }
+    failures += report("fx_recip_u32", rel, 0x1p-23, "rel");
+    failures += report("fx_div_u32", div_err, 1.0, "LSB");
+
+    /* Reciprocal square root */
+    rel = 0.0;
+    for (int i = 0; i < n; i++) {
+        uint32_t x = rand_scaled() | 1u;
+        int shift;
+        uint32_t r = fx_rsqrt_u32(x, &shift);
+        double e = fabs(ldexp((double)r, -shift) * sqrt((double)x) - 1.0);
+        if (e > rel) rel = e;
+    }
+    failures += report("fx_rsqrt_u32", rel, 0x1p-22, "rel");
+
+    /* log2 */
+    double lg_err = 0.0;
+    for (int i = 0; i < n; i++) {
+        uint32_t x = rand_scaled() | 1u;
+        double e = fabs(fx_log2_u32(x) / 65536.0 - log2((double)x)) * 65536.0;
+        if (e > lg_err) lg_err = e;
+    }
+    lg_err = fmax(lg_err, fabs(fx_log2_u32(1) / 65536.0));
+    failures += report("fx_log2_u32", lg_err, 2.0, "LSB");
+
+    /* exp2 over its whole input range */
+    double ex_err = 0.0;
+    for (int32_t x = -(17 << 16); x < (16 << 16); x += 7) {
+        double ref = ldexp(pow(2.0, x / 65536.0), 16);
+        double e = fabs((double)fx_exp2_q16(x) - ref) - 1.0;
+        if (e / ref > ex_err) ex_err = e / ref;
+    }
+    int sat = fx_exp2_q16(16 << 16) == UINT32_MAX && fx_exp2_q16(-(18 << 16)) == 0 &&
+              fx_exp2_q16(0) == 65536 && fx_exp2_q16(3 << 16) == (8u << 16);
+    failures += !sat;
+    failures += report("fx_exp2_q16", ex_err, 0x1p-14, "rel");
+
+    /* atan2, all quadrants and extreme magnitudes */
+    double at_err = 0.0;
+    for (int i = 0; i < n; i++) {
+        q31_t y = (q31_t)rand_scaled() * ((rand_u32() & 1) ? -1 : 1);
+        q31_t x = (q31_t)rand_scaled() * ((rand_u32() & 1) ? -1 : 1);
+        if (x == 0 && y == 0) continue;
+        double ref = atan2((double)y, (double)x) / M_PI * 32768.0;
+        double d = fabs((double)fx_atan2_q15(y, x) - ref);
+        if (d > 32768.0) d = 65536.0 - d;              /* ±π wrap */
+        if (d > at_err) at_err = d;
+    }
+    int edges = fx_atan2_q15(0, 0) == 0 && fx_atan2_q15(0, 100) == 0 &&
+                fx_atan2_q15(100, 0) == 16384 && fx_atan2_q15(-100, 0) == -16384 &&
+                fx_atan2_q15(0, -100) == INT16_MIN && fx_atan2_q15(INT32_MIN, INT32_MIN) == -24576;
+    failures += !edges;
+    failures += report("fx_atan2_q15", at_err, 2.0, "LSB");
+    printf("  Edge cases (exp2 saturation, atan2 axes)                 : [%s]\n",
+           sat && edges ? "PASS" : "FAIL");
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_low_latency.c
+ * @brief Low-latency mode: minimum-phase FIR design, zero-delay pass-through,
+ *        noise suppression through the FIR, and config checks.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_api.h"
+#include "module/minphase.h"
+
+#define FRAME_LEN 256
+#define N_BINS    (FRAME_LEN / 2 + 1)
+
+static float tw_cos[FRAME_LEN / 2], tw_sin[FRAME_LEN / 2];
+static float re[FRAME_LEN], im[FRAME_LEN];
+
+/* |H| of the FIR at bin k of a FRAME_LEN-point grid */
+static float fir_mag(const float *h, size_t taps, size_t k)
+{
+    double sr = 0.0, si = 0.0;
+    for (size_t i = 0; i < taps; i++) {
+        double x = 2.0 * M_PI * (double)(k * i) / FRAME_LEN;
+        sr += h[i] * cos(x);
+        si -= h[i] * sin(x);
+    }
+    return (float)sqrt(sr * sr + si * si);
+}
+
+static int test_design(void)
+{
+    static float gain[N_BINS];
+    float h[FE_LL_FIR_TAPS];
+
+    for (size_t i = 0; i < FRAME_LEN / 2; i++) {
+        tw_cos[i] = (float)cos(2.0 * M_PI * i / FRAME_LEN);
+        tw_sin[i] = (float)sin(2.0 * M_PI * i / FRAME_LEN);
+    }
+
+    /* Flat gain: a scaled impulse */
+    for (size_t k = 0; k < N_BINS; k++) gain[k] = 0.5f;
+    minphase_fir_f32(gain, FRAME_LEN, re, im, tw_cos, tw_sin, h, FE_LL_FIR_TAPS);
+    float tail = 0.0f;
+    for (size_t i = 1; i < FE_LL_FIR_TAPS; i++) tail += fabsf(h[i]);
+    int pass = fabsf(h[0] - 0.5f) < 1e-4f && tail < 1e-4f;
+    printf("  Flat gain -> impulse h[0]=%.5f tail=%.1e : [%s]\n", h[0], tail, pass ? "PASS" : "FAIL");
+    int failures = !pass;
+
+    /* Smooth high-shelf cut, 0 dB to -20 dB: magnitude tracked, energy up front */
+    for (size_t k = 0; k < N_BINS; k++) {
+        float t = (float)k / (N_BINS - 1);
+        gain[k] = 1.0f - 0.9f * 0.5f * (1.0f - cosf((float)M_PI * t));
+    }
+    minphase_fir_f32(gain, FRAME_LEN, re, im, tw_cos, tw_sin, h, FE_LL_FIR_TAPS);
+    float max_db = 0.0f;
+    for (size_t k = 0; k < N_BINS; k += 4) {
+        float db = fabsf(20.0f * log10f(fir_mag(h, FE_LL_FIR_TAPS, k) / gain[k]));
+        if (db > max_db) max_db = db;
+    }
+    float e_all = 0.0f, e_head = 0.0f;
+    for (size_t i = 0; i < FE_LL_FIR_TAPS; i++) {
+        e_all += h[i] * h[i];
+        if (i < 4) e_head += h[i] * h[i];
+    }
+    pass = max_db < 0.5f && e_head > 0.95f * e_all;
+    printf("  Shelf gain: max err %.2f dB, %.1f%% energy in 4 taps : [%s]\n",
+           max_db, 100.0f * e_head / e_all, pass ? "PASS" : "FAIL");
+    return failures + !pass;
+}
+
+static fe_state_t *ll_engine(uint16_t hop, uint8_t flags, void **scratch)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate        = 16000;
+    cfg.frame_len          = FRAME_LEN;
+    cfg.hop_len            = hop;
+    cfg.num_channels       = 2;
+    cfg.flags              = flags;
+    cfg.dc_rm_alpha        = 0x7FD00000;
+    cfg.pre_emphasis_alpha = 0x5000;
+    cfg.precision          = FE_PRECISION_F32;
+    cfg.window             = WINDOW_PAIR_SQRT_HANN;
+    cfg.mode               = FE_MODE_LOW_LATENCY;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    *scratch = malloc(scratch_sz);
+    if (fe_init(&cfg, state, *scratch, scratch_sz) != FE_OK) {
+        free(state); free(*scratch);
+        return NULL;
+    }
+    return state;
+}
+
+/* NS off: the FIR stays an impulse, output = conditioned input, no delay */
+static int test_passthrough(uint16_t hop)
+{
+    void *scratch;
+    fe_state_t *state = ll_engine(hop, FE_FLAG_VAD, &scratch);
+    if (state == NULL) {
+        printf("  hop=%u fe_init failed [FAIL]\n", hop);
+        return 1;
+    }
+
+    DCRemovalF32 dc;
+    PreEmphasisF32 pre;
+    dc_removal_init_f32(&dc, (float)0x7FD00000 * 0x1p-31f);
+    pre_emphasis_init_f32(&pre, (float)0x5000 * 0x1p-15f);
+
+    q15_t in[2 * 32], out[2 * 32];
+    uint32_t lcg = 3;
+    float max_err = 0.0f;
+    for (int b = 0; b < 200; b++) {
+        for (uint16_t n = 0; n < hop; n++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            in[2 * n]     = (q15_t)(((int32_t)(lcg >> 16) - 32768) / 4);
+            in[2 * n + 1] = in[2 * n];
+        }
+        fe_process_hop(state, in, out, NULL, 0);
+        for (uint16_t n = 0; n < hop; n++) {
+            float x = dc_removal_process_f32(&dc, (float)in[2 * n] * 0x1p-15f);
+            float ref = pre_emphasis_process_f32(&pre, x) * 32768.0f;
+            float e = fabsf((float)out[2 * n] - ref);
+            if (e > max_err) max_err = e;
+            if (out[2 * n + 1] != out[2 * n]) max_err = 1e9f;
+        }
+    }
+
+    int pass = max_err <= 0.51f && fe_latency(state) == 0;
+    printf("  hop=%-2u pass-through, latency %u, max err %.2f LSB : [%s]\n",
+           hop, fe_latency(state), max_err, pass ? "PASS" : "FAIL");
+    free(state); free(scratch);
+    return !pass;
+}
+
+/* Stationary noise: the FIR settles on the suppressor's gain */
+static int test_suppression(void)
+{
+    void *scratch;
+    fe_state_t *state = ll_engine(16, FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD, &scratch);
+    if (state == NULL) {
+        printf("  NS fe_init failed [FAIL]\n");
+        return 1;
+    }
+
+    q15_t in[2 * 16], out[2 * 16];
+    uint32_t lcg = 11;
+    double e_in = 0.0, e_out = 0.0;
+    int finite = 1;
+    for (int b = 0; b < 2000; b++) {
+        for (int n = 0; n < 16; n++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            in[2 * n]     = (q15_t)(((int32_t)(lcg >> 16) - 32768) / 16);
+            in[2 * n + 1] = in[2 * n];
+        }
+        fe_process_hop(state, in, out, NULL, 0);
+        if (b < 1000) continue;
+        for (int n = 0; n < 16; n++) {
+            e_in  += (double)in[2 * n] * in[2 * n];
+            e_out += (double)out[2 * n] * out[2 * n];
+        }
+        for (int i = 0; i < FE_LL_FIR_TAPS; i++) finite &= isfinite(fe_channel_f32(state, 0)->fir[i]);
+    }
+
+    double atten_db = 10.0 * log10(e_in / (e_out + 1.0));
+    int pass = finite && atten_db > 4.0;
+    printf("  Stationary noise attenuated %.1f dB          : [%s]\n", atten_db, pass ? "PASS" : "FAIL");
+    free(state); free(scratch);
+    return !pass;
+}
+
+static int test_config(void)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate  = 16000;
+    cfg.frame_len    = FRAME_LEN;
+    cfg.hop_len      = 16;
+    cfg.num_channels = 1;
+    cfg.precision    = FE_PRECISION_F32;
+    cfg.mode         = FE_MODE_LOW_LATENCY;
+
+    int pass = fe_state_bytes(&cfg) != 0;
+    cfg.precision = FE_PRECISION_Q31;  pass &= fe_state_bytes(&cfg) == 0;
+    cfg.precision = FE_PRECISION_F32;
+    cfg.window = WINDOW_PAIR_RECT;     pass &= fe_state_bytes(&cfg) == 0;
+    cfg.window = WINDOW_PAIR_HANN;
+    cfg.hop_len = 256;                 pass &= fe_state_bytes(&cfg) == 0;
+    cfg.hop_len = 16;
+    cfg.mode = 2;                      pass &= fe_state_bytes(&cfg) == 0;
+    cfg.mode = FE_MODE_LOW_LATENCY;
+    cfg.frame_len = 32;                pass &= fe_state_bytes(&cfg) == 0;
+
+    printf("  Unsupported low-latency configs rejected     : [%s]\n", pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Low-latency mode (N=%d) ---\n", FRAME_LEN);
+
+    failures += test_design();
+    failures += test_passthrough(16);
+    failures += test_passthrough(32);
+    failures += test_suppression();
+    failures += test_config();
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
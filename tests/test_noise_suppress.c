@@ -0,0 +1,193 @@
+/**
+ * @file test_noise_suppress.c
+ * @brief Sub-window minimum tracking: window span, no reset jumps in the
+ *        noise estimate, level steps tracked in both precisions, the same
+ *        cost on every hop of a sub-window.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "module/noise_suppress.h"
+
+#define N_BINS    129
+#define TRACK_LEN 20                                   /* frames */
+#define SUB_LEN   ((TRACK_LEN + NS_SUBWIN_COUNT - 1) / NS_SUBWIN_COUNT)
+
+static ns_bin_t bins[N_BINS];
+static q31_t sub_min[NS_SUBWIN_COUNT * N_BINS];
+static ns_bin_f32_t bins_f[N_BINS];
+static float sub_min_f[NS_SUBWIN_COUNT * N_BINS];
+static q31_t power[N_BINS];
+static float power_f[N_BINS];
+
+static uint32_t lcg = 99;
+
+/* Exponentially distributed periodogram value around @p mean */
+static double periodogram(double mean)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    double u = ((lcg >> 8) + 0.5) / 16777216.0;
+    return -mean * log(u);
+}
+
+static q31_t window_min(size_t k)
+{
+    return bins[k].power_min < bins[k].win_min ? bins[k].power_min : bins[k].win_min;
+}
+
+/* A single low frame is the window minimum for at least TRACK_LEN frames
+   and ages out within TRACK_LEN + SUB_LEN */
+static int test_window_span(void)
+{
+    noise_suppress_state_t ns;
+    noise_suppress_init(&ns, bins, sub_min, N_BINS);
+
+    int remembered = 0;
+    for (int f = 0; f < 200; f++) {
+        for (size_t k = 0; k < N_BINS; k++) power[k] = (f == 50) ? 1000 : 1000000;
+        noise_suppress_update(&ns, power, N_BINS, 0, TRACK_LEN);
+        if (window_min(0) == 1000) remembered = f - 50 + 1;
+    }
+
+    int pass = remembered >= TRACK_LEN && remembered <= TRACK_LEN + SUB_LEN &&
+               window_min(N_BINS - 1) == 1000000;
+    printf("  Dip held for %d frames (window %d..%d)   : [%s]\n", remembered, TRACK_LEN,
+           TRACK_LEN + SUB_LEN, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* Stationary noise: the estimate creeps, it never jumps when the window slides */
+static int test_no_reset_jumps(void)
+{
+    noise_suppress_state_t ns;
+    noise_suppress_init(&ns, bins, sub_min, N_BINS);
+
+    double max_step = 0.0, prev = 0.0;
+    for (int f = 0; f < 1000; f++) {
+        for (size_t k = 0; k < N_BINS; k++) power[k] = (q31_t)periodogram(1e6);
+        noise_suppress_update(&ns, power, N_BINS, 0, TRACK_LEN);
+
+        /* Noise floor across the band */
+        double level = 0.0;
+        for (size_t k = 0; k < N_BINS; k++) level += bins[k].noise_est;
+        if (f >= 200) {
+            double step = fabs(level - prev) / prev;
+            if (step > max_step) max_step = step;
+        }
+        prev = level;
+    }
+
+    /* A full reset restarts the minimum at a fresh periodogram value
+       (mean 1e6 vs a floor near 1e6 / TRACK_LEN): steps of tens of % */
+    int pass = max_step < 0.08;
+    printf("  Band noise floor max hop step %.1f%%  : [%s]\n", 100.0 * max_step,
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* Level steps down and up are followed, float path in lock-step */
+static int test_tracking(void)
+{
+    noise_suppress_state_t ns;
+    noise_suppress_f32_t ns_f;
+    noise_suppress_init(&ns, bins, sub_min, N_BINS);
+    noise_suppress_init_f32(&ns_f, bins_f, sub_min_f, N_BINS);
+
+    double level[3] = {0.0, 0.0, 0.0};
+    double max_rel = 0.0;
+    for (int f = 0; f < 600; f++) {
+        double mean = (f < 200) ? 1e6 : (f < 400) ? 1e5 : 1e6;
+        for (size_t k = 0; k < N_BINS; k++) {
+            power[k] = (q31_t)periodogram(mean);
+            power_f[k] = (float)power[k] * 0x1p-31f;
+        }
+        noise_suppress_update(&ns, power, N_BINS, 0, TRACK_LEN);
+        noise_suppress_update_f32(&ns_f, power_f, N_BINS, 0, TRACK_LEN);
+        if (f % 200 == 199) {
+            double sum = 0.0;
+            for (size_t k = 0; k < N_BINS; k++) sum += bins[k].noise_est;
+            level[f / 200] = sum / N_BINS;
+        }
+        for (size_t k = 0; k < N_BINS; k++) {
+            double q = bins[k].noise_est, fl = (double)bins_f[k].noise_est * 2147483648.0;
+            double rel = fabs(q - fl) / (fl + 1.0);
+            if (rel > max_rel) max_rel = rel;
+        }
+    }
+
+    /* Minimum statistics sit below the mean; both steps are a decade */
+    int pass = level[1] < 0.2 * level[0] && level[2] > 5.0 * level[1] && max_rel < 0.01;
+    printf("  Steps tracked %.0f -> %.0f -> %.0f, f32 rel %.1e : [%s]\n",
+           level[0], level[1], level[2], max_rel, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Per-hop cost by position in the sub-window: the fastest of many runs of
+   each position, so scheduler noise drops out. A completing hop that folds
+   the ring on top of the regular pass costs 2x or more the others. */
+static int test_hop_cost(uint8_t f32, const char *name)
+{
+    enum { BIG_BINS = 1025, ROUNDS = 400 };
+    ns_bin_t *bq = malloc(BIG_BINS * sizeof(*bq));
+    ns_bin_f32_t *bf = malloc(BIG_BINS * sizeof(*bf));
+    q31_t *rq = malloc(NS_SUBWIN_COUNT * BIG_BINS * sizeof(*rq));
+    float *rf = malloc(NS_SUBWIN_COUNT * BIG_BINS * sizeof(*rf));
+    q31_t *pq = malloc(BIG_BINS * sizeof(*pq));
+    float *pf = malloc(BIG_BINS * sizeof(*pf));
+    noise_suppress_state_t ns;
+    noise_suppress_f32_t ns_f;
+    noise_suppress_init(&ns, bq, rq, BIG_BINS);
+    noise_suppress_init_f32(&ns_f, bf, rf, BIG_BINS);
+    for (size_t k = 0; k < BIG_BINS; k++) {
+        pq[k] = (q31_t)periodogram(1e6);
+        pf[k] = (float)pq[k] * 0x1p-31f;
+    }
+
+    double best[SUB_LEN];
+    for (int c = 0; c < SUB_LEN; c++) best[c] = 1e9;
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int c = 0; c < SUB_LEN; c++) {
+            double t0 = now_sec();
+            if (f32) noise_suppress_update_f32(&ns_f, pf, BIG_BINS, 0, TRACK_LEN);
+            else     noise_suppress_update(&ns, pq, BIG_BINS, 0, TRACK_LEN);
+            double dt = now_sec() - t0;
+            if (dt < best[c]) best[c] = dt;
+        }
+    }
+
+    double lo = best[0], hi = best[0];
+    for (int c = 1; c < SUB_LEN; c++) {
+        if (best[c] < lo) lo = best[c];
+        if (best[c] > hi) hi = best[c];
+    }
+    int pass = hi < 1.5 * lo;
+    printf("  %-4s hop cost across a sub-window: %.2f..%.2f us : [%s]\n", name,
+           1e6 * lo, 1e6 * hi, pass ? "PASS" : "FAIL");
+    free(bq); free(bf); free(rq); free(rf); free(pq); free(pf);
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Noise suppressor minimum statistics ---\n");
+
+    failures += test_window_span();
+    failures += test_no_reset_jumps();
+    failures += test_tracking();
+    failures += test_hop_cost(0, "Q31");
+    failures += test_hop_cost(1, "F32");
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_offline.c
+ * @brief Offline time-parallel mode: chunked output tracks a serial
+ *        fe_process_hop() run once the warm-up has converged, is
+ *        independent of the worker count, and reports its warm-up.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_offline.h"
+#include "test_fe_common.h"
+
+#define FS         16000
+#define N_SAMPLES  (24 * FS)
+#define CHUNK_LEN  (4 * FS)
+
+/* Speech-like input: 200 ms harmonic syllables with a gliding pitch, in
+   words of four separated by 600 ms pauses, over noise whose level drifts
+   by 12 dB */
+static void make_input(q15_t *x, uint8_t ch)
+{
+    for (size_t i = 0; i < N_SAMPLES; i++) {
+        double t = (double)i / FS;
+        double tw = fmod(t, 2.0), ts = fmod(tw, 0.35);
+        double voiced = 0.0;
+        if (tw < 1.4 && ts < 0.2) {
+            double f0 = 120.0 + 60.0 * sin(2.0 * M_PI * t / 3.1);
+            double env = sin(M_PI * ts / 0.2);
+            for (int h = 1; h <= 4; h++) voiced += sin(2.0 * M_PI * h * f0 * t) / h;
+            voiced *= 0.15 * env * env;
+        }
+        double floor = 0.02 * (1.0 + 0.6 * sin(2.0 * M_PI * t / 13.0));
+        for (uint8_t c = 0; c < ch; c++) {
+            x[i * ch + c] = (q15_t)lrint((voiced + floor * test_noise()) * 32767.0);
+        }
+    }
+}
+
+/* Serial reference, delay removed: ref[t] = stream output at t + latency */
+static void run_serial(const fe_config_t *cfg, const q15_t *in, q15_t *ref)
+{
+    size_t ch = cfg->num_channels, hop = cfg->hop_len;
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(cfg));
+    size_t scratch_sz = fe_scratch_bytes(cfg);
+    void *scratch = malloc(scratch_sz);
+    q15_t *pad = (q15_t *)calloc(hop * ch, sizeof(q15_t));
+    q15_t *out = (q15_t *)malloc(hop * ch * sizeof(q15_t));
+
+    fe_init(cfg, state, scratch, scratch_sz);
+    size_t lat = fe_latency(state);
+    for (size_t s0 = 0; s0 < N_SAMPLES + lat; s0 += hop) {
+        const q15_t *src = (s0 + hop <= N_SAMPLES) ? in + s0 * ch : pad;
+        fe_process_hop(state, src, out, NULL, 0);
+        for (size_t i = 0; i < hop; i++) {
+            size_t s = s0 + i;
+            if (s < lat || s - lat >= N_SAMPLES) continue;
+            memcpy(&ref[(s - lat) * ch], &out[i * ch], ch * sizeof(q15_t));
+        }
+    }
+    free(out);
+    free(pad);
+    free(scratch);
+    free(state);
+}
+
+static fe_status_t run_offline(const fe_config_t *cfg, const fe_offline_opts_t *opts,
+                               const q15_t *in, q15_t *out, fe_offline_report_t *rep)
+{
+    size_t sz = fe_offline_bytes(cfg, opts, N_SAMPLES);
+    void *mem = malloc(sz);
+    fe_status_t st = fe_offline_process(mem, sz, cfg, opts, in, out, N_SAMPLES, rep);
+    free(mem);
+    return st;
+}
+
+/* SNR of y against ref over samples [t0, t1), dB */
+static double snr(const q15_t *ref, const q15_t *y, size_t ch, size_t t0, size_t t1)
+{
+    double sig = 0.0, err = 0.0;
+    for (size_t i = t0 * ch; i < t1 * ch; i++) {
+        double d = (double)y[i] - ref[i];
+        sig += (double)ref[i] * ref[i];
+        err += d * d;
+    }
+    return 10.0 * log10(sig / (err + 1e-30));
+}
+
+/* Worst SNR over a 100 ms window around each chunk boundary */
+static double worst_seam(const q15_t *ref, const q15_t *y, size_t ch, uint32_t chunk_len)
+{
+    double worst = 1e9;
+    for (size_t b = chunk_len; b < N_SAMPLES; b += chunk_len) {
+        double s = snr(ref, y, ch, b - FS / 20, b + FS / 20 < N_SAMPLES ? b + FS / 20 : N_SAMPLES);
+        if (s < worst) worst = s;
+    }
+    return worst;
+}
+
+static int test_channels(uint8_t ch)
+{
+    int failures = 0;
+    size_t total = (size_t)N_SAMPLES * ch;
+    q15_t *in  = (q15_t *)malloc(total * sizeof(q15_t));
+    q15_t *ref = (q15_t *)malloc(total * sizeof(q15_t));
+    q15_t *par = (q15_t *)malloc(total * sizeof(q15_t));
+    q15_t *one = (q15_t *)malloc(total * sizeof(q15_t));
+    q15_t *cold = (q15_t *)malloc(total * sizeof(q15_t));
+    fe_config_t cfg;
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, ch, 256, 128);
+    make_input(in, ch);
+    run_serial(&cfg, in, ref);
+
+    printf("\n  %u channel(s), %d s, chunk %d s:\n", ch, N_SAMPLES / FS, CHUNK_LEN / FS);
+
+    /* Default warm-up, 4 workers */
+    fe_offline_opts_t opts = { .n_workers = 4, .chunk_len = CHUNK_LEN };
+    fe_offline_report_t rep;
+    fe_status_t st = run_offline(&cfg, &opts, in, par, &rep);
+    int pass = st == FE_OK && rep.warmup_len == fe_offline_default_warmup(&cfg) &&
+               rep.warmup_len == FE_OFFLINE_WARMUP_HOPS * cfg.hop_len &&
+               rep.warmup_ms == rep.warmup_len * 1000u / FS &&
+               rep.chunk_len == CHUNK_LEN && rep.n_chunks == (N_SAMPLES + 128 + CHUNK_LEN - 1) / CHUNK_LEN &&
+               rep.xfade_len == FE_OFFLINE_XFADE_HOPS * cfg.hop_len && rep.n_workers == 4 &&
+               rep.processed > (uint64_t)N_SAMPLES;
+    printf("    report: warm-up %u (%u ms), xfade %u, %u chunks on %u workers, %.1f%% extra work : [%s]\n",
+           rep.warmup_len, rep.warmup_ms, rep.xfade_len, rep.n_chunks, rep.n_workers,
+           100.0 * ((double)rep.processed / N_SAMPLES - 1.0), pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    /* First chunk has no warm-up to discard: exact up to the first crossfade */
+    size_t exact = CHUNK_LEN - 128 - rep.xfade_len;
+    pass = memcmp(ref, par, exact * ch * sizeof(q15_t)) == 0;
+    printf("    first chunk bit-exact vs serial                 : [%s]\n", pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    double s_all = snr(ref, par, ch, 0, N_SAMPLES);
+    double s_seam = worst_seam(ref, par, ch, CHUNK_LEN);
+    pass = s_all >= 40.0 && s_seam >= 30.0;
+    printf("    vs serial: SNR %.1f dB overall, %.1f dB worst seam    : [%s]\n",
+           s_all, s_seam, pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    /* Worker count does not change the result */
+    opts.n_workers = 1;
+    st = run_offline(&cfg, &opts, in, one, &rep);
+    pass = st == FE_OK && rep.n_workers == 1 && memcmp(one, par, total * sizeof(q15_t)) == 0;
+    printf("    1 worker == 4 workers, bit-exact                 : [%s]\n", pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    /* Without a warm-up the seams are audibly worse */
+    opts.n_workers  = 4;
+    opts.warmup_len = cfg.hop_len;
+    st = run_offline(&cfg, &opts, in, cold, &rep);
+    double s_cold = worst_seam(ref, cold, ch, CHUNK_LEN);
+    pass = st == FE_OK && rep.warmup_len == cfg.hop_len && s_cold + 10.0 < s_seam;
+    printf("    1-hop warm-up: worst seam %.1f dB                 : [%s]\n",
+           s_cold, pass ? "PASS" : "FAIL");
+    failures += !pass;
+
+    free(cold);
+    free(one);
+    free(par);
+    free(ref);
+    free(in);
+    return failures;
+}
+
+/* Short files, the default options and argument checks */
+static int test_edges(void)
+{
+    fe_config_t cfg;
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, 256, 128);
+    q15_t in[1000], out[1000], ref[1000];
+    for (size_t i = 0; i < 1000; i++) in[i] = (q15_t)(i * 37 % 2000 - 1000);
+
+    size_t sz = fe_offline_bytes(&cfg, NULL, 1000);
+    void *mem = malloc(sz);
+    fe_offline_report_t rep;
+    int pass = fe_offline_process(mem, sz, &cfg, NULL, in, out, 1000, &rep) == FE_OK &&
+               rep.n_chunks == 1 && rep.n_workers == 1;
+
+    /* One chunk is a plain serial run */
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    void *scratch = malloc(scratch_sz);
+    q15_t hop_in[128], hop_out[128];
+    fe_init(&cfg, state, scratch, scratch_sz);
+    for (size_t s0 = 0; s0 < 1000 + 128; s0 += 128) {
+        for (size_t i = 0; i < 128; i++) hop_in[i] = (s0 + i < 1000) ? in[s0 + i] : 0;
+        fe_process_hop(state, hop_in, hop_out, NULL, 0);
+        for (size_t i = 0; i < 128; i++) {
+            if (s0 + i >= 128 && s0 + i - 128 < 1000) ref[s0 + i - 128] = hop_out[i];
+        }
+    }
+    pass &= memcmp(out, ref, sizeof(out)) == 0;
+
+    pass &= fe_offline_process(mem, sz, &cfg, NULL, in, out, 0, &rep) == FE_OK && rep.n_chunks == 0;
+    pass &= fe_offline_process(mem, sz - 64, &cfg, NULL, in, out, 1000, NULL) == FE_ERR_NO_MEM;
+    pass &= fe_offline_process(NULL, sz, &cfg, NULL, in, out, 1000, NULL) == FE_ERR_NULL_PTR;
+    cfg.input_rate = 48000;
+    pass &= fe_offline_bytes(&cfg, NULL, 1000) == 0 &&
+            fe_offline_process(mem, sz, &cfg, NULL, in, out, 1000, NULL) == FE_ERR_BAD_CONFIG;
+
+    printf("\n  short file == serial, empty input, argument checks : [%s]\n", pass ? "PASS" : "FAIL");
+    free(scratch);
+    free(state);
+    free(mem);
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Offline time-parallel processing ---\n");
+    test_noise_seed(11);
+
+    failures += test_channels(1);
+    failures += test_channels(2);
+    failures += test_edges();
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
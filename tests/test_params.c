@@ -0,0 +1,366 @@
+/**
+ * @file test_params.c
+ * @brief Runtime parameter updates: republishing the init set changes
+ *        nothing, new sets apply at the next hop and converge on an
+ *        instance configured with them, enable toggles ramp without a
+ *        step, the audio thread never applies a torn set while another
+ *        thread publishes, and sets needing absent state are rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "rtafe/fe_api.h"
+#include "test_fe_common.h"
+
+#define N_HOPS   400
+#define HOP      128
+#define FRAME    256
+
+typedef struct {
+    fe_state_t *state;
+    void       *scratch;
+} inst_t;
+
+/* Tone bursts over noise, plus a DC offset */
+static void make_hop(q15_t *x, size_t hop, double dc)
+{
+    for (size_t i = 0; i < HOP; i++) {
+        double t = (double)(hop * HOP + i) / 16000.0;
+        double v = fmod(t, 0.5) < 0.25 ? 0.2 * sin(2.0 * M_PI * 220.0 * t) : 0.0;
+        x[i] = (q15_t)lrint((v + 0.02 * test_noise() + dc) * 32767.0);
+    }
+}
+
+static int inst_init(inst_t *in, const fe_config_t *cfg)
+{
+    size_t sz = fe_scratch_bytes(cfg);
+    in->state = (fe_state_t *)malloc(fe_state_bytes(cfg));
+    in->scratch = malloc(sz);
+    return fe_init(cfg, in->state, in->scratch, sz) == FE_OK;
+}
+
+static void inst_free(inst_t *in)
+{
+    free(in->scratch);
+    free(in->state);
+}
+
+/* Re-publishing the active set every hop leaves the output bit-identical */
+static int test_identity(uint8_t precision, const char *name)
+{
+    fe_config_t cfg;
+    test_config(&cfg, precision, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    inst_t a, b;
+    int ok = inst_init(&a, &cfg) && inst_init(&b, &cfg);
+
+    fe_params_t p;
+    ok &= fe_params_get(b.state, &p) == FE_OK;
+    ok &= p.dc_rm_alpha == b.state->params.dc_rm_alpha && p.pre_emphasis_alpha == 0x7333 &&
+          p.ns_over_sub == FE_NS_OVER_SUB_UNITY && p.ns_floor == FE_NS_FLOOR_DEFAULT &&
+          p.flags == (cfg.flags | FE_FLAG_DC_REMOVAL | FE_FLAG_PRE_EMPHASIS);
+
+    q15_t x[HOP], ya[HOP], yb[HOP];
+    size_t mismatches = 0;
+    for (size_t k = 0; k < N_HOPS; k++) {
+        make_hop(x, k, 0.0);
+        ok &= fe_params_set(b.state, &p) == FE_OK;
+        fe_process_hop(a.state, x, ya, NULL, 0);
+        fe_process_hop(b.state, x, yb, NULL, 0);
+        mismatches += memcmp(ya, yb, sizeof(ya)) != 0;
+    }
+    inst_free(&a);
+    inst_free(&b);
+
+    int pass = ok && mismatches == 0;
+    printf("  %-4s republished init set : %zu of %d hops differ : [%s]\n",
+           name, mismatches, N_HOPS, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* Pre-emphasis on and NS off mid-stream: once the frames and overlap tail
+   hold only post-ramp samples, output equals an instance configured that
+   way from the start (the conditioning filters are memoryless in alpha,
+   and without NS the spectral state never reaches the output) */
+static int test_converge(uint8_t precision, const char *name)
+{
+    const size_t k_set = 100;
+    fe_config_t ca, cb;
+    test_config(&ca, precision, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    ca.pre_emphasis_alpha = 0;
+    test_config(&cb, precision, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    cb.flags = FE_FLAG_VAD;
+    inst_t a, b;
+    int ok = inst_init(&a, &ca) && inst_init(&b, &cb);
+
+    fe_params_t p;
+    fe_params_get(a.state, &p);
+    p.flags &= (uint8_t)~FE_FLAG_NOISE_SUPPRESS;
+    p.pre_emphasis_alpha = 0x7333;
+
+    q15_t x[HOP], ya[HOP], yb[HOP];
+    size_t diff_before = 0, diff_after = 0;
+    for (size_t k = 0; k < N_HOPS; k++) {
+        make_hop(x, k, 0.0);
+        if (k == k_set) ok &= fe_params_set(a.state, &p) == FE_OK;
+        fe_process_hop(a.state, x, ya, NULL, 0);
+        fe_process_hop(b.state, x, yb, NULL, 0);
+        int same = memcmp(ya, yb, sizeof(ya)) == 0;
+        if (k == k_set) ok &= a.state->params.pre_emphasis_alpha == 0x7333;
+        if (k >= 20 && k < k_set) diff_before += !same;
+        if (k > k_set + FRAME / HOP) diff_after += !same;
+    }
+    inst_free(&a);
+    inst_free(&b);
+
+    int pass = ok && diff_before > 0 && diff_after == 0;
+    printf("  %-4s pre-emphasis on, NS off at hop %zu : %zu hops differ before, %zu after : [%s]\n",
+           name, k_set, diff_before, diff_after, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* NS strength: more over-subtraction, or a spectral floor above the
+   noise bins' power, removes more of the noise-only stretches */
+static int test_ns(uint8_t precision, const char *name)
+{
+    fe_config_t cfg;
+    test_config(&cfg, precision, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    cfg.pre_emphasis_alpha = 0;
+    double energy[3];
+    q31_t sets[3][2] = { { FE_NS_OVER_SUB_UNITY, FE_NS_FLOOR_DEFAULT },
+                         { 4 * FE_NS_OVER_SUB_UNITY, FE_NS_FLOOR_DEFAULT },
+                         { FE_NS_OVER_SUB_UNITY, 1024 } };
+
+    for (int s = 0; s < 3; s++) {
+        inst_t a;
+        inst_init(&a, &cfg);
+        test_noise_seed(11);
+        q15_t x[HOP], y[HOP];
+        energy[s] = 0.0;
+        for (size_t k = 0; k < N_HOPS; k++) {
+            make_hop(x, k, 0.0);
+            if (k == 50) {
+                fe_params_t p;
+                fe_params_get(a.state, &p);
+                p.ns_over_sub = (q15_t)sets[s][0];
+                p.ns_floor    = sets[s][1];
+                fe_params_set(a.state, &p);
+            }
+            fe_process_hop(a.state, x, y, NULL, 0);
+            /* Noise-only second half of each 0.5 s period, past the latency */
+            for (size_t i = 0; k > 60 && i < HOP; i++) {
+                double t = (double)(k * HOP + i - fe_latency(a.state)) / 16000.0;
+                if (fmod(t, 0.5) > 0.27 && fmod(t, 0.5) < 0.48) energy[s] += (double)y[i] * y[i];
+            }
+        }
+        inst_free(&a);
+    }
+
+    int pass = energy[1] < 0.9 * energy[0] && energy[2] < 0.9 * energy[0];
+    printf("  %-4s NS noise energy: default %.3g, over-sub 4x %.3g, floor 1024 %.3g : [%s]\n",
+           name, energy[0], energy[1], energy[2], pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* DC removal switched off and back on over a DC offset: the output walks
+   to the new level across a hop instead of stepping */
+static int test_ramp(uint8_t precision, const char *name)
+{
+    const double dc = 0.25;
+    fe_config_t cfg;
+    test_config(&cfg, precision, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    cfg.flags = 0;
+    cfg.pre_emphasis_alpha = 0;
+    inst_t a;
+    int ok = inst_init(&a, &cfg);
+
+    fe_params_t on, off;
+    fe_params_get(a.state, &on);
+    off = on;
+    off.flags &= (uint8_t)~FE_FLAG_DC_REMOVAL;
+
+    q15_t x[HOP], y[HOP];
+    int max_step = 0, prev = 0;
+    double mean_off = 0.0, mean_on = 0.0;
+    for (size_t k = 0; k < N_HOPS; k++) {
+        test_noise_seed(11);   /* same noise every hop: steps come from the ramp only */
+        for (size_t i = 0; i < HOP; i++) x[i] = (q15_t)lrint((dc + 0.0001 * test_noise()) * 32767.0);
+        if (k == 200) ok &= fe_params_set(a.state, &off) == FE_OK;
+        if (k == 300) ok &= fe_params_set(a.state, &on) == FE_OK;
+        fe_process_hop(a.state, x, y, NULL, 0);
+        for (size_t i = 0; i < HOP; i++) {
+            if (k > 150) {
+                int d = abs(y[i] - prev);
+                if (d > max_step) max_step = d;
+            }
+            prev = y[i];
+            if (k >= 280 && k < 300) mean_off += y[i] / (20.0 * HOP);
+            if (k >= 380) mean_on += y[i] / (20.0 * HOP);
+        }
+    }
+    inst_free(&a);
+
+    /* A hard switch would step by the whole offset (8192); ramped over a
+       128-sample hop it moves about 1 / 128 of it per sample */
+    int pass = ok && fabs(mean_off - dc * 32767.0) < 200.0 && fabs(mean_on) < 200.0 &&
+               max_step < 2 * 8192 / HOP;
+    printf("  %-4s DC removal off/on over %.2f offset: level %.0f / %.0f, max step %d : [%s]\n",
+           name, dc, mean_off, mean_on, max_step, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+/* ── Concurrent publisher ────────────────────────────────────────────────── */
+
+typedef struct {
+    fe_state_t *state;
+    volatile int stop;
+    size_t published;
+} ctl_t;
+
+/* Two sets whose every field differs, so a torn copy matches neither */
+static void ctl_set(fe_params_t *p, int which)
+{
+    p->flags              = FE_FLAG_DC_REMOVAL | FE_FLAG_PRE_EMPHASIS | FE_FLAG_NOISE_SUPPRESS |
+                            (which ? FE_FLAG_VAD : 0);
+    p->dc_rm_alpha        = which ? 0x7F000000 : 0x7E000000;
+    p->pre_emphasis_alpha = which ? 0x7333 : 0x6000;
+    p->ns_over_sub        = which ? 1024 : 768;
+    p->ns_floor           = which ? 20 : 10;
+}
+
+static int params_eq(const fe_params_t *a, const fe_params_t *b)
+{
+    return a->flags == b->flags && a->dc_rm_alpha == b->dc_rm_alpha &&
+           a->pre_emphasis_alpha == b->pre_emphasis_alpha &&
+           a->ns_over_sub == b->ns_over_sub && a->ns_floor == b->ns_floor;
+}
+
+static void *ctl_main(void *arg)
+{
+    ctl_t *c = (ctl_t *)arg;
+    fe_params_t p;
+    while (!__atomic_load_n(&c->stop, __ATOMIC_RELAXED)) {
+        ctl_set(&p, c->published & 1);
+        fe_params_set(c->state, &p);
+        c->published++;
+    }
+    return NULL;
+}
+
+static int test_concurrent(uint8_t precision, const char *name)
+{
+    fe_config_t cfg;
+    test_config(&cfg, precision, WINDOW_PAIR_HANN, 1, FRAME, 16);   /* short hops: many boundaries per publish */
+    cfg.pre_emphasis_alpha = 0;
+    inst_t a;
+    int ok = inst_init(&a, &cfg);
+
+    fe_params_t s[2];
+    ctl_set(&s[0], 0);
+    ctl_set(&s[1], 1);
+
+    ctl_t c = { a.state, 0, 0 };
+    pthread_t th;
+    pthread_create(&th, NULL, ctl_main, &c);
+
+    q15_t x[16], y[16];
+    size_t applied = 0, torn = 0;
+    uint32_t seq = a.state->ctl.applied;
+    for (size_t k = 0; k < 200000; k++) {
+        for (size_t i = 0; i < 16; i++) x[i] = (q15_t)lrint(0.1 * test_noise() * 32767.0);
+        fe_process_hop(a.state, x, y, NULL, 0);
+        if (a.state->ctl.applied != seq) {
+            seq = a.state->ctl.applied;
+            applied++;
+            torn += !params_eq(&a.state->params, &s[0]) && !params_eq(&a.state->params, &s[1]);
+            /* The filters land on the applied set after its ramp hop */
+            const fe_params_t *p = &a.state->params;
+            if (precision == FE_PRECISION_F32) {
+                fe_channel_f32_t *ch = fe_channel_f32(a.state, 0);
+                ok &= ch->dc.alpha == (float)p->dc_rm_alpha * 0x1p-31f &&
+                      ch->pre.alpha == (float)p->pre_emphasis_alpha * 0x1p-15f;
+            } else {
+                fe_channel_t *ch = fe_channel(a.state, 0);
+                ok &= ch->dc.alpha == p->dc_rm_alpha && ch->pre.alpha_q15 == p->pre_emphasis_alpha;
+            }
+        }
+    }
+    __atomic_store_n(&c.stop, 1, __ATOMIC_RELAXED);
+    pthread_join(th, NULL);
+    inst_free(&a);
+
+    int pass = ok && applied > 0 && torn == 0;
+    printf("  %-4s %zu sets published, %zu applied, %zu torn : [%s]\n",
+           name, c.published, applied, torn, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static int test_errors(void)
+{
+    fe_config_t cfg;
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    cfg.flags = FE_FLAG_VAD;
+    cfg.pre_emphasis_alpha = 0;
+    inst_t a;
+    int pass = inst_init(&a, &cfg);
+
+    fe_params_t p, q;
+    fe_params_get(a.state, &p);
+    q = p;
+    q.flags |= FE_FLAG_NOISE_SUPPRESS;                  /* no gain scratch */
+    pass &= fe_params_set(a.state, &q) == FE_ERR_BAD_CONFIG;
+    q = p;
+    q.dc_rm_alpha = -1;
+    pass &= fe_params_set(a.state, &q) == FE_ERR_BAD_CONFIG;
+    q = p;
+    q.ns_floor = -1;
+    pass &= fe_params_set(a.state, &q) == FE_ERR_BAD_CONFIG;
+    pass &= fe_params_set(NULL, &p) == FE_ERR_NULL_PTR && fe_params_set(a.state, NULL) == FE_ERR_NULL_PTR;
+    pass &= fe_params_get(NULL, &p) == FE_ERR_NULL_PTR;
+
+    /* Rejected sets are not published; a good one is, before any hop */
+    pass &= fe_params_get(a.state, &q) == FE_OK && params_eq(&p, &q);
+    p.flags &= (uint8_t)~FE_FLAG_VAD;
+    pass &= fe_params_set(a.state, &p) == FE_OK && fe_params_get(a.state, &q) == FE_OK &&
+            q.flags == p.flags && a.state->params.flags != p.flags;
+    inst_free(&a);
+
+    /* VAD alone needs only the spectral bins NS would also allocate */
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, FRAME, HOP);
+    cfg.flags = FE_FLAG_NOISE_SUPPRESS;
+    cfg.pre_emphasis_alpha = 0;
+    pass &= inst_init(&a, &cfg);
+    fe_params_get(a.state, &p);
+    p.flags |= FE_FLAG_VAD;
+    pass &= fe_params_set(a.state, &p) == FE_OK;
+    inst_free(&a);
+
+    printf("  unallocated NS, negative values, NULLs, publish before first hop : [%s]\n",
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Runtime parameter updates ---\n");
+    test_noise_seed(11);
+
+    failures += test_identity(FE_PRECISION_Q31, "Q31");
+    failures += test_identity(FE_PRECISION_Q15, "Q15");
+    failures += test_identity(FE_PRECISION_F32, "F32");
+    failures += test_converge(FE_PRECISION_Q31, "Q31");
+    failures += test_converge(FE_PRECISION_F32, "F32");
+    failures += test_ns(FE_PRECISION_Q31, "Q31");
+    failures += test_ns(FE_PRECISION_F32, "F32");
+    failures += test_ramp(FE_PRECISION_Q31, "Q31");
+    failures += test_ramp(FE_PRECISION_F32, "F32");
+    failures += test_concurrent(FE_PRECISION_Q31, "Q31");
+    failures += test_concurrent(FE_PRECISION_F32, "F32");
+    failures += test_errors();
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
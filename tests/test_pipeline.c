@@ -0,0 +1,219 @@
+/**
+ * @file test_pipeline.c
+ * @brief Stage-pipelined hops: output and VAD are a serial instance's,
+ *        exactly one hop later, for every precision, window and channel
+ *        count and across a runtime parameter change; bad configurations
+ *        are rejected; throughput is reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "rtafe/fe_pipeline.h"
+#include "test_fe_common.h"
+
+#define N_HOPS     600
+#define MAX_CH     8
+#define MAX_HOP    256
+
+/* Harmonic syllables over noise, a different pitch per channel */
+static void make_hop(q15_t *x, uint32_t fs, uint16_t hop_len, uint8_t ch, size_t hop)
+{
+    for (size_t i = 0; i < hop_len; i++) {
+        double t = (double)(hop * hop_len + i) / fs;
+        double ts = fmod(t, 0.5);
+        for (uint8_t c = 0; c < ch; c++) {
+            double v = 0.0;
+            if (ts < 0.25) {
+                double env = sin(M_PI * ts / 0.25);
+                v = 0.2 * env * env * sin(2.0 * M_PI * (110.0 + 20.0 * c) * t);
+            }
+            x[i * ch + c] = (q15_t)lrint((v + 0.01 * test_noise()) * 32767.0);
+        }
+    }
+}
+
+static int test_equivalence(uint8_t precision, uint8_t window, uint8_t ch, const char *name)
+{
+    fe_config_t cfg;
+    test_config(&cfg, precision, window, ch, 256, 128);
+    size_t hop = cfg.hop_len, n = hop * ch;
+
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    void *scratch = malloc(scratch_sz);
+    size_t pipe_sz = fe_pipeline_bytes(&cfg);
+    void *mem = malloc(pipe_sz);
+    fe_pipeline_t *pipe;
+
+    int ok = fe_init(&cfg, state, scratch, scratch_sz) == FE_OK &&
+             fe_pipeline_init(mem, pipe_sz, &cfg, &pipe) == FE_OK;
+    if (!ok) {
+        printf("  %-34s : init failed [FAIL]\n", name);
+        free(mem);
+        free(scratch);
+        free(state);
+        return 1;
+    }
+    ok &= fe_pipeline_latency(pipe) == fe_latency(state) + hop;
+
+    q15_t in[MAX_HOP * MAX_CH], ref[MAX_HOP * MAX_CH], out[MAX_HOP * MAX_CH];
+    uint8_t vad[MAX_CH + 1];
+    q15_t prob[MAX_CH + 1];
+    size_t mismatches = 0, speech_hops = 0;
+
+    /* Retuned mid-stream: both instances take the set up at the same hop */
+    fe_params_t params;
+    fe_params_get(state, &params);
+    params.pre_emphasis_alpha = 0x6000;
+    params.ns_over_sub        = 3 * FE_NS_OVER_SUB_UNITY / 2;
+
+    for (size_t k = 0; k <= N_HOPS; k++) {
+        make_hop(in, cfg.sample_rate, cfg.hop_len, ch, k);
+        if (k == N_HOPS / 2) {
+            ok &= fe_params_set(state, &params) == FE_OK &&
+                  fe_params_set(fe_pipeline_state(pipe), &params) == FE_OK;
+        }
+        ok &= fe_pipeline_process_hop(pipe, in, out, NULL, 0) == FE_OK;
+
+        if (k == 0) {
+            for (size_t i = 0; i < n; i++) ok &= out[i] == 0;
+        } else {
+            /* This call returned serial hop k - 1 */
+            mismatches += memcmp(out, ref, n * sizeof(q15_t)) != 0;
+            q15_t p;
+            for (uint8_t c = 0; c < ch; c++) {
+                ok &= fe_pipeline_vad_status(pipe, c, &p) == vad[c] && p == prob[c];
+            }
+            ok &= fe_pipeline_vad_status(pipe, FE_VAD_ANY_CHANNEL, &p) == vad[ch] && p == prob[ch];
+            ok &= fe_vad_status(fe_pipeline_state(pipe), FE_VAD_ANY_CHANNEL, NULL) == vad[ch];
+            speech_hops += vad[ch];
+        }
+
+        fe_process_hop(state, in, ref, NULL, 0);
+        for (uint8_t c = 0; c < ch; c++) vad[c] = fe_vad_status(state, c, &prob[c]);
+        vad[ch] = fe_vad_status(state, FE_VAD_ANY_CHANNEL, &prob[ch]);
+    }
+    fe_pipeline_destroy(pipe);
+
+    int pass = ok && mismatches == 0 && speech_hops > 0 && speech_hops < N_HOPS;
+    printf("  %-34s : %d hops, %zu mismatched, %zu speech : [%s]\n",
+           name, N_HOPS, mismatches, speech_hops, pass ? "PASS" : "FAIL");
+    free(mem);
+    free(scratch);
+    free(state);
+    return !pass;
+}
+
+static int test_errors(void)
+{
+    fe_config_t cfg;
+    fe_pipeline_t *pipe;
+    q15_t buf[MAX_HOP];
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, 256, 128);
+    size_t sz = fe_pipeline_bytes(&cfg);
+    void *mem = malloc(sz);
+
+    int pass = sz > fe_state_bytes(&cfg) + 2 * fe_scratch_bytes(&cfg);
+    pass &= fe_pipeline_init(mem, sz - 64, &cfg, &pipe) == FE_ERR_NO_MEM;
+    pass &= fe_pipeline_init(NULL, sz, &cfg, &pipe) == FE_ERR_NULL_PTR;
+    pass &= fe_pipeline_process_hop(NULL, buf, buf, NULL, 0) == FE_ERR_NULL_PTR;
+    pass &= fe_pipeline_vad_status(NULL, 0, NULL) == 0 && fe_pipeline_state(NULL) == NULL;
+
+    /* Low-latency blocks have no stage split */
+    fe_config_t ll = cfg;
+    ll.precision = FE_PRECISION_F32;
+    ll.mode      = FE_MODE_LOW_LATENCY;
+    ll.hop_len   = 32;
+    pass &= fe_state_bytes(&ll) > 0 && fe_pipeline_bytes(&ll) == 0 &&
+            fe_pipeline_init(mem, sz, &ll, &pipe) == FE_ERR_BAD_CONFIG;
+    cfg.hop_len = 100;
+    pass &= fe_pipeline_bytes(&cfg) == 0;
+
+    /* Destroy straight after init, and after a single hop */
+    cfg.hop_len = 128;
+    pass &= fe_pipeline_init(mem, sz, &cfg, &pipe) == FE_OK;
+    fe_pipeline_destroy(pipe);
+    memset(buf, 0, sizeof(buf));
+    pass &= fe_pipeline_init(mem, sz, &cfg, &pipe) == FE_OK &&
+            fe_pipeline_process_hop(pipe, buf, buf, NULL, 0) == FE_OK;
+    fe_pipeline_destroy(pipe);
+    free(mem);
+
+    printf("  small arena, NULLs, low-latency mode, bad hop, early destroy : [%s]\n",
+           pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 48 kHz, N = 512, 8 channels: hops per second serial vs pipelined.
+   Informational; the speedup needs three free cores. */
+static void bench(uint8_t precision, const char *name)
+{
+    const size_t hops = 2000;
+    fe_config_t cfg;
+    test_config(&cfg, precision, WINDOW_PAIR_SQRT_HANN, MAX_CH, 512, 256);
+    cfg.sample_rate = 48000;
+    size_t n = (size_t)cfg.hop_len * MAX_CH;
+    q15_t *in = (q15_t *)malloc(n * sizeof(q15_t));
+    q15_t *out = (q15_t *)malloc(n * sizeof(q15_t));
+    make_hop(in, cfg.sample_rate, cfg.hop_len, MAX_CH, 1);
+
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    void *scratch = malloc(scratch_sz);
+    fe_init(&cfg, state, scratch, scratch_sz);
+    double t0 = now_sec();
+    for (size_t k = 0; k < hops; k++) fe_process_hop(state, in, out, NULL, 0);
+    double serial = (now_sec() - t0) / hops;
+
+    size_t sz = fe_pipeline_bytes(&cfg);
+    void *mem = malloc(sz);
+    fe_pipeline_t *pipe;
+    fe_pipeline_init(mem, sz, &cfg, &pipe);
+    t0 = now_sec();
+    for (size_t k = 0; k < hops; k++) fe_pipeline_process_hop(pipe, in, out, NULL, 0);
+    double piped = (now_sec() - t0) / hops;
+    fe_pipeline_destroy(pipe);
+
+    double budget = (double)cfg.hop_len / cfg.sample_rate;
+    printf("  %-4s 48 kHz x %d, N = 512: serial %6.1f us/hop (%4.1f%% of budget), "
+           "pipelined %6.1f us/hop, %.2fx on %ld CPUs\n",
+           name, MAX_CH, serial * 1e6, 100.0 * serial / budget, piped * 1e6, serial / piped,
+           sysconf(_SC_NPROCESSORS_ONLN));
+
+    free(mem);
+    free(scratch);
+    free(state);
+    free(out);
+    free(in);
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- Stage-pipelined hop processing ---\n");
+    test_noise_seed(7);
+
+    failures += test_equivalence(FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, "Q31 Hann, mono");
+    failures += test_equivalence(FE_PRECISION_Q31, WINDOW_PAIR_SQRT_HANN, 4, "Q31 sqrt-Hann, 4 ch");
+    failures += test_equivalence(FE_PRECISION_Q15, WINDOW_PAIR_HANN, 3, "Q15 Hann, 3 ch");
+    failures += test_equivalence(FE_PRECISION_F32, WINDOW_PAIR_SQRT_HANN, 1, "F32 sqrt-Hann, mono");
+    failures += test_equivalence(FE_PRECISION_F32, WINDOW_PAIR_ASYM, MAX_CH, "F32 asymmetric, 8 ch");
+    failures += test_errors();
+
+    bench(FE_PRECISION_Q31, "Q31");
+    bench(FE_PRECISION_F32, "F32");
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
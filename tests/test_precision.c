@@ -0,0 +1,160 @@
+/**
+ * @file test_precision.c
+ * @brief float32 vs Q1.31 (and Q15-FFT) hop pipeline: output parity, VAD
+ *        agreement, noise estimate.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_api.h"
+
+#define FRAME_LEN   256
+#define HOP_LEN     (FRAME_LEN / 2)
+#define CHANNELS    2
+#define NOISE_HOPS  40
+#define SPEECH_HOPS 16
+#define TOTAL_HOPS  (NOISE_HOPS + SPEECH_HOPS + NOISE_HOPS)
+
+static uint32_t lcg = 777;
+
+static q15_t noise_sample(int amp)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return (q15_t)(((int32_t)(lcg >> 16) - 32768) * amp / 32768);
+}
+
+/* ch 0: noise → voiced burst → noise; ch 1: louder noise only (keeps the
+   Q1.31 power well above its truncation floor for the estimate check) */
+static void fill_hop(q15_t *pcm, int hop)
+{
+    int speech = (hop >= NOISE_HOPS && hop < NOISE_HOPS + SPEECH_HOPS);
+    for (int n = 0; n < HOP_LEN; n++) {
+        float t = (float)(hop * HOP_LEN + n) / 16000.0f;
+        int32_t s = noise_sample(300);
+        if (speech) {
+            float env = 0.6f + 0.4f * sinf(2.0f * M_PI * 4.0f * t);
+            s += (int32_t)(env * (6000.0f * sinf(2.0f * M_PI * 500.0f * t)
+                                + 3000.0f * sinf(2.0f * M_PI * 1500.0f * t)));
+        }
+        pcm[n * CHANNELS]     = (q15_t)s;
+        pcm[n * CHANNELS + 1] = noise_sample(3000);
+    }
+}
+
+static fe_state_t *make_engine(uint8_t precision, void **scratch)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate        = 16000;
+    cfg.frame_len          = FRAME_LEN;
+    cfg.hop_len            = HOP_LEN;
+    cfg.num_channels       = CHANNELS;
+    cfg.flags              = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg.dc_rm_alpha        = 0x7FD00000;
+    cfg.pre_emphasis_alpha = 0x5000;
+    cfg.precision          = precision;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    *scratch = malloc(scratch_sz);
+    if (fe_init(&cfg, state, *scratch, scratch_sz) != FE_OK) {
+        free(state);
+        free(*scratch);
+        return NULL;
+    }
+    return state;
+}
+
+int main(void)
+{
+    void *scratch_q, *scratch_f, *scratch_h;
+    fe_state_t *sq = make_engine(FE_PRECISION_Q31, &scratch_q);
+    fe_state_t *sf = make_engine(FE_PRECISION_F32, &scratch_f);
+    fe_state_t *sh = make_engine(FE_PRECISION_Q15, &scratch_h);
+    if (sq == NULL || sf == NULL || sh == NULL) {
+        printf("fe_init failed [FAIL]\n");
+        return 1;
+    }
+
+    static q15_t in[HOP_LEN * CHANNELS], out_q[HOP_LEN * CHANNELS], out_f[HOP_LEN * CHANNELS];
+    static q15_t out_h[HOP_LEN * CHANNELS];
+    int max_diff = 0, peak = 0, vad_mismatch = 0, speech_f = 0, noise_f = 0;
+    int max_diff_h = 0, vad_mismatch_h = 0;
+
+    for (int hop = 0; hop < TOTAL_HOPS; hop++) {
+        fill_hop(in, hop);
+        fe_process_hop(sq, in, out_q, NULL, 0);
+        fe_process_hop(sf, in, out_f, NULL, 0);
+        fe_process_hop(sh, in, out_h, NULL, 0);
+
+        /* Output parity on the loud channel: on channel 0 the Q1.31 noise
+           estimate sits near its truncation floor and the gains differ */
+        for (int i = 1; i < HOP_LEN * CHANNELS; i += CHANNELS) {
+            int d = abs((int)out_q[i] - (int)out_f[i]);
+            if (d > max_diff) max_diff = d;
+            d = abs((int)out_h[i] - (int)out_f[i]);
+            if (d > max_diff_h) max_diff_h = d;
+            if (abs((int)out_q[i]) > peak) peak = abs((int)out_q[i]);
+        }
+
+        uint8_t vq = fe_vad_status(sq, 0, NULL);
+        uint8_t vf = fe_vad_status(sf, 0, NULL);
+        vad_mismatch += (vq != vf);
+        vad_mismatch_h += (fe_vad_status(sh, 0, NULL) != vf);
+        if (hop >= NOISE_HOPS && hop < NOISE_HOPS + SPEECH_HOPS) speech_f += vf;
+        if (hop >= NOISE_HOPS / 2 && hop < NOISE_HOPS) noise_f += vf;
+        noise_f += fe_vad_status(sf, 1, NULL);
+    }
+
+    /* Noise estimates agree to within a few percent on the noise-only channel */
+    const ns_bin_t *bq = fe_channel(sq, 1)->ns.bins;
+    const ns_bin_f32_t *bf = fe_channel_f32(sf, 1)->ns.bins;
+    double num = 0.0, den = 0.0;
+    for (int k = 1; k < FRAME_LEN / 2; k++) {
+        double q = (double)bq[k].noise_est * 0x1p-31;
+        num += fabs(q - bf[k].noise_est);
+        den += q;
+    }
+    double rel = (den > 0.0) ? num / den : 1.0;
+
+    const ns_bin_t *bh = fe_channel(sh, 1)->ns.bins;
+    num = den = 0.0;
+    for (int k = 1; k < FRAME_LEN / 2; k++) {
+        double h = (double)bh[k].noise_est * 0x1p-31;
+        num += fabs(h - bf[k].noise_est);
+        den += h;
+    }
+    double rel_h = (den > 0.0) ? num / den : 1.0;
+
+    printf("\n--- float32 vs Q1.31 pipeline (%d ch, %d hops) ---\n", CHANNELS, TOTAL_HOPS);
+
+    /* Resynthesized output carries the NS gains: Q6.9 steps (1/512) bound
+       the difference relative to the peak */
+    int pass = (max_diff <= 2 + peak / 256);
+    int failures = !pass;
+    printf("  Ch 1 output max |diff| (LSB)   : %d of peak %d [%s]\n", max_diff, peak, pass ? "PASS" : "FAIL");
+
+    pass = (speech_f == SPEECH_HOPS) && (noise_f == 0) && (vad_mismatch <= 2);
+    failures += !pass;
+    printf("  F32 VAD speech %2d/%d, false %d, mismatches %d : [%s]\n",
+           speech_f, SPEECH_HOPS, noise_f, vad_mismatch, pass ? "PASS" : "FAIL");
+
+    pass = (rel < 0.05);
+    failures += !pass;
+    printf("  Noise estimate rel. diff       : %.4f [%s]\n", rel, pass ? "PASS" : "FAIL");
+
+    /* Q15 FFT: same gains and decisions, output within its ~65 dB transform SNR */
+    pass = (max_diff_h <= 24 + peak / 256) && (vad_mismatch_h <= 2) && (rel_h < 0.05);
+    failures += !pass;
+    printf("  Q15 vs F32: out diff %d LSB, VAD mismatches %d, noise rel %.4f [%s]\n",
+           max_diff_h, vad_mismatch_h, rel_h, pass ? "PASS" : "FAIL");
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+
+    free(sq); free(scratch_q);
+    free(sf); free(scratch_f);
+    free(sh); free(scratch_h);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file test_profile.c
+ * @brief Hot-path instrumentation: histogram counts and min <= mean/p99 <= max.
+ *        Always built with -DRTAFE_PROFILE (see Makefile).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rtafe/fe_api.h"
+
+#define FRAME_LEN 256
+#define HOP_LEN   (FRAME_LEN / 2)
+#define NUM_HOPS  200
+#define WARMUP    (FRAME_LEN / HOP_LEN - 1)   /* spectral stages skipped while the history fills */
+
+int main(void)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate  = 16000;
+    cfg.frame_len    = FRAME_LEN;
+    cfg.hop_len      = HOP_LEN;
+    cfg.num_channels = 2;
+    cfg.flags        = FE_FLAG_NOISE_SUPPRESS;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    void *scratch = malloc(scratch_sz);
+    if (fe_init(&cfg, state, scratch, scratch_sz) != FE_OK) {
+        printf("fe_init failed [FAIL]\n");
+        return 1;
+    }
+
+    static q15_t in[2 * FRAME_LEN], out[2 * FRAME_LEN];
+    uint32_t lcg = 3;
+    for (int hop = 0; hop < NUM_HOPS; hop++) {
+        for (int i = 0; i < 2 * FRAME_LEN; i++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            in[i] = (q15_t)((int32_t)(lcg >> 16) - 32768) / 8;
+        }
+        fe_process_hop(state, in, out, NULL, 0);
+    }
+
+    printf("\n--- Per-stage profile (%d hops) ---\n", NUM_HOPS);
+    fe_profile_dump(state, stdout);
+
+    int failures = 0;
+    for (int s = 0; s < FE_PROF_NUM_STAGES; s++) {
+        fe_prof_stats_t st;
+        fe_status_t rc = fe_profile_get(state, (fe_prof_stage_t)s, &st);
+        uint32_t expect = (s == FE_PROF_SPECTRAL || s == FE_PROF_GAIN) ? NUM_HOPS - WARMUP : NUM_HOPS;
+        int pass = (rc == FE_OK) && (st.count == expect) &&
+                   (st.min <= st.mean) && (st.mean <= st.max) &&
+                   (st.min <= st.p99) && (st.p99 <= st.max) && (st.max > 0);
+        failures += !pass;
+    }
+    printf("\n  Stage histograms consistent : [%s]\n", failures ? "FAIL" : "PASS");
+
+    fe_profile_reset(state);
+    fe_prof_stats_t st;
+    fe_profile_get(state, FE_PROF_HOP, &st);
+    int pass = (st.count == 0);
+    failures += !pass;
+    printf("  Reset clears histograms     : [%s]\n", pass ? "PASS" : "FAIL");
+
+    free(state);
+    free(scratch);
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
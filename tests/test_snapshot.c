@@ -0,0 +1,304 @@
+/**
+ * @file test_snapshot.c
+ * @brief State snapshots: a stream restored into another instance carries
+ *        on bit-identically for every precision, mode and SRC; a stored
+ *        noise profile warm-starts a differently framed instance; damaged
+ *        or mismatched images are rejected and leave the target untouched.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_snapshot.h"
+#include "test_fe_common.h"
+
+#define MAX_CH    4
+#define MAX_HOP   256
+#define MAX_IN    (3 * MAX_HOP)
+
+typedef struct {
+    fe_state_t *state;
+    void       *scratch;
+    q15_t       fifo[(MAX_IN + MAX_HOP) * MAX_CH];   /* resampled input waiting for a hop */
+    size_t      fifo_n;                              /* frames */
+} inst_t;
+
+/* Tone bursts (a pitch per channel) over noise, at the input rate */
+static void make_block(q15_t *x, size_t n, uint8_t ch, uint32_t rate, size_t t0, double tone)
+{
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)(t0 + i) / rate;
+        for (uint8_t c = 0; c < ch; c++) {
+            double v = fmod(t, 0.5) < 0.25 ? tone * sin(2.0 * M_PI * (200.0 + 30.0 * c) * t) : 0.0;
+            x[i * ch + c] = (q15_t)lrint((v + 0.02 * test_noise()) * 32767.0);
+        }
+    }
+}
+
+static int inst_init(inst_t *in, const fe_config_t *cfg)
+{
+    size_t sz = fe_scratch_bytes(cfg);
+    in->state = (fe_state_t *)malloc(fe_state_bytes(cfg));
+    in->scratch = malloc(sz);
+    in->fifo_n = 0;
+    return fe_init(cfg, in->state, in->scratch, sz) == FE_OK;
+}
+
+static void inst_free(inst_t *in)
+{
+    free(in->scratch);
+    free(in->state);
+}
+
+/* Feed one input block (through SRC if configured), run every complete
+   hop; returns the output frames written to @p out */
+static size_t inst_feed(inst_t *in, const q15_t *x, size_t n, q15_t *out)
+{
+    fe_state_t *s = in->state;
+    uint8_t ch = s->num_channels;
+    uint16_t hop = s->hop_len;
+    size_t n_out = 0;
+
+    in->fifo_n += fe_resample_input(s, x, n, in->fifo + in->fifo_n * ch);
+    size_t used = 0;
+    while (in->fifo_n - used >= hop) {
+        fe_process_hop(s, in->fifo + used * ch, out + n_out * ch, NULL, 0);
+        used += hop;
+        n_out += hop;
+    }
+    memmove(in->fifo, in->fifo + used * ch, (in->fifo_n - used) * ch * sizeof(q15_t));
+    in->fifo_n -= used;
+    return n_out;
+}
+
+/* Run A, move its stream into a fresh B mid-way, run both on */
+static int test_migrate(fe_config_t *cfg, const char *name)
+{
+    const size_t steps = 300, k_save = 150;
+    uint8_t ch = cfg->num_channels;
+    uint32_t in_rate = cfg->input_rate ? cfg->input_rate : cfg->sample_rate;
+    size_t block = (size_t)cfg->hop_len * in_rate / cfg->sample_rate;
+    inst_t a, b;
+    int ok = inst_init(&a, cfg) && inst_init(&b, cfg);
+
+    q15_t x[MAX_IN * MAX_CH], ya[2 * MAX_HOP * MAX_CH], yb[2 * MAX_HOP * MAX_CH];
+    size_t snap_sz = fe_snapshot_bytes(a.state);
+    uint8_t *snap = (uint8_t *)malloc(snap_sz);
+    uint8_t *snap_b = (uint8_t *)malloc(snap_sz);
+    size_t mismatches = 0, compared = 0;
+
+    /* Retuned before the save: the active set travels with the stream */
+    fe_params_t p;
+    fe_params_get(a.state, &p);
+    p.pre_emphasis_alpha = 0x6000;
+    p.ns_over_sub        = 2 * FE_NS_OVER_SUB_UNITY;
+
+    test_noise_seed(5);
+    for (size_t k = 0; k < steps; k++) {
+        make_block(x, block, ch, in_rate, k * block, 0.2);
+        if (k == k_save / 2) fe_params_set(a.state, &p);
+        size_t na = inst_feed(&a, x, block, ya);
+        if (k < k_save) continue;
+        if (k == k_save) {
+            /* The pending FIFO is the caller's: move it with the state */
+            ok &= fe_snapshot_save(a.state, snap, snap_sz) == FE_OK &&
+                  fe_snapshot_restore(b.state, snap, snap_sz, FE_SNAP_ALL) == FE_OK;
+            memcpy(b.fifo, a.fifo, sizeof(a.fifo));
+            b.fifo_n = a.fifo_n;
+            /* Restored B images byte for byte as A: no pointer leaks in */
+            ok &= fe_snapshot_save(b.state, snap_b, snap_sz) == FE_OK &&
+                  memcmp(snap, snap_b, snap_sz) == 0;
+            continue;
+        }
+        size_t nb = inst_feed(&b, x, block, yb);
+        ok &= na == nb;
+        mismatches += memcmp(ya, yb, na * ch * sizeof(q15_t)) != 0;
+        compared += na;
+    }
+    ok &= b.state->params.pre_emphasis_alpha == 0x6000 && b.state->params.ns_over_sub == p.ns_over_sub;
+
+    int pass = ok && mismatches == 0 && compared > 0;
+    printf("  %-30s : %zu-byte image, %zu frames after restore, %zu blocks differ : [%s]\n",
+           name, snap_sz, compared, mismatches, pass ? "PASS" : "FAIL");
+    free(snap_b);
+    free(snap);
+    inst_free(&a);
+    inst_free(&b);
+    return !pass;
+}
+
+static int migrate_all(void)
+{
+    int failures = 0;
+    fe_config_t cfg;
+
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 2, 256, 128);
+    failures += test_migrate(&cfg, "Q31 Hann, 2 ch");
+    test_config(&cfg, FE_PRECISION_Q15, WINDOW_PAIR_SQRT_HANN, 1, 256, 128);
+    failures += test_migrate(&cfg, "Q15 sqrt-Hann, mono");
+    test_config(&cfg, FE_PRECISION_F32, WINDOW_PAIR_ASYM, 3, 256, 64);
+    failures += test_migrate(&cfg, "F32 asymmetric, 3 ch");
+    test_config(&cfg, FE_PRECISION_F32, WINDOW_PAIR_HANN, 2, 256, 32);
+    cfg.mode = FE_MODE_LOW_LATENCY;
+    failures += test_migrate(&cfg, "F32 low-latency, 2 ch");
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, 256, 128);
+    cfg.input_rate = 48000;
+    failures += test_migrate(&cfg, "Q31 with 48 -> 16 kHz SRC");
+    return failures;
+}
+
+/* Channel 0 noise estimate summed over bins */
+static double noise_level(const fe_state_t *s)
+{
+    size_t n_bins = s->frame_len / 2 + 1;
+    double sum = 0.0;
+    for (size_t k = 0; k < n_bins; k++) {
+        sum += (s->precision == FE_PRECISION_F32)
+             ? fe_channel_f32(s, 0)->ns.bins[k].noise_est * 2147483648.0
+             : (double)fe_channel(s, 0)->ns.bins[k].noise_est;
+    }
+    return sum;
+}
+
+/* Train @p in on 3.2 s of tone bursts over noise */
+static void train(inst_t *in)
+{
+    uint16_t hop = in->state->hop_len;
+    q15_t x[MAX_HOP], y[2 * MAX_HOP];
+    test_noise_seed(5);
+    for (size_t t = 0; t < 51200; t += hop) {
+        make_block(x, hop, 1, 16000, t, 0.2);
+        inst_feed(in, x, hop, y);
+    }
+}
+
+/* A stored profile warm-starts a new stream: over its first 0.5 s its
+   noise estimate tracks that of the stream it was taken from, where a
+   cold instance is still converging. The profile also loads into an
+   instance framed with another hop. */
+static int test_warm_start(uint8_t precision, const char *name)
+{
+    const size_t hops = 62;
+    fe_config_t cfg, cfg64;
+    test_config(&cfg, precision, WINDOW_PAIR_HANN, 1, 256, 128);
+    test_config(&cfg64, precision, WINDOW_PAIR_SQRT_HANN, 1, 256, 64);
+    inst_t a, warm, cold, other;
+    int ok = inst_init(&a, &cfg) && inst_init(&warm, &cfg) && inst_init(&cold, &cfg) &&
+             inst_init(&other, &cfg64);
+
+    train(&a);
+    size_t sz = fe_snapshot_bytes(a.state);
+    uint8_t *snap = (uint8_t *)malloc(sz);
+    ok &= fe_snapshot_save(a.state, snap, sz) == FE_OK;
+    ok &= fe_snapshot_restore(warm.state, snap, sz, FE_SNAP_NOISE) == FE_OK;
+    ok &= fe_snapshot_restore(other.state, snap, sz, FE_SNAP_STREAM) == FE_ERR_BAD_CONFIG;
+    ok &= fe_snapshot_restore(other.state, snap, sz, FE_SNAP_NOISE) == FE_OK &&
+          noise_level(other.state) == noise_level(a.state);
+
+    /* Same noise into all three; mean relative distance from the source */
+    inst_t *run[3] = { &a, &warm, &cold };
+    double dev_warm = 0.0, dev_cold = 0.0;
+    q15_t x[MAX_HOP], y[2 * MAX_HOP];
+    for (size_t k = 0; k < hops; k++) {
+        double level[3];
+        for (int i = 0; i < 3; i++) {
+            test_noise_seed(77 + (uint32_t)k);
+            make_block(x, 128, 1, 16000, k * 128, 0.0);
+            inst_feed(run[i], x, 128, y);
+            level[i] = noise_level(run[i]->state);
+        }
+        dev_warm += fabs(level[1] - level[0]) / level[0] / hops;
+        dev_cold += fabs(level[2] - level[0]) / level[0] / hops;
+    }
+
+    int pass = ok && dev_cold > 4.0 * dev_warm;
+    printf("  %-4s stored profile: first 0.5 s estimate off by %.1f %% warm, %.1f %% cold : [%s]\n",
+           name, 100.0 * dev_warm, 100.0 * dev_cold, pass ? "PASS" : "FAIL");
+    free(snap);
+    inst_free(&a);
+    inst_free(&warm);
+    inst_free(&cold);
+    inst_free(&other);
+    return !pass;
+}
+
+static int test_errors(void)
+{
+    fe_config_t cfg;
+    test_config(&cfg, FE_PRECISION_Q31, WINDOW_PAIR_HANN, 1, 256, 128);
+    inst_t a, b;
+    int pass = inst_init(&a, &cfg) && inst_init(&b, &cfg);
+
+    test_noise_seed(5);
+    q15_t x[MAX_HOP], y[2 * MAX_HOP];
+    for (size_t k = 0; k < 50; k++) {
+        make_block(x, 128, 1, 16000, k * 128, 0.2);
+        inst_feed(&a, x, 128, y);
+    }
+
+    size_t sz = fe_snapshot_bytes(a.state);
+    uint8_t *snap = (uint8_t *)malloc(sz);
+    uint8_t *bad = (uint8_t *)malloc(sz);
+    uint8_t *before = (uint8_t *)malloc(sz);
+    uint8_t *after = (uint8_t *)malloc(sz);
+    pass &= fe_snapshot_bytes(NULL) == 0 && sz > sizeof(fe_snapshot_hdr_t);
+    pass &= fe_snapshot_save(a.state, snap, sz - 1) == FE_ERR_NO_MEM;
+    pass &= fe_snapshot_save(NULL, snap, sz) == FE_ERR_NULL_PTR;
+    pass &= fe_snapshot_save(a.state, snap, sz) == FE_OK;
+    pass &= fe_snapshot_restore(b.state, NULL, sz, FE_SNAP_ALL) == FE_ERR_NULL_PTR;
+    fe_snapshot_save(b.state, before, sz);
+
+    /* Damage: payload bit, header field, version, truncation */
+    memcpy(bad, snap, sz);
+    bad[sz / 2] ^= 0x10;
+    pass &= fe_snapshot_restore(b.state, bad, sz, FE_SNAP_ALL) == FE_ERR_CORRUPT;
+    memcpy(bad, snap, sz);
+    ((fe_snapshot_hdr_t *)bad)->hist_pos ^= 1;
+    pass &= fe_snapshot_restore(b.state, bad, sz, FE_SNAP_ALL) == FE_ERR_CORRUPT;
+    memcpy(bad, snap, sz);
+    ((fe_snapshot_hdr_t *)bad)->version++;
+    pass &= fe_snapshot_restore(b.state, bad, sz, FE_SNAP_ALL) == FE_ERR_CORRUPT;
+    pass &= fe_snapshot_restore(b.state, snap, sz - 1, FE_SNAP_ALL) == FE_ERR_CORRUPT;
+    pass &= fe_snapshot_restore(b.state, snap, sz, 0) == FE_ERR_BAD_CONFIG;
+    fe_snapshot_save(b.state, after, sz);
+    pass &= memcmp(before, after, sz) == 0;
+    inst_free(&b);
+
+    /* Mismatch: frame length, and a noise profile for an instance without one */
+    fe_config_t other = cfg;
+    other.frame_len = 512;
+    other.hop_len = 256;
+    pass &= inst_init(&b, &other) &&
+            fe_snapshot_restore(b.state, snap, sz, FE_SNAP_NOISE) == FE_ERR_BAD_CONFIG;
+    inst_free(&b);
+    other = cfg;
+    other.flags = 0;
+    pass &= inst_init(&b, &other) &&
+            fe_snapshot_restore(b.state, snap, sz, FE_SNAP_NOISE) == FE_ERR_BAD_CONFIG;
+    inst_free(&b);
+
+    printf("  small buffer, NULLs, damaged / truncated / mismatched images : [%s]\n",
+           pass ? "PASS" : "FAIL");
+    free(after);
+    free(before);
+    free(bad);
+    free(snap);
+    inst_free(&a);
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    printf("\n--- State snapshot / restore ---\n");
+    test_noise_seed(5);
+
+    failures += migrate_all();
+    failures += test_warm_start(FE_PRECISION_Q31, "Q31");
+    failures += test_warm_start(FE_PRECISION_F32, "F32");
+    failures += test_errors();
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
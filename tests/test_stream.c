@@ -0,0 +1,152 @@
+/**
+ * @file test_stream.c
+ * @brief Stream pool: many streams on worker threads, run stage-major in
+ *        rounds, match sequential single-instance runs (output and VAD) for
+ *        every precision, mono and stereo, and the low-latency mode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rtafe/fe_stream.h"
+
+#define N_STREAMS     48
+#define N_WORKERS     4
+#define HOPS_PER_TICK 3
+#define N_TICKS       8
+#define N_HOPS        (HOPS_PER_TICK * N_TICKS)
+
+static q15_t input_sample(uint32_t stream, uint32_t hop, uint32_t i)
+{
+    uint32_t x = (stream * 2654435761u) ^ (hop * 40503u) ^ (i * 2246822519u);
+    x ^= x >> 15;
+    x *= 2246822519u;
+    x ^= x >> 13;
+    return (q15_t)((int32_t)(x & 0xFFFF) - 32768) / 4;
+}
+
+static void config(fe_config_t *cfg, uint8_t precision, uint8_t channels, uint8_t mode)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->sample_rate        = 16000;
+    cfg->frame_len          = 256;
+    cfg->hop_len            = (mode == FE_MODE_LOW_LATENCY) ? 32 : 128;
+    cfg->num_channels       = channels;
+    cfg->flags              = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg->pre_emphasis_alpha = 0x7AE1;
+    cfg->precision          = precision;
+    cfg->mode               = mode;
+    if (mode == FE_MODE_LOW_LATENCY) cfg->window = WINDOW_PAIR_SQRT_HANN;
+}
+
+static int run_config(const fe_config_t *cfg, const char *name)
+{
+    size_t hop_samples = (size_t)cfg->hop_len * cfg->num_channels;
+    size_t in_sz = (size_t)N_STREAMS * N_HOPS * hop_samples;
+    q15_t *in  = (q15_t *)malloc(in_sz * sizeof(q15_t));
+    q15_t *out = (q15_t *)calloc(in_sz, sizeof(q15_t));
+    q15_t *ref = (q15_t *)malloc(in_sz * sizeof(q15_t));
+    uint8_t vad_ref[N_STREAMS];
+    for (uint32_t s = 0; s < N_STREAMS; s++) {
+        for (uint32_t h = 0; h < N_HOPS; h++) {
+            for (uint32_t i = 0; i < hop_samples; i++) {
+                in[((size_t)s * N_HOPS + h) * hop_samples + i] = input_sample(s, h, i);
+            }
+        }
+    }
+
+    /* Reference: one instance per stream, hops in order on this thread */
+    size_t state_sz = fe_state_bytes(cfg);
+    size_t scratch_sz = fe_scratch_bytes(cfg);
+    fe_state_t *state = (fe_state_t *)malloc(state_sz);
+    void *scratch = malloc(scratch_sz);
+    for (uint32_t s = 0; s < N_STREAMS; s++) {
+        fe_init(cfg, state, scratch, scratch_sz);
+        for (uint32_t h = 0; h < N_HOPS; h++) {
+            size_t off = ((size_t)s * N_HOPS + h) * hop_samples;
+            fe_process_hop(state, &in[off], &ref[off], NULL, 0);
+        }
+        vad_ref[s] = fe_vad_status(state, FE_VAD_ANY_CHANNEL, NULL);
+    }
+
+    /* Pool: submit a few hops per stream per tick, never waiting in between */
+    size_t pool_sz = fe_stream_pool_bytes(cfg, N_STREAMS, N_WORKERS);
+    void *mem = malloc(pool_sz);
+    fe_stream_pool_t *pool = NULL;
+    fe_status_t st = fe_stream_pool_init(mem, pool_sz, cfg, N_STREAMS, N_WORKERS, &pool);
+
+    int busy_seen = 0;
+    for (uint32_t t = 0; t < N_TICKS && st == FE_OK; t++) {
+        for (uint32_t s = 0; s < N_STREAMS; s++) {
+            for (uint32_t k = 0; k < HOPS_PER_TICK; k++) {
+                size_t off = ((size_t)s * N_HOPS + t * HOPS_PER_TICK + k) * hop_samples;
+                while (fe_stream_submit(pool, s, &in[off], &out[off]) == FE_ERR_BUSY) {
+                    busy_seen = 1;
+                    fe_stream_dispatch(pool);
+                }
+            }
+        }
+        fe_stream_dispatch(pool);
+    }
+    if (st == FE_OK) fe_stream_wait(pool);
+
+    uint32_t done = 0;
+    int vad_match = (st == FE_OK);
+    for (uint32_t s = 0; st == FE_OK && s < N_STREAMS; s++) {
+        done += fe_stream_completed(pool, s);
+        vad_match &= fe_vad_status(fe_stream_state(pool, s), FE_VAD_ANY_CHANNEL, NULL) == vad_ref[s];
+    }
+    int exact = (st == FE_OK) && memcmp(out, ref, in_sz * sizeof(q15_t)) == 0;
+    int pass = exact && vad_match && (done == N_STREAMS * N_HOPS);
+
+    printf("  %-14s hops %u/%u, bit-exact %d, VAD %d (queue full seen=%d) : [%s]\n", name,
+           done, N_STREAMS * N_HOPS, exact, vad_match, busy_seen, pass ? "PASS" : "FAIL");
+
+    if (st == FE_OK) fe_stream_pool_destroy(pool);
+    free(mem);
+    free(state);
+    free(scratch);
+    free(in);
+    free(out);
+    free(ref);
+    return !pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+    fe_config_t cfg;
+
+    printf("\n--- Stream pool: %d streams x %d hops on %d workers ---\n",
+           N_STREAMS, N_HOPS, N_WORKERS);
+
+    config(&cfg, FE_PRECISION_Q31, 2, FE_MODE_STFT);
+    failures += run_config(&cfg, "Q31 stereo");
+    config(&cfg, FE_PRECISION_Q31, 1, FE_MODE_STFT);
+    failures += run_config(&cfg, "Q31 mono");
+    config(&cfg, FE_PRECISION_Q15, 2, FE_MODE_STFT);
+    failures += run_config(&cfg, "Q15 stereo");
+    config(&cfg, FE_PRECISION_F32, 3, FE_MODE_STFT);
+    failures += run_config(&cfg, "F32 3ch");
+    config(&cfg, FE_PRECISION_F32, 2, FE_MODE_LOW_LATENCY);
+    failures += run_config(&cfg, "F32 low-lat");
+
+    /* Bad ids / sizes are rejected */
+    config(&cfg, FE_PRECISION_Q31, 2, FE_MODE_STFT);
+    size_t pool_sz = fe_stream_pool_bytes(&cfg, 2, 1);
+    void *mem = malloc(pool_sz);
+    fe_stream_pool_t *pool = NULL;
+    q15_t buf[256];
+    int bad = fe_stream_pool_init(mem, pool_sz, &cfg, 2, 1, &pool) == FE_OK &&
+              fe_stream_submit(pool, 2, buf, buf) == FE_ERR_BAD_CONFIG &&
+              fe_stream_pool_bytes(&cfg, 2, 0) == 0 &&
+              fe_stream_state(pool, 2) == NULL;
+    printf("  Argument checks                                          : [%s]\n",
+           bad ? "PASS" : "FAIL");
+    fe_stream_pool_destroy(pool);
+    free(mem);
+    failures += !bad;
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_tables.c
+ * @brief Generated ROM tables: accuracy per size, size lookup, engine at N != 256
+ *        (generated with TABLE_SIZES or built by the runtime table cache).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_api.h"
+#include "tables.h"
+
+static int check_size(uint16_t n)
+{
+    const fe_tables_t *t = fe_tables_get(n);
+    if (t == NULL) {
+        printf("  N=%-5u not generated                  : [FAIL]\n", n);
+        return 1;
+    }
+
+    /* Twiddles within 1 LSB of 2^31 * cos/sin */
+    double tw_err = 0.0, tw15_err = 0.0;
+    for (int i = 0; i < n / 2; i++) {
+        double x = 2.0 * M_PI * i / n;
+        tw_err = fmax(tw_err, fabs(t->tw_cos[i] - 2147483647.0 * cos(x)));
+        tw_err = fmax(tw_err, fabs(t->tw_sin[i] - 2147483647.0 * sin(x)));
+        /* Packed Q1.15 pair (cos low, sin high), rounded */
+        tw15_err = fmax(tw15_err, fabs((int16_t)(t->tw_q15[i] & 0xFFFF) - 32767.0 * cos(x)));
+        tw15_err = fmax(tw15_err, fabs((int16_t)(t->tw_q15[i] >> 16) - 32767.0 * sin(x)));
+    }
+
+    /* Windows symmetric, Hann zero at both ends and ~1.0 at the centre */
+    int sym = (t->hann[0] == 0) && (t->hann[n - 1] == 0) && (t->hann[n / 2] > 32700);
+    for (int i = 0; i < n / 2; i++) {
+        sym &= t->hann[i] == t->hann[n - 1 - i] && t->hamming[i] == t->hamming[n - 1 - i] &&
+               t->blackman[i] == t->blackman[n - 1 - i] && t->sine[i] == t->sine[n - 1 - i];
+    }
+
+    /* Bit reversal is an involution */
+    int rev = 1;
+    for (int i = 0; i < n; i++) rev &= t->bitrev[t->bitrev[i]] == i && t->bitrev[i] < n;
+    rev &= t->bitrev[1] == n / 2;
+
+    /* Mel bands stay inside the spectrum, peak near unity, advance monotonically */
+    int mel = 1;
+    uint16_t prev_start = 0;
+    for (int m = 0; m < FE_TABLE_MEL_BANDS; m++) {
+        int peak = 0;
+        for (int j = 0; j < t->mel_len[m]; j++) {
+            int w = t->mel_weight[t->mel_offset[m] + j];
+            if (w > peak) peak = w;
+            mel &= w > 0;
+        }
+        mel &= t->mel_start[m] + t->mel_len[m] <= n / 2 + 1 && t->mel_start[m] >= prev_start;
+        if (t->mel_len[m] > 2) mel &= peak > 16384;
+        prev_start = t->mel_start[m];
+    }
+
+    int pass = (tw_err <= 1.0) && (tw15_err <= 0.5) && sym && rev && mel;
+    printf("  N=%-5u tw err %.2f/%.2f LSB, win %d, bitrev %d, mel %d : [%s]\n",
+           n, tw_err, tw15_err, sym, rev, mel, pass ? "PASS" : "FAIL");
+    return !pass;
+}
+
+static int check_engine(uint16_t n)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate        = 16000;
+    cfg.frame_len          = n;
+    cfg.hop_len            = n / 2;
+    cfg.num_channels       = 1;
+    cfg.flags              = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg.pre_emphasis_alpha = 0x7AE1;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    void *scratch = malloc(scratch_sz);
+    q15_t *in = (q15_t *)malloc(n * sizeof(q15_t));
+    q15_t *out = (q15_t *)malloc(n * sizeof(q15_t));
+
+    int pass = fe_init(&cfg, state, scratch, scratch_sz) == FE_OK;
+    uint32_t lcg = 5;
+    for (int hop = 0; pass && hop < 8; hop++) {
+        for (int i = 0; i < n; i++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            in[i] = (q15_t)(((int32_t)(lcg >> 16) - 32768) / 8);
+        }
+        pass &= fe_process_hop(state, in, out, NULL, 0) == FE_OK;
+    }
+
+    printf("  Engine hop at N=%-5u                     : [%s]\n", n, pass ? "PASS" : "FAIL");
+    free(state); free(scratch); free(in); free(out);
+    return !pass;
+}
+
+int main(void)
+{
+    static const uint16_t sizes[] = {128, 256, 512, 1024};
+    int failures = 0;
+
+    /* N = 256 is always generated; the others only if listed in TABLE_SIZES */
+    printf("\n--- Generated ROM tables ---\n");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] == 256 || fe_tables_get(sizes[i]) != NULL) failures += check_size(sizes[i]);
+    }
+
+    /* log2(1 + x) mantissa table: ends at 0 and saturated 1.0 */
+    double lg_err = 0.0;
+    for (int i = 0; i < (1 << FE_TABLE_LOG2_BITS); i++) {
+        double ref = 32767.0 * log2(1.0 + (double)i / (1 << FE_TABLE_LOG2_BITS));
+        lg_err = fmax(lg_err, fabs(log2_frac_q15[i] - ref));
+    }
+    int pass = (lg_err <= 0.5) && log2_frac_q15[0] == 0 &&
+               log2_frac_q15[1 << FE_TABLE_LOG2_BITS] == 32767;
+    failures += !pass;
+    printf("  log2 table max err %.2f LSB               : [%s]\n", lg_err, pass ? "PASS" : "FAIL");
+
+    /* Sizes that were not generated are rejected, not silently mis-indexed */
+    fe_config_t bad;
+    memset(&bad, 0, sizeof(bad));
+    bad.sample_rate = 16000;
+    bad.frame_len = 384;
+    bad.hop_len = 384;
+    bad.num_channels = 1;
+    pass = fe_tables_get(384) == NULL && fe_tables_get(64) == NULL &&
+           fe_state_bytes(&bad) == 0;
+    failures += !pass;
+    printf("  Unknown sizes rejected                    : [%s]\n", pass ? "PASS" : "FAIL");
+
+    failures += check_engine(128);
+    failures += check_engine(512);
+    failures += check_engine(1024);
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_vad.c
+ * @brief Engine-level VAD test: noise → tone burst → noise, checks decision and hangover.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rtafe/fe_api.h"
+
+#define FRAME_LEN   256
+#define HOP_LEN     (FRAME_LEN / 2)
+#define NOISE_HOPS  40
+#define SPEECH_HOPS 16
+
+static uint32_t lcg = 12345;
+
+static q15_t noise_sample(int amp)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return (q15_t)(((int32_t)(lcg >> 16) - 32768) * amp / 32768);
+}
+
+static void fill_hop(q15_t *pcm, int hop, int speech)
+{
+    for (int n = 0; n < HOP_LEN; n++) {
+        float t = (float)(hop * HOP_LEN + n) / 16000.0f;
+        int32_t s = noise_sample(300);
+        if (speech) {
+            /* Voiced-like burst: two harmonics under a 4 Hz syllable envelope */
+            float env = 0.6f + 0.4f * sinf(2.0f * M_PI * 4.0f * t);
+            s += (int32_t)(env * (6000.0f * sinf(2.0f * M_PI * 500.0f * t)
+                                + 3000.0f * sinf(2.0f * M_PI * 1500.0f * t)));
+        }
+        pcm[n] = (q15_t)s;
+    }
+}
+
+int main(void)
+{
+    fe_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.sample_rate        = 16000;
+    cfg.frame_len          = FRAME_LEN;
+    cfg.hop_len            = HOP_LEN;
+    cfg.num_channels       = 1;
+    cfg.flags              = FE_FLAG_NOISE_SUPPRESS | FE_FLAG_VAD;
+    cfg.dc_rm_alpha        = 0x7FD00000;
+    cfg.pre_emphasis_alpha = 0x5000;
+
+    size_t scratch_sz = fe_scratch_bytes(&cfg);
+    fe_state_t *state = (fe_state_t *)malloc(fe_state_bytes(&cfg));
+    void *scratch = malloc(scratch_sz);
+    if (fe_init(&cfg, state, scratch, scratch_sz) != FE_OK) {
+        printf("fe_init failed [FAIL]\n");
+        return 1;
+    }
+
+    q15_t in[HOP_LEN], out[HOP_LEN];
+    int hop = 0, failures = 0;
+    int speech_hits = 0, noise_false = 0, hangover_hops = 0;
+
+    printf("\n--- VAD: %d noise / %d speech / %d noise hops ---\n",
+           NOISE_HOPS, SPEECH_HOPS, NOISE_HOPS);
+
+    for (int i = 0; i < NOISE_HOPS; i++, hop++) {
+        fill_hop(in, hop, 0);
+        fe_process_hop(state, in, out, NULL, 0);
+        if (i >= NOISE_HOPS / 2) noise_false += fe_vad_status(state, 0, NULL);
+    }
+    for (int i = 0; i < SPEECH_HOPS; i++, hop++) {
+        fill_hop(in, hop, 1);
+        fe_process_hop(state, in, out, NULL, 0);
+        speech_hits += fe_vad_status(state, FE_VAD_ANY_CHANNEL, NULL);
+    }
+    q15_t prob = 0;
+    fe_vad_status(state, 0, &prob);
+    for (int i = 0; i < NOISE_HOPS; i++, hop++) {
+        fill_hop(in, hop, 0);
+        fe_process_hop(state, in, out, NULL, 0);
+        if (fe_vad_status(state, 0, NULL)) hangover_hops = i + 1;
+    }
+
+    int pass;
+    pass = (noise_false == 0);
+    failures += !pass;
+    printf("  Noise hops flagged as speech : %d [%s]\n", noise_false, pass ? "PASS" : "FAIL");
+
+    pass = (speech_hits >= SPEECH_HOPS - 2);
+    failures += !pass;
+    printf("  Speech hops detected         : %d/%d (prob=%.2f) [%s]\n",
+           speech_hits, SPEECH_HOPS, prob / 32768.0f, pass ? "PASS" : "FAIL");
+
+    pass = (hangover_hops >= VAD_DEFAULT_HANGOVER) && (hangover_hops <= VAD_DEFAULT_HANGOVER + 2);
+    failures += !pass;
+    printf("  Hangover hops after speech   : %d [%s]\n", hangover_hops, pass ? "PASS" : "FAIL");
+
+    free(state);
+    free(scratch);
+
+    printf("\n  Result: %s\n\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file gen_tables.c
+ * @brief Host-side ROM table generator, run from the Makefile.
+ *
+ * Emits tables.h / tables.c for every frame size given on the command line:
+ *   - Windows (Q1.15): Hann, Hamming, Blackman, sine — symmetric, N points
+ *   - FFT twiddles (Q1.31): cos/sin(2πk/N), N/2 entries
+ *   - Bit-reversal permutation (uint16), N entries
+ *   - Mel filterbank (Q1.15): FE_TABLE_MEL_BANDS HTK triangles over
+ *     0..FE_TABLE_MEL_FS/2, stored sparse as start/len/offset + weights
+ * plus the size-independent fast-math tables used by utils/fixedpoint.h:
+ *   - log2(1 + x) and 2^x - 1 mantissas (Q1.15, 2^LOG2_BITS + 1)
+ *   - atan(x) / π on [0, 1] (Q1.15, 2^ATAN_BITS + 1)
+ *   - Reciprocal and reciprocal square root Newton seeds (U1.15)
+ *
+ * Only the listed sizes are emitted, so a target links exactly the tables
+ * it selected (TABLE_SIZES in the Makefile).
+ *
+ *   gen_tables <out_dir> <N> [<N> ...]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define MEL_BANDS  40
+#define MEL_FS     16000
+#define LOG2_BITS  8
+#define ATAN_BITS  6
+#define SEED_BITS  5
+#define MAX_SIZES  16
+#define MAX_N      4096
+
+static int16_t q15(double x)
+{
+    double v = floor(x * 32767.0 + 0.5);
+    if (v > 32767.0) v = 32767.0;
+    if (v < -32768.0) v = -32768.0;
+    return (int16_t)v;
+}
+
+static int32_t q31(double x)
+{
+    double v = floor(x * 2147483647.0 + 0.5);
+    if (v > 2147483647.0) v = 2147483647.0;
+    if (v < -2147483648.0) v = -2147483648.0;
+    return (int32_t)v;
+}
+
+static double hz_to_mel(double f) { return 2595.0 * log10(1.0 + f / 700.0); }
+static double mel_to_hz(double m) { return 700.0 * (pow(10.0, m / 2595.0) - 1.0); }
+
+/* Tables read on every hop are tagged for RAM/DTCM placement (fe_types.h) */
+static const char *fast_attr(int hot)
+{
+    return hot ? "RTAFE_FAST_DATA " : "";
+}
+
+static void emit_q15(FILE *f, const char *name, int hot, int n, const int16_t *v)
+{
+    fprintf(f, "%sconst q15_t %s[%d] = {", fast_attr(hot), name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s%7d,", (i % 8) ? " " : "\n    ", v[i]);
+    }
+    fprintf(f, "\n};\n\n");
+}
+
+static void emit_q31(FILE *f, const char *name, int hot, int n, const int32_t *v)
+{
+    fprintf(f, "%sconst q31_t %s[%d] = {", fast_attr(hot), name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s%11d,", (i % 6) ? " " : "\n    ", v[i]);
+    }
+    fprintf(f, "\n};\n\n");
+}
+
+static void emit_u16(FILE *f, const char *name, int hot, int n, const uint16_t *v)
+{
+    fprintf(f, "%sconst uint16_t %s[%d] = {", fast_attr(hot), name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s%5u,", (i % 12) ? " " : "\n    ", v[i]);
+    }
+    fprintf(f, "\n};\n\n");
+}
+
+static void emit_u32(FILE *f, const char *name, int hot, int n, const uint32_t *v)
+{
+    fprintf(f, "%sconst uint32_t %s[%d] = {", fast_attr(hot), name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s0x%08X,", (i % 6) ? " " : "\n    ", v[i]);
+    }
+    fprintf(f, "\n};\n\n");
+}
+
+static int emit_size(FILE *h, FILE *c, int n)
+{
+    static int16_t w[MAX_N];
+    static int32_t tw[MAX_N / 2];
+    static uint32_t tw_packed[MAX_N / 2];
+    static uint16_t u[MAX_N];
+    static uint16_t mel_start[MEL_BANDS], mel_len[MEL_BANDS], mel_off[MEL_BANDS];
+    static int16_t mel_w[MEL_BANDS * (MAX_N / 2 + 1)];
+    char name[64];
+
+    fprintf(h, "/* ── N = %d ─────────────────────────────────────────────────────────── */\n", n);
+    fprintf(h, "#define FE_TABLES_HAVE_%d 1\n", n);
+    fprintf(c, "/* ── N = %d ─────────────────────────────────────────────────────────── */\n\n", n);
+
+    /* Windows: symmetric, denominator N - 1 */
+    static const char *wnames[] = {"hann", "hamming", "blackman", "sine"};
+    for (int k = 0; k < 4; k++) {
+        for (int i = 0; i < n; i++) {
+            double x = 2.0 * M_PI * i / (n - 1);
+            double v = (k == 0) ? 0.5 * (1.0 - cos(x))
+                     : (k == 1) ? 0.54 - 0.46 * cos(x)
+                     : (k == 2) ? 0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x)
+                     :            sin(M_PI * i / (n - 1));
+            w[i] = q15(v);
+        }
+        snprintf(name, sizeof(name), "window_%s_%d", wnames[k], n);
+        fprintf(h, "extern const q15_t %s[%d];\n", name, n);
+        emit_q15(c, name, 0, n, w);
+    }
+
+    /* Twiddles */
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < n / 2; i++) {
+            double x = 2.0 * M_PI * i / n;
+            tw[i] = q31(k == 0 ? cos(x) : sin(x));
+        }
+        snprintf(name, sizeof(name), "twiddle_%s_%d", k == 0 ? "cos" : "sin", n);
+        fprintf(h, "extern const q31_t %s[%d];\n", name, n / 2);
+        emit_q31(c, name, 1, n / 2, tw);
+    }
+
+    /* Packed Q1.15 twiddles for fft_radix2_q15: cos in the low half, sin
+       in the high half, so one word feeds SMUAD/SMUSDX */
+    for (int i = 0; i < n / 2; i++) {
+        double x = 2.0 * M_PI * i / n;
+        tw_packed[i] = (uint32_t)(uint16_t)q15(cos(x)) | ((uint32_t)(uint16_t)q15(sin(x)) << 16);
+    }
+    snprintf(name, sizeof(name), "twiddle_q15_%d", n);
+    fprintf(h, "extern const uint32_t %s[%d];\n", name, n / 2);
+    emit_u32(c, name, 1, n / 2, tw_packed);
+
+    /* Bit reversal */
+    int bits = 0;
+    while ((1 << bits) < n) bits++;
+    for (int i = 0; i < n; i++) {
+        uint16_t r = 0;
+        for (int b = 0; b < bits; b++) r |= (uint16_t)(((i >> b) & 1) << (bits - 1 - b));
+        u[i] = r;
+    }
+    snprintf(name, sizeof(name), "bitrev_%d", n);
+    fprintf(h, "extern const uint16_t %s[%d];\n", name, n);
+    emit_u16(c, name, 0, n, u);
+
+    /* Mel filterbank over bins 0..N/2 */
+    int n_bins = n / 2 + 1;
+    double mel_hi = hz_to_mel(MEL_FS / 2.0);
+    double edge[MEL_BANDS + 2];
+    for (int m = 0; m < MEL_BANDS + 2; m++) {
+        edge[m] = mel_to_hz(mel_hi * m / (MEL_BANDS + 1)) * n / MEL_FS;   /* in bins */
+    }
+    int total = 0;
+    for (int m = 0; m < MEL_BANDS; m++) {
+        int start = -1, len = 0;
+        for (int k = 0; k < n_bins; k++) {
+            double v = 0.0;
+            if (k > edge[m] && k < edge[m + 1]) v = (k - edge[m]) / (edge[m + 1] - edge[m]);
+            else if (k >= edge[m + 1] && k < edge[m + 2]) v = (edge[m + 2] - k) / (edge[m + 2] - edge[m + 1]);
+            int16_t q = q15(v);
+            if (q > 0) {
+                if (start < 0) start = k;
+                len = k - start + 1;
+            }
+        }
+        mel_start[m] = (uint16_t)(start < 0 ? 0 : start);
+        mel_len[m] = (uint16_t)len;
+        mel_off[m] = (uint16_t)total;
+        for (int j = 0; j < len; j++) {
+            int k = start + j;
+            double v = (k < edge[m + 1]) ? (k - edge[m]) / (edge[m + 1] - edge[m])
+                                         : (edge[m + 2] - k) / (edge[m + 2] - edge[m + 1]);
+            mel_w[total++] = q15(v > 0.0 ? v : 0.0);
+        }
+    }
+    snprintf(name, sizeof(name), "mel_start_%d", n);
+    fprintf(h, "extern const uint16_t %s[FE_TABLE_MEL_BANDS];\n", name);
+    emit_u16(c, name, 0, MEL_BANDS, mel_start);
+    snprintf(name, sizeof(name), "mel_len_%d", n);
+    fprintf(h, "extern const uint16_t %s[FE_TABLE_MEL_BANDS];\n", name);
+    emit_u16(c, name, 0, MEL_BANDS, mel_len);
+    snprintf(name, sizeof(name), "mel_offset_%d", n);
+    fprintf(h, "extern const uint16_t %s[FE_TABLE_MEL_BANDS];\n", name);
+    emit_u16(c, name, 0, MEL_BANDS, mel_off);
+    snprintf(name, sizeof(name), "mel_weight_%d", n);
+    fprintf(h, "extern const q15_t %s[%d];\n\n", name, total > 0 ? total : 1);
+    if (total == 0) mel_w[total++] = 0;
+    emit_q15(c, name, 0, total, mel_w);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <out_dir> <N> [<N> ...]\n", argv[0]);
+        return 1;
+    }
+
+    int sizes[MAX_SIZES], n_sizes = 0;
+    for (int i = 2; i < argc && n_sizes < MAX_SIZES; i++) {
+        int n = atoi(argv[i]);
+        if (n < 8 || n > MAX_N || (n & (n - 1)) != 0) {
+            fprintf(stderr, "gen_tables: N=%s is not a power of 2 in [8, %d]\n", argv[i], MAX_N);
+            return 1;
+        }
+        sizes[n_sizes++] = n;
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/tables.h", argv[1]);
+    FILE *h = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/tables.c", argv[1]);
+    FILE *c = fopen(path, "w");
+    if (h == NULL || c == NULL) {
+        fprintf(stderr, "gen_tables: cannot write to %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(h, "/**\n * @file tables.h\n * @brief Extern declarations for generated ROM tables.\n *\n"
+               " * Auto-generated by tools/gen_tables.c — DO NOT EDIT BY HAND.\n * Frame lengths:");
+    for (int i = 0; i < n_sizes; i++) fprintf(h, " %d", sizes[i]);
+    fprintf(h, "\n */\n#pragma once\n\n#include \"rtafe/fe_types.h\"\n\n");
+    fprintf(h, "#define FE_TABLE_MEL_BANDS %d\n#define FE_TABLE_MEL_FS    %d\n"
+               "#define FE_TABLE_LOG2_BITS %d\n#define FE_TABLE_ATAN_BITS %d\n"
+               "#define FE_TABLE_SEED_BITS %d\n\n", MEL_BANDS, MEL_FS, LOG2_BITS, ATAN_BITS, SEED_BITS);
+
+    fprintf(c, "/**\n * @file tables.c\n * @brief Auto-generated ROM tables — DO NOT EDIT BY HAND.\n *\n"
+               " * Generated by tools/gen_tables.c\n */\n\n#include \"tables.h\"\n\n");
+
+    for (int i = 0; i < n_sizes; i++) emit_size(h, c, sizes[i]);
+
+    /* log2(1 + i / 2^LOG2_BITS), Q1.15, size independent */
+    static int16_t lg[(1 << LOG2_BITS) + 1];
+    for (int i = 0; i <= (1 << LOG2_BITS); i++) {
+        lg[i] = q15(log2(1.0 + (double)i / (1 << LOG2_BITS)));
+    }
+    fprintf(h, "/* ── Size-independent ──────────────────────────────────────────────── */\n");
+    fprintf(h, "/** log2(1 + i / 2^FE_TABLE_LOG2_BITS), Q1.15 (last entry saturates at 1.0) */\n");
+    fprintf(h, "extern const q15_t log2_frac_q15[(1 << FE_TABLE_LOG2_BITS) + 1];\n\n");
+    fprintf(c, "/* ── Size-independent ──────────────────────────────────────────────── */\n\n");
+    emit_q15(c, "log2_frac_q15", 1, (1 << LOG2_BITS) + 1, lg);
+
+    /* 2^(i / 2^LOG2_BITS) - 1, scaled by 2^15 (last entry is exactly 32768) */
+    static uint16_t ex[(1 << LOG2_BITS) + 1];
+    for (int i = 0; i <= (1 << LOG2_BITS); i++) {
+        ex[i] = (uint16_t)floor((pow(2.0, (double)i / (1 << LOG2_BITS)) - 1.0) * 32768.0 + 0.5);
+    }
+    fprintf(h, "/** 2^(i / 2^FE_TABLE_LOG2_BITS) - 1, scaled by 2^15 */\n");
+    fprintf(h, "extern const uint16_t exp2_frac_u16[(1 << FE_TABLE_LOG2_BITS) + 1];\n\n");
+    emit_u16(c, "exp2_frac_u16", 1, (1 << LOG2_BITS) + 1, ex);
+
+    /* atan(i / 2^ATAN_BITS) / π, scaled by 2^15 (atan(1) = 8192) */
+    static int16_t at[(1 << ATAN_BITS) + 1];
+    for (int i = 0; i <= (1 << ATAN_BITS); i++) {
+        at[i] = (int16_t)floor(atan((double)i / (1 << ATAN_BITS)) / M_PI * 32768.0 + 0.5);
+    }
+    fprintf(h, "/** atan(i / 2^FE_TABLE_ATAN_BITS) / pi, scaled by 2^15 */\n");
+    fprintf(h, "extern const q15_t atan_frac_q15[(1 << FE_TABLE_ATAN_BITS) + 1];\n\n");
+    emit_q15(c, "atan_frac_q15", 1, (1 << ATAN_BITS) + 1, at);
+
+    /* Newton seeds at interval midpoints, scaled by 2^15:
+       1/m for m in [0.5, 1), 1/sqrt(m) for m in [0.25, 1) */
+    static uint16_t rs[3 << (SEED_BITS - 1)];
+    for (int i = 0; i < (1 << SEED_BITS); i++) {
+        rs[i] = (uint16_t)floor(32768.0 / (0.5 + (i + 0.5) / (2 << SEED_BITS)) + 0.5);
+    }
+    fprintf(h, "/** 2^15 / m at the midpoint of [0.5 + i / 2^(SEED_BITS + 1), ...) */\n");
+    fprintf(h, "extern const uint16_t recip_seed_u16[1 << FE_TABLE_SEED_BITS];\n\n");
+    emit_u16(c, "recip_seed_u16", 1, 1 << SEED_BITS, rs);
+    for (int i = 0; i < (3 << (SEED_BITS - 1)); i++) {
+        rs[i] = (uint16_t)floor(32768.0 / sqrt(0.25 + (i + 0.5) / (2 << SEED_BITS)) + 0.5);
+    }
+    fprintf(h, "/** 2^15 / sqrt(m) at the midpoint of [0.25 + i / 2^(SEED_BITS + 1), ...) */\n");
+    fprintf(h, "extern const uint16_t rsqrt_seed_u16[3 << (FE_TABLE_SEED_BITS - 1)];\n\n");
+    emit_u16(c, "rsqrt_seed_u16", 1, 3 << (SEED_BITS - 1), rs);
+
+    /* Size lookup */
+    fprintf(h, "/** All tables for one frame length. */\n"
+               "typedef struct fe_tables {\n"
+               "    uint16_t        n;\n"
+               "    const q15_t    *hann;\n"
+               "    const q15_t    *hamming;\n"
+               "    const q15_t    *blackman;\n"
+               "    const q15_t    *sine;\n"
+               "    const q31_t    *tw_cos;          /**< [n / 2] */\n"
+               "    const q31_t    *tw_sin;          /**< [n / 2] */\n"
+               "    const uint32_t *tw_q15;          /**< [n / 2] Q1.15 cos | sin << 16 */\n"
+               "    const uint16_t *bitrev;\n"
+               "    const uint16_t *mel_start;       /**< [FE_TABLE_MEL_BANDS] first bin */\n"
+               "    const uint16_t *mel_len;         /**< [FE_TABLE_MEL_BANDS] bins in band */\n"
+               "    const uint16_t *mel_offset;      /**< [FE_TABLE_MEL_BANDS] into mel_weight */\n"
+               "    const q15_t    *mel_weight;\n"
+               "} fe_tables_t;\n\n"
+               "/** Tables for frame length @p n, or NULL if @p n was not generated. */\n"
+               "const fe_tables_t *fe_tables_get(uint16_t n);\n");
+
+    fprintf(c, "static const fe_tables_t fe_tables[] = {\n");
+    for (int i = 0; i < n_sizes; i++) {
+        int n = sizes[i];
+        fprintf(c, "    { %d, window_hann_%d, window_hamming_%d, window_blackman_%d, window_sine_%d,\n"
+                   "      twiddle_cos_%d, twiddle_sin_%d, twiddle_q15_%d, bitrev_%d,\n"
+                   "      mel_start_%d, mel_len_%d, mel_offset_%d, mel_weight_%d },\n",
+                n, n, n, n, n, n, n, n, n, n, n, n, n);
+    }
+    fprintf(c, "};\n\n"
+               "const fe_tables_t *fe_tables_get(uint16_t n)\n{\n"
+               "    for (size_t i = 0; i < sizeof(fe_tables) / sizeof(fe_tables[0]); i++) {\n"
+               "        if (fe_tables[i].n == n) return &fe_tables[i];\n"
+               "    }\n"
+               "    return NULL;\n}\n");
+
+    fclose(h);
+    fclose(c);
+    return 0;
+}
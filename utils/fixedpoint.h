@@ -0,0 +1,334 @@
+/**
+ * @file fixedpoint.h
+ * @brief Fixed-point fast math: saturating ops, reciprocal, rsqrt, log2, exp2, atan2.
+ *
+ * Header-only; the lookup tables are generated with the ROM tables
+ * (tools/gen_tables.c, tables.h), so every table is a few hundred bytes of
+ * flash shared by all callers.
+ *
+ * CONVENTIONS:
+ * - Scalar kernels are static inline; *_block() variants run the same
+ *   kernel over arrays and are written branch-light so the compiler can
+ *   vectorize them (SSE/AVX gathers, NEON), or map to the ARM DSP
+ *   extension's dual 16-bit saturating ops (QADD16) where one exists
+ * - Saturation maps to __builtin_*_overflow on hosts and QADD/QSUB/SSAT
+ *   on cores with __ARM_FEATURE_DSP (Cortex-M4/M7)
+ * - Reciprocal and rsqrt return a normalized mantissa and a shift so one
+ *   kernel covers the full uint32_t input range without overflow
+ *
+ * ERROR BOUNDS (measured exhaustively/densely in tests/test_fixedpoint.c):
+ * | Kernel          | Output            | Max error                     |
+ * |-----------------|-------------------|-------------------------------|
+ * | fx_recip_u32    | U2.30 mantissa    | 2^-23 relative                |
+ * | fx_div_u32      | (num << f) / den  | 1 LSB + 2^-23 relative        |
+ * | fx_rsqrt_u32    | U2.30 mantissa    | 2^-22 relative                |
+ * | fx_log2_u32     | Q16.16            | 2 LSB (3e-5)                  |
+ * | fx_exp2_q16     | U16.16            | 2^-14 relative (+1 LSB)       |
+ * | fx_atan2_q15    | angle / π, Q1.15  | 2 LSB (1e-4 rad)              |
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "rtafe/fe_types.h"
+#include "tables.h"
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+/* ── Saturation and saturating arithmetic ─────────────────────────────── */
+
+/** Clamp a wide intermediate to Q1.31. */
+static inline q31_t fx_sat_q31(q63_t x)
+{
+    if (x > INT32_MAX) return INT32_MAX;
+    if (x < INT32_MIN) return INT32_MIN;
+    return (q31_t)x;
+}
+
+/** Clamp to Q1.15 (SSAT #16 on DSP cores). */
+static inline q15_t fx_sat_q15(int32_t x)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return (q15_t)__ssat(x, 16);
+#else
+    if (x > INT16_MAX) return INT16_MAX;
+    if (x < INT16_MIN) return INT16_MIN;
+    return (q15_t)x;
+#endif
+}
+
+/** a + b, saturating (QADD). */
+static inline q31_t fx_add_sat_q31(q31_t a, q31_t b)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return __qadd(a, b);
+#else
+    q31_t r;
+    if (__builtin_add_overflow(a, b, &r)) return (a < 0) ? INT32_MIN : INT32_MAX;
+    return r;
+#endif
+}
+
+/** a - b, saturating (QSUB). */
+static inline q31_t fx_sub_sat_q31(q31_t a, q31_t b)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return __qsub(a, b);
+#else
+    q31_t r;
+    if (__builtin_sub_overflow(a, b, &r)) return (a < 0) ? INT32_MIN : INT32_MAX;
+    return r;
+#endif
+}
+
+/** a + b in Q1.15, saturating. */
+static inline q15_t fx_add_sat_q15(q15_t a, q15_t b)
+{
+    return fx_sat_q15((int32_t)a + b);
+}
+
+/** a * b in Q1.31, rounded; -1 * -1 saturates to INT32_MAX. */
+static inline q31_t fx_mul_q31(q31_t a, q31_t b)
+{
+    return fx_sat_q31(((q63_t)a * b + (1LL << 30)) >> 31);
+}
+
+/** a * b in Q1.15, rounded; -1 * -1 saturates to INT16_MAX. */
+static inline q15_t fx_mul_q15(q15_t a, q15_t b)
+{
+    return fx_sat_q15(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+/** Count of leading zeros, defined as 32 for 0. */
+static inline int fx_clz32(uint32_t x)
+{
+    return x ? __builtin_clz(x) : 32;
+}
+
+/* ── Reciprocal / division ────────────────────────────────────────────── */
+
+/**
+ * 1/d for d > 0 as mantissa and shift: 1/d ≈ r * 2^-shift, r in U2.30
+ * (2^30, 2^31]. Seed from recip_seed_u16 (5 bits of the normalized
+ * mantissa, 2^-6 relative), then two Newton steps r = r * (2 - m * r),
+ * each squaring the error (a third step would buy nothing the callers'
+ * Q1.15/Q6.9 outputs can see). d = 0 returns r = 0, shift = 0.
+ */
+static inline uint32_t fx_recip_u32(uint32_t d, int *shift)
+{
+    if (d == 0) {
+        *shift = 0;
+        return 0;
+    }
+    int n = __builtin_clz(d);
+    uint64_t m = (uint64_t)(d << n);                 /* U0.32, [0.5, 1) */
+    uint64_t r = (uint64_t)recip_seed_u16[(m >> (31 - FE_TABLE_SEED_BITS)) &
+                                          ((1u << FE_TABLE_SEED_BITS) - 1)] << 15;
+    for (int it = 0; it < 2; it++) {
+        uint64_t e = (2ULL << 30) - ((m * r) >> 32); /* 2 - m * r, U2.30 */
+        r = (r * e) >> 30;
+    }
+    *shift = 62 - n;
+    return (uint32_t)r;
+}
+
+/**
+ * (num << frac) / den without a divide, saturating at UINT32_MAX.
+ * den = 0 saturates.
+ */
+static inline uint32_t fx_div_u32(uint32_t num, uint32_t den, int frac)
+{
+    int shift;
+    uint32_t r = fx_recip_u32(den, &shift);
+    if (r == 0) return UINT32_MAX;
+    uint64_t p = (uint64_t)num * r;                  /* < 2^63 */
+    int s = shift - frac;
+    if (s <= 0) {
+        return (p == 0) ? 0 : UINT32_MAX;            /* quotient >= 2^32 */
+    }
+    p = (s >= 64) ? 0 : (p + (1ULL << (s - 1))) >> s;
+    return (p > UINT32_MAX) ? UINT32_MAX : (uint32_t)p;
+}
+
+/* ── Reciprocal square root ───────────────────────────────────────────── */
+
+/**
+ * 1/sqrt(x) for x > 0 as mantissa and shift: ≈ r * 2^-shift, r in U2.30
+ * (2^30, 2^31]. x is normalized by an even shift into [0.25, 1), seeded
+ * from rsqrt_seed_u16 and refined by two Newton steps
+ * r = r * (3 - m * r^2) / 2. x = 0 returns r = 0, shift = 0.
+ */
+static inline uint32_t fx_rsqrt_u32(uint32_t x, int *shift)
+{
+    if (x == 0) {
+        *shift = 0;
+        return 0;
+    }
+    int n = __builtin_clz(x) & ~1;
+    uint64_t m = (uint64_t)(x << n);                 /* U0.32, [0.25, 1) */
+    uint64_t r = (uint64_t)rsqrt_seed_u16[(m >> (31 - FE_TABLE_SEED_BITS)) -
+                                          (1u << (FE_TABLE_SEED_BITS - 1))] << 15;
+    for (int it = 0; it < 2; it++) {
+        uint64_t r2 = (r * r) >> 30;                 /* U2.30, <= 4 */
+        uint64_t t = (3ULL << 30) - ((m * r2) >> 32);
+        r = (r * t) >> 31;
+    }
+    *shift = 46 - n / 2;
+    return (uint32_t)r;
+}
+
+/* ── log2 / exp2 ──────────────────────────────────────────────────────── */
+
+/* 2^44 / 32767: log2_frac_q15 is scaled by 32767, results by 2^16 */
+#define FX_LOG2_TAB_SCALE 536887296u
+
+/**
+ * log2(x) in Q16.16 for x >= 1 (INT32_MIN for 0). Integer part from the
+ * leading-one position, fraction from log2_frac_q15 with linear
+ * interpolation on the next 16 mantissa bits, rounded once at the end. For a Q1.31 value v,
+ * log2(v) = fx_log2_u32(v) - (31 << 16).
+ */
+static inline int32_t fx_log2_u32(uint32_t x)
+{
+    if (x == 0) return INT32_MIN;
+    int n = __builtin_clz(x);
+    uint32_t f = (x << n) << 1;                      /* mantissa fraction, U0.32 */
+    uint32_t i = f >> (32 - FE_TABLE_LOG2_BITS);
+    uint32_t t = (f >> (16 - FE_TABLE_LOG2_BITS)) & 0xFFFF;
+    int32_t a = log2_frac_q15[i];
+    uint64_t v = (uint64_t)(((int64_t)a << 16) + (int64_t)(log2_frac_q15[i + 1] - a) * t);
+    return ((31 - n) << 16) + (int32_t)((v * FX_LOG2_TAB_SCALE + (1ULL << 43)) >> 44);
+}
+
+/**
+ * 2^x for x in Q16.16, result in U16.16: exact power of two from the
+ * integer part, mantissa from exp2_frac_u16 with linear interpolation.
+ * Saturates to UINT32_MAX for x >= 16, flushes to 0 below -17.
+ */
+static inline uint32_t fx_exp2_q16(int32_t x)
+{
+    if (x >= (16 << 16)) return UINT32_MAX;
+    if (x < -(17 << 16)) return 0;
+    int32_t ip = x >> 16;                            /* floor */
+    uint32_t f = (uint32_t)x & 0xFFFF;
+    uint32_t i = f >> (16 - FE_TABLE_LOG2_BITS);
+    uint32_t t = f & ((1u << (16 - FE_TABLE_LOG2_BITS)) - 1);
+    uint32_t a = exp2_frac_u16[i];
+    uint32_t mant = 32768u + a +
+                    (((exp2_frac_u16[i + 1] - a) * t) >> (16 - FE_TABLE_LOG2_BITS));  /* U1.15 */
+    int s = ip + 1;                                  /* U1.15 → U16.16 */
+    if (s >= 0) return mant << s;
+    return (mant + (1u << (-s - 1))) >> -s;
+}
+
+/* ── atan2 ────────────────────────────────────────────────────────────── */
+
+/**
+ * atan2(y, x) as angle / π in Q1.15 (-32768 = -π; +π wraps to -π).
+ * Octant reduction to a ratio in [0, 1] (fx_div_u32), then atan_frac_q15
+ * with linear interpolation. atan2(0, 0) = 0.
+ */
+static inline q15_t fx_atan2_q15(q31_t y, q31_t x)
+{
+    uint32_t ax = (x < 0) ? 0u - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? 0u - (uint32_t)y : (uint32_t)y;
+    uint32_t hi = ax > ay ? ax : ay;
+    uint32_t lo = ax > ay ? ay : ax;
+    if (hi == 0) return 0;
+
+    /* Ratio in U0.16; hi >= lo, so the result is <= 2^16 */
+    uint32_t r = fx_div_u32(lo, hi, 16);
+    if (r > 65536) r = 65536;
+    uint32_t i = r >> (16 - FE_TABLE_ATAN_BITS);
+    uint32_t t = r & ((1u << (16 - FE_TABLE_ATAN_BITS)) - 1);
+    int32_t a = atan_frac_q15[i];
+    if (i < (1u << FE_TABLE_ATAN_BITS)) {
+        a += ((atan_frac_q15[i + 1] - a) * (int32_t)t) >> (16 - FE_TABLE_ATAN_BITS);
+    }
+
+    if (ay > ax) a = 16384 - a;                      /* π/2 - atan */
+    if (x < 0) a = 32768 - a;                        /* π - angle */
+    if (y < 0) a = -a;
+    return (q15_t)(int16_t)(uint16_t)(a & 0xFFFF);
+}
+
+/* ── Block variants ───────────────────────────────────────────────────── */
+
+/** dst[i] = sat(a[i] + b[i]), Q1.15; QADD16 on two lanes at a time on DSP cores. */
+static inline void fx_add_sat_q15_block(const q15_t *a, const q15_t *b, q15_t *dst, size_t n)
+{
+    size_t i = 0;
+#if defined(__ARM_FEATURE_SIMD32)
+    for (; i + 2 <= n; i += 2) {
+        int16x2_t va, vb, vr;
+        __builtin_memcpy(&va, a + i, 4);
+        __builtin_memcpy(&vb, b + i, 4);
+        vr = __qadd16(va, vb);
+        __builtin_memcpy(dst + i, &vr, 4);
+    }
+#endif
+    for (; i < n; i++) dst[i] = fx_sat_q15((int32_t)a[i] + b[i]);
+}
+
+/** dst[i] = sat(a[i] + b[i]), Q1.31. */
+static inline void fx_add_sat_q31_block(const q31_t *a, const q31_t *b, q31_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_sat_q31((q63_t)a[i] + b[i]);
+}
+
+/** dst[i] = sat(a[i] - b[i]), Q1.31. */
+static inline void fx_sub_sat_q31_block(const q31_t *a, const q31_t *b, q31_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_sat_q31((q63_t)a[i] - b[i]);
+}
+
+/** dst[i] = a[i] * b[i], Q1.15 rounded and saturated. */
+static inline void fx_mul_q15_block(const q15_t *a, const q15_t *b, q15_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_sat_q15(((int32_t)a[i] * b[i] + (1 << 14)) >> 15);
+}
+
+/** dst[i] = a[i] * b[i], Q1.31 rounded and saturated. */
+static inline void fx_mul_q31_block(const q31_t *a, const q31_t *b, q31_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_sat_q31(((q63_t)a[i] * b[i] + (1LL << 30)) >> 31);
+}
+
+/** dst[i] = (num[i] << frac) / den[i] via fx_div_u32(). */
+static inline void fx_div_u32_block(const uint32_t *num, const uint32_t *den, uint32_t *dst,
+                                    size_t n, int frac)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_div_u32(num[i], den[i], frac);
+}
+
+/** dst[i] = 1/d[i] as mantissa and shift[i] via fx_recip_u32(). */
+static inline void fx_recip_block(const uint32_t *d, uint32_t *dst, int *shift, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_recip_u32(d[i], &shift[i]);
+}
+
+/** dst[i] = 1/sqrt(x[i]) as mantissa and shift[i] via fx_rsqrt_u32(). */
+static inline void fx_rsqrt_block(const uint32_t *x, uint32_t *dst, int *shift, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_rsqrt_u32(x[i], &shift[i]);
+}
+
+/** dst[i] = log2(x[i]) in Q16.16 via fx_log2_u32(). */
+static inline void fx_log2_block(const uint32_t *x, int32_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_log2_u32(x[i]);
+}
+
+/** dst[i] = 2^x[i] in U16.16 via fx_exp2_q16(). */
+static inline void fx_exp2_block(const int32_t *x, uint32_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_exp2_q16(x[i]);
+}
+
+/** dst[i] = atan2(y[i], x[i]) / π in Q1.15 via fx_atan2_q15(). */
+static inline void fx_atan2_block(const q31_t *y, const q31_t *x, q15_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = fx_atan2_q15(y[i], x[i]);
+}
@@ -1,193 +0,0 @@
-/**
- * @file tables.c
- * @brief Auto-generated ROM tables — DO NOT EDIT BY HAND.
- *
- * Generated by ref/generate_tables.py on 2026-02-13 23:08
- * Frame length N = 256
- */
-
-#include "tables.h"
-
-
-/* ── Window function tables (Q1.15) ──────────────────── */
-
-const q15_t window_hann_256[256] = {
-          0,       5,      20,      45,      80,     124,     179,     243,
-        317,     401,     495,     598,     711,     833,     965,    1106,
-       1257,    1416,    1585,    1763,    1949,    2145,    2349,    2561,
-       2782,    3011,    3249,    3494,    3747,    4008,    4276,    4552,
-       4834,    5124,    5421,    5724,    6034,    6350,    6672,    7000,
-       7334,    7673,    8018,    8367,    8722,    9081,    9444,    9812,
-      10184,   10559,   10938,   11321,   11706,   12094,   12485,   12879,
-      13274,   13671,   14070,   14470,   14872,   15274,   15677,   16081,
-      16484,   16888,   17291,   17694,   18096,   18497,   18897,   19295,
-      19691,   20085,   20477,   20867,   21254,   21638,   22019,   22396,
-      22770,   23139,   23505,   23866,   24223,   24575,   24922,   25264,
-      25601,   25932,   26257,   26576,   26889,   27195,   27495,   27789,
-      28075,   28354,   28626,   28891,   29148,   29397,   29638,   29871,
-      30096,   30313,   30521,   30721,   30912,   31094,   31267,   31432,
-      31587,   31732,   31869,   31996,   32114,   32222,   32320,   32409,
-      32488,   32557,   32617,   32666,   32706,   32736,   32756,   32766,
-      32766,   32756,   32736,   32706,   32666,   32617,   32557,   32488,
-      32409,   32320,   32222,   32114,   31996,   31869,   31732,   31587,
-      31432,   31267,   31094,   30912,   30721,   30521,   30313,   30096,
-      29871,   29638,   29397,   29148,   28891,   28626,   28354,   28075,
-      27789,   27495,   27195,   26889,   26576,   26257,   25932,   25601,
-      25264,   24922,   24575,   24223,   23866,   23505,   23139,   22770,
-      22396,   22019,   21638,   21254,   20867,   20477,   20085,   19691,
-      19295,   18897,   18497,   18096,   17694,   17291,   16888,   16484,
-      16081,   15677,   15274,   14872,   14470,   14070,   13671,   13274,
-      12879,   12485,   12094,   11706,   11321,   10938,   10559,   10184,
-       9812,    9444,    9081,    8722,    8367,    8018,    7673,    7334,
-       7000,    6672,    6350,    6034,    5724,    5421,    5124,    4834,
-       4552,    4276,    4008,    3747,    3494,    3249,    3011,    2782,
-       2561,    2349,    2145,    1949,    1763,    1585,    1416,    1257,
-       1106,     965,     833,     711,     598,     495,     401,     317,
-        243,     179,     124,      80,      45,      20,       5,       0
-};
-
-const q15_t window_hamming_256[256] = {
-       2621,    2626,    2640,    2663,    2695,    2736,    2786,    2845,
-       2913,    2990,    3077,    3172,    3275,    3388,    3509,    3639,
-       3778,    3924,    4080,    4243,    4415,    4595,    4782,    4978,
-       5181,    5392,    5610,    5836,    6069,    6308,    6555,    6809,
-       7069,    7336,    7608,    7888,    8173,    8463,    8760,    9061,
-       9368,    9681,    9998,   10319,   10645,   10976,   11310,   11648,
-      11990,   12336,   12685,   13036,   13391,   13748,   14108,   14470,
-      14833,   15199,   15566,   15934,   16303,   16674,   17044,   17416,
-      17787,   18158,   18529,   18900,   19270,   19639,   20006,   20372,
-      20737,   21100,   21461,   21819,   22175,   22528,   22878,   23226,
-      23569,   23910,   24246,   24578,   24907,   25231,   25550,   25864,
-      26174,   26478,   26778,   27071,   27359,   27641,   27917,   28187,
-      28450,   28707,   28957,   29201,   29437,   29666,   29888,   30103,
-      30310,   30509,   30701,   30885,   31060,   31228,   31387,   31538,
-      31681,   31815,   31941,   32058,   32166,   32265,   32356,   32438,
-      32510,   32574,   32629,   32674,   32711,   32738,   32757,   32766,
-      32766,   32757,   32738,   32711,   32674,   32629,   32574,   32510,
-      32438,   32356,   32265,   32166,   32058,   31941,   31815,   31681,
-      31538,   31387,   31228,   31060,   30885,   30701,   30509,   30310,
-      30103,   29888,   29666,   29437,   29201,   28957,   28707,   28450,
-      28187,   27917,   27641,   27359,   27071,   26778,   26478,   26174,
-      25864,   25550,   25231,   24907,   24578,   24246,   23910,   23569,
-      23226,   22878,   22528,   22175,   21819,   21461,   21100,   20737,
-      20372,   20006,   19639,   19270,   18900,   18529,   18158,   17787,
-      17416,   17044,   16674,   16303,   15934,   15566,   15199,   14833,
-      14470,   14108,   13748,   13391,   13036,   12685,   12336,   11990,
-      11648,   11310,   10976,   10645,   10319,    9998,    9681,    9368,
-       9061,    8760,    8463,    8173,    7888,    7608,    7336,    7069,
-       6809,    6555,    6308,    6069,    5836,    5610,    5392,    5181,
-       4978,    4782,    4595,    4415,    4243,    4080,    3924,    3778,
-       3639,    3509,    3388,    3275,    3172,    3077,    2990,    2913,
-       2845,    2786,    2736,    2695,    2663,    2640,    2626,    2621
-};
-
-const q15_t window_blackman_256[256] = {
-          0,       2,       7,      16,      29,      45,      65,      89,
-        116,     148,     183,     222,     266,     314,     366,     422,
-        483,     549,     620,     695,     776,     862,     953,    1050,
-       1153,    1261,    1376,    1496,    1623,    1756,    1896,    2043,
-       2197,    2358,    2525,    2701,    2883,    3074,    3271,    3477,
-       3691,    3912,    4142,    4380,    4626,    4880,    5142,    5413,
-       5692,    5979,    6275,    6579,    6891,    7211,    7539,    7876,
-       8220,    8572,    8932,    9299,    9674,   10056,   10444,   10840,
-      11242,   11650,   12065,   12485,   12911,   13341,   13777,   14218,
-      14662,   15110,   15562,   16017,   16475,   16934,   17396,   17859,
-      18323,   18788,   19253,   19717,   20181,   20643,   21104,   21562,
-      22017,   22470,   22918,   23362,   23802,   24236,   24664,   25087,
-      25502,   25910,   26311,   26703,   27087,   27462,   27827,   28182,
-      28526,   28860,   29183,   29493,   29792,   30078,   30351,   30612,
-      30858,   31091,   31310,   31514,   31704,   31879,   32038,   32182,
-      32311,   32424,   32521,   32602,   32667,   32716,   32749,   32765,
-      32765,   32749,   32716,   32667,   32602,   32521,   32424,   32311,
-      32182,   32038,   31879,   31704,   31514,   31310,   31091,   30858,
-      30612,   30351,   30078,   29792,   29493,   29183,   28860,   28526,
-      28182,   27827,   27462,   27087,   26703,   26311,   25910,   25502,
-      25087,   24664,   24236,   23802,   23362,   22918,   22470,   22017,
-      21562,   21104,   20643,   20181,   19717,   19253,   18788,   18323,
-      17859,   17396,   16934,   16475,   16017,   15562,   15110,   14662,
-      14218,   13777,   13341,   12911,   12485,   12065,   11650,   11242,
-      10840,   10444,   10056,    9674,    9299,    8932,    8572,    8220,
-       7876,    7539,    7211,    6891,    6579,    6275,    5979,    5692,
-       5413,    5142,    4880,    4626,    4380,    4142,    3912,    3691,
-       3477,    3271,    3074,    2883,    2701,    2525,    2358,    2197,
-       2043,    1896,    1756,    1623,    1496,    1376,    1261,    1153,
-       1050,     953,     862,     776,     695,     620,     549,     483,
-        422,     366,     314,     266,     222,     183,     148,     116,
-         89,      65,      45,      29,      16,       7,       2,       0
-};
-
-const q15_t window_sine_256[256] = {
-          0,     404,     807,    1211,    1614,    2017,    2420,    2822,
-       3224,    3626,    4027,    4427,    4827,    5226,    5624,    6021,
-       6417,    6813,    7207,    7600,    7992,    8383,    8773,    9161,
-       9548,    9933,   10317,   10700,   11080,   11459,   11837,   12212,
-      12586,   12958,   13328,   13695,   14061,   14425,   14786,   15145,
-      15502,   15856,   16208,   16558,   16905,   17250,   17592,   17931,
-      18267,   18601,   18932,   19260,   19585,   19907,   20226,   20542,
-      20855,   21165,   21472,   21775,   22075,   22372,   22665,   22955,
-      23241,   23524,   23803,   24079,   24351,   24619,   24883,   25144,
-      25401,   25654,   25903,   26149,   26390,   26627,   26860,   27090,
-      27315,   27536,   27752,   27965,   28173,   28377,   28577,   28772,
-      28963,   29150,   29332,   29510,   29683,   29851,   30016,   30175,
-      30330,   30481,   30627,   30768,   30904,   31036,   31163,   31286,
-      31403,   31516,   31624,   31728,   31826,   31920,   32008,   32092,
-      32171,   32246,   32315,   32379,   32439,   32493,   32543,   32587,
-      32627,   32662,   32692,   32717,   32737,   32751,   32761,   32766,
-      32766,   32761,   32751,   32737,   32717,   32692,   32662,   32627,
-      32587,   32543,   32493,   32439,   32379,   32315,   32246,   32171,
-      32092,   32008,   31920,   31826,   31728,   31624,   31516,   31403,
-      31286,   31163,   31036,   30904,   30768,   30627,   30481,   30330,
-      30175,   30016,   29851,   29683,   29510,   29332,   29150,   28963,
-      28772,   28577,   28377,   28173,   27965,   27752,   27536,   27315,
-      27090,   26860,   26627,   26390,   26149,   25903,   25654,   25401,
-      25144,   24883,   24619,   24351,   24079,   23803,   23524,   23241,
-      22955,   22665,   22372,   22075,   21775,   21472,   21165,   20855,
-      20542,   20226,   19907,   19585,   19260,   18932,   18601,   18267,
-      17931,   17592,   17250,   16905,   16558,   16208,   15856,   15502,
-      15145,   14786,   14425,   14061,   13695,   13328,   12958,   12586,
-      12212,   11837,   11459,   11080,   10700,   10317,    9933,    9548,
-       9161,    8773,    8383,    7992,    7600,    7207,    6813,    6417,
-       6021,    5624,    5226,    4827,    4427,    4027,    3626,    3224,
-       2822,    2420,    2017,    1614,    1211,     807,     404,       0
-};
-
-
-/* ── FFT twiddle factors (Q1.31), N/2 entries ─────── */
-
-const q31_t twiddle_cos_256[128] = {
-    2147483647, 2146836865, 2144896909, 2141664947, 2137142926, 2131333571, 2124240379, 2115867625,
-    2106220351, 2095304369, 2083126253, 2069693341, 2055013722, 2039096240, 2021950483, 2003586778,
-    1984016188, 1963250500, 1941302224, 1918184580, 1893911493, 1868497585, 1841958164, 1814309215,
-    1785567395, 1755750016, 1724875039, 1692961061, 1660027308, 1626093615, 1591180425, 1555308767,
-    1518500249, 1480777044, 1442161874, 1402677999, 1362349204, 1321199780, 1279254515, 1236538675,
-    1193077990, 1148898640, 1104027236, 1058490807, 1012316784, 965532978, 918167571, 870249095,
-    821806413, 772868706, 723465451, 673626408, 623381597, 572761285, 521795963, 470516330,
-    418953276, 367137860, 315101294, 262874923, 210490206, 157978697, 105372028, 52701887,
-          0, -52701887, -105372028, -157978697, -210490206, -262874923, -315101294, -367137860,
-    -418953276, -470516330, -521795963, -572761285, -623381597, -673626408, -723465451, -772868706,
-    -821806413, -870249095, -918167571, -965532978, -1012316784, -1058490807, -1104027236, -1148898640,
-    -1193077990, -1236538675, -1279254515, -1321199780, -1362349204, -1402677999, -1442161874, -1480777044,
-    -1518500249, -1555308767, -1591180425, -1626093615, -1660027308, -1692961061, -1724875039, -1755750016,
-    -1785567395, -1814309215, -1841958164, -1868497585, -1893911493, -1918184580, -1941302224, -1963250500,
-    -1984016188, -2003586778, -2021950483, -2039096240, -2055013722, -2069693341, -2083126253, -2095304369,
-    -2106220351, -2115867625, -2124240379, -2131333571, -2137142926, -2141664947, -2144896909, -2146836865
-};
-
-const q31_t twiddle_sin_256[128] = {
-          0, 52701887, 105372028, 157978697, 210490206, 262874923, 315101294, 367137860,
-    418953276, 470516330, 521795963, 572761285, 623381597, 673626408, 723465451, 772868706,
-    821806413, 870249095, 918167571, 965532978, 1012316784, 1058490807, 1104027236, 1148898640,
-    1193077990, 1236538675, 1279254515, 1321199780, 1362349204, 1402677999, 1442161874, 1480777044,
-    1518500249, 1555308767, 1591180425, 1626093615, 1660027308, 1692961061, 1724875039, 1755750016,
-    1785567395, 1814309215, 1841958164, 1868497585, 1893911493, 1918184580, 1941302224, 1963250500,
-    1984016188, 2003586778, 2021950483, 2039096240, 2055013722, 2069693341, 2083126253, 2095304369,
-    2106220351, 2115867625, 2124240379, 2131333571, 2137142926, 2141664947, 2144896909, 2146836865,
-    2147483647, 2146836865, 2144896909, 2141664947, 2137142926, 2131333571, 2124240379, 2115867625,
-    2106220351, 2095304369, 2083126253, 2069693341, 2055013722, 2039096240, 2021950483, 2003586778,
-    1984016188, 1963250500, 1941302224, 1918184580, 1893911493, 1868497585, 1841958164, 1814309215,
-    1785567395, 1755750016, 1724875039, 1692961061, 1660027308, 1626093615, 1591180425, 1555308767,
-    1518500249, 1480777044, 1442161874, 1402677999, 1362349204, 1321199780, 1279254515, 1236538675,
-    1193077990, 1148898640, 1104027236, 1058490807, 1012316784, 965532978, 918167571, 870249095,
-    821806413, 772868706, 723465451, 673626408, 623381597, 572761285, 521795963, 470516330,
-    418953276, 367137860, 315101294, 262874923, 210490206, 157978697, 105372028, 52701887
-};
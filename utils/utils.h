@@ -1,4 +1,6 @@
-/* fixedpoint.h — Fixed-point math utilities (saturating ops, Q-format shifts) */
+/* utils.h — Shared typedefs, Q-format conversions, logging (saturating ops and fast math: fixedpoint.h) */
+#pragma once
+
 #include <stdint.h>
 #include <math.h>
 